@@ -27,7 +27,8 @@ Example:
         ctl.close()
 """
 
-from ctypes import cdll, c_void_p, c_int, c_char_p, c_uint, byref
+from ctypes import cdll, c_void_p, c_int, c_char_p, c_uint, c_size_t, byref, \
+                   string_at
 from enum import IntEnum
 import sys
 
@@ -38,6 +39,7 @@ CTL_CONNECT = None
 CTL_CLOSE = None
 CTL_SEND = None
 CTL_RECEIVE = None
+CTL_BULK = None
 CTL_ERROR = None
 
 
@@ -89,6 +91,11 @@ def load_lib(path=None):
     CTL_RECEIVE.restype = c_int
     CTL_RECEIVE.argtypes = [c_void_p, c_void_p, c_void_p]
 
+    global CTL_BULK
+    CTL_BULK = LIB.knot_ctl_bulk
+    CTL_BULK.restype = c_void_p
+    CTL_BULK.argtypes = [c_void_p, c_void_p]
+
     global CTL_ERROR
     CTL_ERROR = LIB.knot_strerror
     CTL_ERROR.restype = c_char_p
@@ -118,6 +125,7 @@ class KnotCtlType(IntEnum):
     DATA = 1
     EXTRA = 2
     BLOCK = 3
+    BULK = 4
 
 
 class KnotCtlDataIdx(IntEnum):
@@ -240,6 +248,16 @@ class KnotCtl(object):
             raise KnotCtlError(err if isinstance(err, str) else err.decode())
         return KnotCtlType(data_type.value)
 
+    def bulk(self):
+        """Returns the payload of the last received bulk data unit.
+
+        @rtype: bytes
+        """
+
+        length = c_size_t()
+        ptr = CTL_BULK(self.obj, byref(length))
+        return string_at(ptr, length.value) if ptr else bytes()
+
     def send_block(self, cmd, section=None, item=None, identifier=None, zone=None,
                    owner=None, ttl=None, rtype=None, data=None, flags=None,
                    filter=None):
@@ -0,0 +1,91 @@
+/*  Copyright (C) 2021 CZ.NIC, z.s.p.o. <knot-dns@labs.nic.cz>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \brief Atomic operations with a fallback for platforms without them.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef HAVE_ATOMIC
+ #define ATOMIC_GET(src)       __atomic_load_n(&(src), __ATOMIC_RELAXED)
+ #define ATOMIC_SET(dst, val)  __atomic_store_n(&(dst), (val), __ATOMIC_RELAXED)
+ #define ATOMIC_ADD(dst, val)  __atomic_add_fetch(&(dst), (val), __ATOMIC_RELAXED)
+ #define ATOMIC_SUB(dst, val)  __atomic_sub_fetch(&(dst), (val), __ATOMIC_RELAXED)
+ #define ATOMIC_XCHG(dst, val) __atomic_exchange_n(&(dst), (val), __ATOMIC_ACQ_REL)
+#else
+ #include <pthread.h>
+
+ /* Not atomic, only for statistics and hints where an inaccuracy is tolerable. */
+ #define ATOMIC_GET(src)       (src)
+ #define ATOMIC_SET(dst, val)  ((dst) = (val))
+ #define ATOMIC_ADD(dst, val)  ((dst) += (val))
+ #define ATOMIC_SUB(dst, val)  ((dst) -= (val))
+ #define ATOMIC_XCHG(dst, val) ({ __typeof__(dst) old = (dst); (dst) = (val); old; })
+#endif
+
+/*! \brief Reference counter safe for concurrent use. */
+typedef struct {
+	int value;
+#ifndef HAVE_ATOMIC
+	pthread_mutex_t lock;
+#endif
+} knot_refcnt_t;
+
+static inline void knot_refcnt_init(knot_refcnt_t *ref, int value)
+{
+	ref->value = value;
+#ifndef HAVE_ATOMIC
+	pthread_mutex_init(&ref->lock, NULL);
+#endif
+}
+
+static inline void knot_refcnt_deinit(knot_refcnt_t *ref)
+{
+#ifndef HAVE_ATOMIC
+	pthread_mutex_destroy(&ref->lock);
+#endif
+}
+
+static inline void knot_refcnt_inc(knot_refcnt_t *ref)
+{
+#ifdef HAVE_ATOMIC
+	__atomic_add_fetch(&ref->value, 1, __ATOMIC_RELAXED);
+#else
+	pthread_mutex_lock(&ref->lock);
+	ref->value++;
+	pthread_mutex_unlock(&ref->lock);
+#endif
+}
+
+/*!
+ * \brief Decrements the reference counter.
+ *
+ * \return True if this was the last reference.
+ */
+static inline bool knot_refcnt_dec(knot_refcnt_t *ref)
+{
+#ifdef HAVE_ATOMIC
+	return __atomic_sub_fetch(&ref->value, 1, __ATOMIC_ACQ_REL) == 0;
+#else
+	pthread_mutex_lock(&ref->lock);
+	bool last = (--ref->value == 0);
+	pthread_mutex_unlock(&ref->lock);
+	return last;
+#endif
+}
@@ -51,8 +51,42 @@ uint64_t server_zone_count(server_t *server)
 	return knot_zonedb_size(server->zone_db);
 }
 
+static void zone_ddns_sum(zone_t *zone, uint64_t *queued, uint64_t *processed,
+                          uint64_t *latency)
+{
+	pthread_mutex_lock(&zone->ddns_lock);
+	*queued += zone->ddns_queue_size;
+	*processed += zone->ddns_processed;
+	*latency += zone->ddns_latency;
+	pthread_mutex_unlock(&zone->ddns_lock);
+}
+
+uint64_t server_ddns_queued(server_t *server)
+{
+	uint64_t queued = 0, processed = 0, latency = 0;
+	knot_zonedb_foreach(server->zone_db, zone_ddns_sum, &queued, &processed, &latency);
+	return queued;
+}
+
+uint64_t server_ddns_processed(server_t *server)
+{
+	uint64_t queued = 0, processed = 0, latency = 0;
+	knot_zonedb_foreach(server->zone_db, zone_ddns_sum, &queued, &processed, &latency);
+	return processed;
+}
+
+uint64_t server_ddns_latency(server_t *server)
+{
+	uint64_t queued = 0, processed = 0, latency = 0;
+	knot_zonedb_foreach(server->zone_db, zone_ddns_sum, &queued, &processed, &latency);
+	return (processed > 0) ? latency / processed : 0;
+}
+
 const stats_item_t server_stats[] = {
 	{ "zone-count", server_zone_count },
+	{ "ddns-queued", server_ddns_queued },
+	{ "ddns-processed", server_ddns_processed },
+	{ "ddns-latency", server_ddns_latency },
 	{ 0 }
 };
 
@@ -88,7 +88,13 @@ int conf_refresh_txn(
 	// Close previously opened transaction.
 	conf->api->txn_abort(&conf->read_txn);
 
-	return conf->api->txn_begin(conf->db, &conf->read_txn, KNOT_DB_RDONLY);
+	int ret = conf->api->txn_begin(conf->db, &conf->read_txn, KNOT_DB_RDONLY);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
+	// Materialize zone items of the new configuration state.
+	return conf_zone_cache_build(conf);
 }
 
 void conf_refresh_hostname(
@@ -403,6 +409,7 @@ conf_t *conf_update(
 		if ((flags & CONF_UPD_FCONFIO) && s_conf != NULL) {
 			conf->io.flags = s_conf->io.flags;
 			conf->io.zones = s_conf->io.zones;
+			conf->io.refs = s_conf->io.refs;
 		}
 		if ((flags & CONF_UPD_FMODULES) && s_conf != NULL) {
 			free(conf->query_modules);
@@ -422,6 +429,7 @@ conf_t *conf_update(
 
 		if (flags & CONF_UPD_FCONFIO) {
 			old_conf->io.zones = NULL;
+			old_conf->io.refs = NULL;
 		}
 		if (flags & CONF_UPD_FMODULES) {
 			old_conf->query_modules = NULL;
@@ -456,6 +464,11 @@ void conf_free(
 	if (conf->io.zones != NULL) {
 		trie_free(conf->io.zones);
 	}
+	if (conf->io.refs != NULL) {
+		trie_free(conf->io.refs);
+	}
+
+	conf_zone_cache_free(conf);
 
 	conf_mod_load_purge(conf, false);
 	conf_deactivate_modules(conf->query_modules, &conf->query_plan);
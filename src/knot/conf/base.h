@@ -98,6 +98,8 @@ typedef struct {
 		yp_flag_t flags;
 		/*! Changed zones. */
 		trie_t *zones;
+		/*! Changed referenced sections with reload impact on zones. */
+		trie_t *refs;
 	} io;
 
 	/*! Current config file (for reload if started with config file). */
@@ -125,6 +127,9 @@ typedef struct {
 		bool srv_ans_rotate;
 	} cache;
 
+	/*! Materialized zone items (RCU protected), see conf_zone_cache(). */
+	struct conf_zone_cache_db *zone_cache;
+
 	/*! List of dynamically loaded modules. */
 	mod_dynarray_t modules;
 	/*! List of old schemas (lazy freed). */
@@ -184,6 +189,33 @@ void conf_refresh_hostname(
 	conf_t *conf
 );
 
+/*!
+ * Materializes the frequently used zone items of all configured zones.
+ *
+ * The new items are published atomically, the previous ones are released
+ * after the RCU grace period.
+ *
+ * \note Called on each read-only transaction refresh automatically.
+ *
+ * \param[in] conf  Configuration.
+ *
+ * \return Error code, KNOT_EOK if success.
+ */
+int conf_zone_cache_build(
+	conf_t *conf
+);
+
+/*!
+ * Releases the materialized zone items.
+ *
+ * \note There must be no concurrent readers.
+ *
+ * \param[in] conf  Configuration.
+ */
+void conf_zone_cache_free(
+	conf_t *conf
+);
+
 /*!
  * Creates new or opens old configuration database.
  *
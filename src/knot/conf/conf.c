@@ -20,6 +20,7 @@
 #include <stdio.h>
 #include <sys/resource.h>
 #include <sys/stat.h>
+#include <urcu.h>
 
 #include "knot/conf/base.h"
 #include "knot/conf/confdb.h"
@@ -254,6 +255,218 @@ got_template:
 	return val;
 }
 
+/*! Materialized zone items of one configuration state. */
+struct conf_zone_cache_db {
+	/*! Configured zone name -> conf_zone_cache_t mapping. */
+	trie_t *zones;
+	/*! Catalog zone name -> catalog member conf_zone_cache_t mapping. */
+	trie_t *members;
+	/*! Items of zones without explicit configuration. */
+	conf_zone_cache_t dflt;
+};
+
+static conf_val_t zone_cache_get(
+	conf_t *conf,
+	const yp_name_t *key1_name,
+	const knot_dname_t *dname,
+	conf_val_t *tpl)
+{
+	if (dname != NULL) {
+		return conf_zone_get(conf, key1_name, dname);
+	} else if (tpl != NULL) {
+		return conf_id_get(conf, C_TPL, key1_name, tpl);
+	} else {
+		return conf_default_get(conf, key1_name);
+	}
+}
+
+static void zone_cache_fill(
+	conf_t *conf,
+	const knot_dname_t *dname,
+	conf_val_t *tpl,
+	conf_zone_cache_t *cache)
+{
+	conf_val_t val = zone_cache_get(conf, C_DNSSEC_SIGNING, dname, tpl);
+	cache->dnssec_signing = conf_bool(&val);
+
+	val = zone_cache_get(conf, C_COMPACT_NODES, dname, tpl);
+	cache->compact_nodes = conf_bool(&val);
+
+	val = zone_cache_get(conf, C_SERIAL_POLICY, dname, tpl);
+	cache->serial_policy = conf_opt(&val);
+
+	val = zone_cache_get(conf, C_JOURNAL_CONTENT, dname, tpl);
+	cache->journal_content = conf_opt(&val);
+
+	val = zone_cache_get(conf, C_ZONEFILE_SYNC, dname, tpl);
+	cache->zonefile_sync = conf_int(&val);
+
+	val = zone_cache_get(conf, C_ADJUST_THR, dname, tpl);
+	cache->adjust_threads = conf_int(&val);
+
+	val = zone_cache_get(conf, C_ZONE_MAX_SIZE, dname, tpl);
+	if (val.code != KNOT_EOK) {
+		val = zone_cache_get(conf, C_MAX_ZONE_SIZE, dname, tpl);
+	}
+	cache->zone_max_size = conf_int(&val);
+}
+
+static int zone_cache_insert(
+	trie_t *trie,
+	const knot_dname_t *dname,
+	const conf_zone_cache_t *items)
+{
+	knot_dname_storage_t lf_storage;
+	uint8_t *lf = knot_dname_lf(dname, lf_storage);
+	assert(lf);
+
+	conf_zone_cache_t *item = malloc(sizeof(*item));
+	trie_val_t *val = trie_get_ins(trie, lf + 1, *lf);
+	if (item == NULL || val == NULL) {
+		free(item);
+		return KNOT_ENOMEM;
+	}
+	free(*val);
+	*item = *items;
+	*val = item;
+
+	return KNOT_EOK;
+}
+
+static const conf_zone_cache_t *zone_cache_find(
+	trie_t *trie,
+	const knot_dname_t *dname)
+{
+	knot_dname_storage_t lf_storage;
+	uint8_t *lf = knot_dname_lf(dname, lf_storage);
+	assert(lf);
+
+	trie_val_t *val = trie_get_try(trie, lf + 1, *lf);
+	return (val != NULL) ? *val : NULL;
+}
+
+static int zone_cache_free_item(
+	trie_val_t *val,
+	void *ctx)
+{
+	free(*val);
+	return KNOT_EOK;
+}
+
+static void zone_cache_free(
+	struct conf_zone_cache_db *cache)
+{
+	if (cache == NULL) {
+		return;
+	}
+
+	if (cache->zones != NULL) {
+		trie_apply(cache->zones, zone_cache_free_item, NULL);
+		trie_free(cache->zones);
+	}
+	if (cache->members != NULL) {
+		trie_apply(cache->members, zone_cache_free_item, NULL);
+		trie_free(cache->members);
+	}
+	free(cache);
+}
+
+int conf_zone_cache_build(
+	conf_t *conf)
+{
+	if (conf == NULL) {
+		return KNOT_EINVAL;
+	}
+
+	struct conf_zone_cache_db *cache = calloc(1, sizeof(*cache));
+	if (cache == NULL) {
+		return KNOT_ENOMEM;
+	}
+	cache->zones = trie_create(NULL);
+	cache->members = trie_create(NULL);
+	if (cache->zones == NULL || cache->members == NULL) {
+		zone_cache_free(cache);
+		return KNOT_ENOMEM;
+	}
+
+	zone_cache_fill(conf, NULL, NULL, &cache->dflt);
+
+	int ret = KNOT_EOK;
+	for (conf_iter_t iter = conf_iter(conf, C_ZONE);
+	     iter.code == KNOT_EOK; conf_iter_next(conf, &iter)) {
+		conf_val_t id = conf_iter_id(conf, &iter);
+		const knot_dname_t *dname = conf_dname(&id);
+
+		conf_zone_cache_t items;
+		zone_cache_fill(conf, dname, NULL, &items);
+		ret = zone_cache_insert(cache->zones, dname, &items);
+
+		// Member zones of a catalog zone share its catalog template.
+		conf_val_t tpl = conf_rawid_get(conf, C_ZONE, C_CATALOG_TPL, id.data, id.len);
+		if (ret == KNOT_EOK && tpl.code == KNOT_EOK) {
+			zone_cache_fill(conf, NULL, &tpl, &items);
+			ret = zone_cache_insert(cache->members, dname, &items);
+		}
+		if (ret != KNOT_EOK) {
+			conf_iter_finish(conf, &iter);
+			zone_cache_free(cache);
+			return ret;
+		}
+	}
+
+	struct conf_zone_cache_db *old = rcu_xchg_pointer(&conf->zone_cache, cache);
+	if (old != NULL) {
+		synchronize_rcu();
+		zone_cache_free(old);
+	}
+
+	return KNOT_EOK;
+}
+
+void conf_zone_cache_free(
+	conf_t *conf)
+{
+	if (conf == NULL) {
+		return;
+	}
+
+	zone_cache_free(conf->zone_cache);
+	conf->zone_cache = NULL;
+}
+
+conf_zone_cache_t conf_zone_cache(
+	conf_t *conf,
+	const knot_dname_t *dname)
+{
+	conf_zone_cache_t out = { 0 };
+
+	rcu_read_lock();
+	struct conf_zone_cache_db *cache = rcu_dereference(conf->zone_cache);
+	const conf_zone_cache_t *items = NULL;
+	if (cache != NULL) {
+		knot_dname_storage_t catalog;
+		items = zone_cache_find(cache->zones, dname);
+		if (items == NULL && conf->catalog != NULL &&
+		    catalog_get_zone_threadsafe(conf->catalog, dname, catalog) == KNOT_EOK) {
+			// Catalog member zone, not materialized if no catalog template.
+			items = zone_cache_find(cache->members, catalog);
+		} else if (items == NULL) {
+			items = &cache->dflt;
+		}
+	}
+	if (items != NULL) {
+		out = *items;
+	}
+	rcu_read_unlock();
+
+	// Fall back to the database lookups if not materialized.
+	if (items == NULL) {
+		zone_cache_fill(conf, dname, NULL, &out);
+	}
+
+	return out;
+}
+
 conf_val_t conf_default_get_txn(
 	conf_t *conf,
 	knot_db_txn_t *txn,
@@ -202,6 +202,33 @@ static inline conf_val_t conf_zone_get(
 	return conf_zone_get_txn(conf, &conf->read_txn, key1_name, dname);
 }
 
+/*! Frequently used zone configuration items. */
+typedef struct {
+	bool dnssec_signing;
+	bool compact_nodes;
+	unsigned serial_policy;
+	unsigned journal_content;
+	int64_t zonefile_sync;
+	int64_t adjust_threads;
+	int64_t zone_max_size;
+} conf_zone_cache_t;
+
+/*!
+ * Gets the frequently used configuration items of the zone section.
+ *
+ * The items are materialized upon each read-only transaction refresh, so
+ * the lookup doesn't access the configuration database.
+ *
+ * \param[in] conf   Configuration.
+ * \param[in] dname  Zone name.
+ *
+ * \return Zone configuration items.
+ */
+conf_zone_cache_t conf_zone_cache(
+	conf_t *conf,
+	const knot_dname_t *dname
+);
+
 /*!
  * Gets the configuration item value of the default template.
  *
@@ -92,6 +92,9 @@ int conf_io_begin(
 		if (conf()->io.zones != NULL) {
 			trie_clear(conf()->io.zones);
 		}
+		if (conf()->io.refs != NULL) {
+			trie_clear(conf()->io.refs);
+		}
 	}
 
 	return KNOT_EOK;
@@ -139,6 +142,9 @@ void conf_io_abort(
 		if (conf()->io.zones != NULL) {
 			trie_clear(conf()->io.zones);
 		}
+		if (conf()->io.refs != NULL) {
+			trie_clear(conf()->io.refs);
+		}
 	}
 }
 
@@ -785,12 +791,65 @@ get_error:
 	return ret;
 }
 
+static bool is_zone_ref(
+	const yp_name_t *section)
+{
+	const yp_name_t *refs[] = { C_TPL, C_POLICY, C_KEYSTORE, C_SBM };
+
+	for (size_t i = 0; i < sizeof(refs) / sizeof(*refs); i++) {
+		if (strcmp(&section[1], &refs[i][1]) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static size_t ref_key(
+	uint8_t *key,
+	const yp_name_t *section,
+	const uint8_t *id,
+	size_t id_len)
+{
+	size_t name_len = 1 + section[0];
+	memcpy(key, section, name_len);
+	memcpy(key + name_len, id, id_len);
+
+	return name_len + id_len;
+}
+
+static bool upd_ref(
+	const conf_io_t *io)
+{
+	trie_t *refs = conf()->io.refs;
+	if (refs == NULL) {
+		refs = trie_create(NULL);
+		if (refs == NULL) {
+			return false;
+		}
+		conf()->io.refs = refs;
+	}
+
+	uint8_t key[1 + YP_MAX_ITEM_NAME_LEN + YP_MAX_ID_LEN];
+	size_t key_len = ref_key(key, io->key0->name, io->id, io->id_len);
+
+	return trie_get_ins(refs, key, key_len) != NULL;
+}
+
 static void upd_changes(
 	const conf_io_t *io,
 	conf_io_type_t type,
 	yp_flag_t flags,
 	bool any_id)
 {
+	// Reload only the affected zones if a referenced section item has changed.
+	if ((flags & CONF_IO_FRLD_ZONES) && !(flags & CONF_IO_FZONE) &&
+	    type == CONF_IO_TCHANGE && !any_id && io->id_len > 0 &&
+	    is_zone_ref(io->key0->name) && upd_ref(io)) {
+		flags &= ~CONF_IO_FRLD_ZONES;
+		flags |= CONF_IO_FRLD_ZONE;
+	}
+
 	// Update common flags.
 	conf()->io.flags |= flags;
 
@@ -1517,3 +1576,64 @@ check_error:
 
 	return ret;
 }
+
+static bool ref_changed(
+	conf_t *conf,
+	const yp_name_t *section,
+	conf_val_t *val,
+	bool dflt)
+{
+	const uint8_t *id = NULL;
+	size_t id_len = 0;
+
+	if (val->code == KNOT_EOK) {
+		conf_val(val);
+		id = val->data;
+		id_len = val->len;
+	} else if (!dflt) {
+		return false;
+	}
+
+	// Empty identifier means the default one.
+	if (id_len == 0) {
+		id = CONF_DEFAULT_ID + 1;
+		id_len = CONF_DEFAULT_ID[0];
+	}
+
+	uint8_t key[1 + YP_MAX_ITEM_NAME_LEN + YP_MAX_ID_LEN];
+	size_t key_len = ref_key(key, section, id, id_len);
+
+	return trie_get_try(conf->io.refs, key, key_len) != NULL;
+}
+
+bool conf_io_zone_refs_changed(
+	conf_t *conf,
+	const knot_dname_t *zone)
+{
+	if (conf == NULL || zone == NULL || conf->io.refs == NULL ||
+	    trie_weight(conf->io.refs) == 0) {
+		return false;
+	}
+
+	// Check the zone template.
+	conf_val_t val = conf_rawid_get(conf, C_ZONE, C_TPL, zone,
+	                                knot_dname_size(zone));
+	if (ref_changed(conf, C_TPL, &val, true)) {
+		return true;
+	}
+
+	// Check the DNSSEC policy and the sections referenced from it.
+	conf_val_t policy = conf_zone_get(conf, C_DNSSEC_POLICY, zone);
+	conf_id_fix_default(&policy);
+	if (ref_changed(conf, C_POLICY, &policy, true)) {
+		return true;
+	}
+
+	val = conf_id_get(conf, C_POLICY, C_KEYSTORE, &policy);
+	if (ref_changed(conf, C_KEYSTORE, &val, true)) {
+		return true;
+	}
+
+	val = conf_id_get(conf, C_POLICY, C_KSK_SBM, &policy);
+	return ref_changed(conf, C_SBM, &val, false);
+}
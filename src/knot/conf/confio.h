@@ -216,3 +216,17 @@ int conf_io_unset(
 int conf_io_check(
 	conf_io_t *io
 );
+
+/*!
+ * Checks if the zone configuration depends on a changed referenced section
+ * (template, policy, keystore, or submission) from the last transaction.
+ *
+ * \param[in] conf  Configuration.
+ * \param[in] zone  Zone name.
+ *
+ * \return True if the zone has to be reloaded.
+ */
+bool conf_io_zone_refs_changed(
+	conf_t *conf,
+	const knot_dname_t *zone
+);
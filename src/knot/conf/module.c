@@ -351,6 +351,7 @@ void conf_activate_modules(
 	struct query_plan **query_plan)
 {
 	int ret = KNOT_EOK;
+	struct query_plan *plan = NULL;
 
 	if (conf == NULL || query_modules == NULL || query_plan == NULL) {
 		ret = KNOT_EINVAL;
@@ -378,8 +379,8 @@ void conf_activate_modules(
 	}
 
 	// Create query plan.
-	*query_plan = query_plan_create();
-	if (*query_plan == NULL) {
+	plan = query_plan_create();
+	if (plan == NULL) {
 		ret = KNOT_ENOMEM;
 		goto activate_error;
 	}
@@ -396,7 +397,7 @@ void conf_activate_modules(
 		}
 
 		// Open the module.
-		knotd_mod_t *mod = query_module_open(conf, server, mod_id, *query_plan,
+		knotd_mod_t *mod = query_module_open(conf, server, mod_id, plan,
 		                                     zone_name);
 		if (mod == NULL) {
 			MOD_ID_LOG(zone_name, error, mod_id, "failed to open");
@@ -434,8 +435,15 @@ skip_module:
 		conf_val_next(&val);
 	}
 
+	// Publish the plan with compiled hooks.
+	(void)query_plan_compile(plan);
+	rcu_assign_pointer(*query_plan, plan);
 	return;
 activate_error:
+	if (plan != NULL) {
+		(void)query_plan_compile(plan);
+		rcu_assign_pointer(*query_plan, plan);
+	}
 	CONF_LOG(LOG_ERR, "failed to activate modules (%s)", knot_strerror(ret));
 }
 
@@ -502,5 +510,6 @@ void conf_reset_modules(
 		mod->config = NULL; // Invalidate the current config.
 	}
 
+	(void)query_plan_compile(new_plan);
 	(void)rcu_xchg_pointer(query_plan, new_plan);
 }
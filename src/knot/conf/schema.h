@@ -38,6 +38,7 @@
 #define C_CDS_CDNSKEY		"\x13""cds-cdnskey-publish"
 #define C_CHK_INTERVAL		"\x0E""check-interval"
 #define C_COMMENT		"\x07""comment"
+#define C_COMPACT_NODES		"\x0D""compact-nodes"
 #define C_CONFIG		"\x06""config"
 #define C_CTL			"\x07""control"
 #define C_DB			"\x08""database"
@@ -70,6 +71,8 @@
 #define C_KSK_SBM		"\x0E""ksk-submission"
 #define C_KSK_SHARED		"\x0a""ksk-shared"
 #define C_KSK_SIZE		"\x08""ksk-size"
+#define C_LAZY_LOAD		"\x09""lazy-load"
+#define C_LAZY_LOAD_LIMIT	"\x0F""lazy-load-limit"
 #define C_LISTEN		"\x06""listen"
 #define C_LISTEN_XDP		"\x0A""listen-xdp"
 #define C_LOG			"\x03""log"
@@ -118,6 +121,7 @@
 #define C_TIMER			"\x05""timer"
 #define C_TIMER_DB		"\x08""timer-db"
 #define C_TIMER_DB_MAX_SIZE	"\x11""timer-db-max-size"
+#define C_TIMER_DB_SYNC		"\x0D""timer-db-sync"
 #define C_TPL			"\x08""template"
 #define C_UDP_MAX_PAYLOAD	"\x0F""udp-max-payload"
 #define C_UDP_MAX_PAYLOAD_IPV4	"\x14""udp-max-payload-ipv4"
@@ -130,6 +134,7 @@
 #define C_USER			"\x04""user"
 #define C_VERSION		"\x07""version"
 #define C_VIA			"\x03""via"
+#define C_WORKERS		"\x07""workers"
 #define C_ZONE			"\x04""zone"
 #define C_ZONEFILE_LOAD		"\x0D""zonefile-load"
 #define C_ZONEFILE_SYNC		"\x0D""zonefile-sync"
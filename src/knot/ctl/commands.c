@@ -14,6 +14,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <pthread.h>
 #include <string.h>
 #include <unistd.h>
 #include <sys/time.h>
@@ -38,6 +39,7 @@
 #include "contrib/macros.h"
 #include "contrib/string.h"
 #include "contrib/strtonum.h"
+#include "contrib/time.h"
 #include "contrib/ucw/lists.h"
 #include "libzscanner/scanner.h"
 
@@ -57,8 +59,20 @@ typedef struct {
 	char ttl[16];
 	char type[32];
 	char rdata[2 * 65536];
+	bool bulk; // Send wire-format records in bulk units.
+	size_t limit; // Maximum number of records to send, 0 for unlimited.
+	size_t count;
+	const knot_dname_t *last; // Owner of the last processed node.
+	knot_dname_storage_t last_owner;
+	const knot_dname_t *sub_root; // Subtree to read, NULL for the whole zone.
+	knot_dname_storage_t sub_root_buf;
+	bool resume; // Continue after the last processed node.
+	bool nsec3; // Reading the NSEC3 tree.
+	size_t bulk_len;
+	uint8_t bulk_buf[KNOT_CTL_BULK_MAX];
 } send_ctx_t;
 
+/*! Buffers used by the serialized (modifying) commands only. */
 static struct {
 	send_ctx_t send_ctx;
 	zs_scanner_t scanner;
@@ -68,6 +82,136 @@ static struct {
 	            sizeof(((send_ctx_t *)0)->rdata)];
 } ctl_globals;
 
+/*! Processing statistics of the individual commands. */
+static struct {
+	pthread_mutex_t lock;
+	uint64_t count[CTL__COUNT];
+	uint64_t time_us[CTL__COUNT];
+} ctl_counters = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+/*! Amount of output collected under one RCU read lock section. */
+#define CTL_OUT_CHUNK	(64 * 1024)
+
+typedef struct ctl_out_item {
+	struct ctl_out_item *next;
+	knot_ctl_type_t type;
+	knot_ctl_data_t data;
+	size_t bulk_len;
+	uint8_t buf[];
+} ctl_out_item_t;
+
+struct ctl_out {
+	ctl_out_item_t *head;
+	ctl_out_item_t *tail;
+	size_t size;
+};
+
+static void ctl_out_append(ctl_out_t *out, ctl_out_item_t *item, size_t size)
+{
+	item->next = NULL;
+	if (out->tail != NULL) {
+		out->tail->next = item;
+	} else {
+		out->head = item;
+	}
+	out->tail = item;
+	out->size += size;
+}
+
+static void ctl_out_clear(ctl_out_t *out)
+{
+	ctl_out_item_t *item = out->head;
+	while (item != NULL) {
+		ctl_out_item_t *next = item->next;
+		free(item);
+		item = next;
+	}
+	memset(out, 0, sizeof(*out));
+}
+
+/*!
+ * Sends a data unit, or stores its copy if the output is being collected
+ * under RCU read lock.
+ */
+static int ctl_send(ctl_args_t *args, knot_ctl_type_t type, knot_ctl_data_t *data)
+{
+	if (args->out == NULL) {
+		return knot_ctl_send(args->ctl, type, data);
+	}
+
+	size_t size = 0;
+	for (size_t i = 0; data != NULL && i < KNOT_CTL_IDX__COUNT; i++) {
+		if ((*data)[i] != NULL) {
+			size += strlen((*data)[i]) + 1;
+		}
+	}
+
+	ctl_out_item_t *item = calloc(1, sizeof(*item) + size);
+	if (item == NULL) {
+		return KNOT_ENOMEM;
+	}
+	item->type = type;
+
+	char *pos = (char *)item->buf;
+	for (size_t i = 0; data != NULL && i < KNOT_CTL_IDX__COUNT; i++) {
+		if ((*data)[i] != NULL) {
+			size_t len = strlen((*data)[i]) + 1;
+			memcpy(pos, (*data)[i], len);
+			item->data[i] = pos;
+			pos += len;
+		}
+	}
+
+	ctl_out_append(args->out, item, size);
+
+	return KNOT_EOK;
+}
+
+static int ctl_send_bulk(ctl_args_t *args, const uint8_t *bulk, size_t len)
+{
+	if (args->out == NULL) {
+		return knot_ctl_send_bulk(args->ctl, bulk, len);
+	}
+
+	ctl_out_item_t *item = malloc(sizeof(*item) + len);
+	if (item == NULL) {
+		return KNOT_ENOMEM;
+	}
+	item->type = KNOT_CTL_TYPE_BULK;
+	item->bulk_len = len;
+	memcpy(item->buf, bulk, len);
+
+	ctl_out_append(args->out, item, len);
+
+	return KNOT_EOK;
+}
+
+static bool ctl_out_full(ctl_args_t *args)
+{
+	return args->out != NULL && args->out->size >= CTL_OUT_CHUNK;
+}
+
+/*! Sends the collected output. Must be called without RCU read lock. */
+static int ctl_flush(ctl_args_t *args)
+{
+	if (args->out == NULL) {
+		return KNOT_EOK;
+	}
+
+	int ret = KNOT_EOK;
+	for (ctl_out_item_t *item = args->out->head;
+	     item != NULL && ret == KNOT_EOK; item = item->next) {
+		if (item->type == KNOT_CTL_TYPE_BULK) {
+			ret = knot_ctl_send_bulk(args->ctl, item->buf, item->bulk_len);
+		} else {
+			ret = knot_ctl_send(args->ctl, item->type, &item->data);
+		}
+	}
+	ctl_out_clear(args->out);
+
+	return ret;
+}
+
 static void schedule_trigger(zone_t *zone, ctl_args_t *args, zone_event_type_t event,
                              bool user)
 {
@@ -120,25 +264,34 @@ static void send_error(ctl_args_t *args, const char *msg)
 
 	data[KNOT_CTL_IDX_ERROR] = msg;
 
-	int ret = knot_ctl_send(args->ctl, KNOT_CTL_TYPE_DATA, &data);
+	int ret = ctl_send(args, KNOT_CTL_TYPE_DATA, &data);
 	if (ret != KNOT_EOK) {
 		log_ctl_debug("control, failed to send error (%s)", knot_strerror(ret));
 	}
 }
 
-static int get_zone(ctl_args_t *args, zone_t **zone)
+static int get_zone_name(ctl_args_t *args, knot_dname_t *name, size_t name_len)
 {
-	const char *name = args->data[KNOT_CTL_IDX_ZONE];
-	assert(name != NULL);
+	const char *name_str = args->data[KNOT_CTL_IDX_ZONE];
+	assert(name_str != NULL);
 
-	knot_dname_storage_t buff;
-	knot_dname_t *dname = knot_dname_from_str(buff, name, sizeof(buff));
-	if (dname == NULL) {
+	if (knot_dname_from_str(name, name_str, name_len) == NULL) {
 		return KNOT_EINVAL;
 	}
-	knot_dname_to_lower(dname);
+	knot_dname_to_lower(name);
+
+	return KNOT_EOK;
+}
+
+static int get_zone(ctl_args_t *args, zone_t **zone)
+{
+	knot_dname_storage_t buff;
+	int ret = get_zone_name(args, buff, sizeof(buff));
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
 
-	*zone = knot_zonedb_find(args->server->zone_db, dname);
+	*zone = knot_zonedb_find(args->server->zone_db, buff);
 	if (*zone == NULL) {
 		return KNOT_ENOZONE;
 	}
@@ -146,6 +299,88 @@ static int get_zone(ctl_args_t *args, zone_t **zone)
 	return KNOT_EOK;
 }
 
+/*!
+ * Processes the zone under RCU read lock. The collected output is sent after
+ * the lock is released. If the callback returns KNOT_EAGAIN, it's called
+ * again with the next processing step.
+ */
+static int zone_apply_rcu(ctl_args_t *args, const knot_dname_t *name,
+                          int (*fcn)(zone_t *, ctl_args_t *))
+{
+	int ret;
+	args->step = 0;
+	do {
+		rcu_read_lock();
+		zone_t *zone = knot_zonedb_find(rcu_dereference(args->server->zone_db), name);
+		ret = (zone != NULL) ? fcn(zone, args) : KNOT_ENOZONE;
+		rcu_read_unlock();
+
+		int send_ret = ctl_flush(args);
+		if (send_ret != KNOT_EOK) {
+			return send_ret;
+		}
+		args->step++;
+	} while (ret == KNOT_EAGAIN);
+
+	return ret;
+}
+
+/*!
+ * Finds the first zone (after the given one if specified) in the current
+ * zone database.
+ */
+static int next_zone_name(ctl_args_t *args, const knot_dname_t *after,
+                          knot_dname_t *name, bool *found)
+{
+	rcu_read_lock();
+	knot_zonedb_t *db = rcu_dereference(args->server->zone_db);
+	knot_zonedb_iter_t *it = (after != NULL) ? knot_zonedb_iter_begin_after(db, after) :
+	                                           knot_zonedb_iter_begin(db);
+	if (it == NULL) {
+		rcu_read_unlock();
+		return KNOT_ENOMEM;
+	}
+
+	*found = !knot_zonedb_iter_finished(it);
+	if (*found) {
+		zone_t *zone = knot_zonedb_iter_val(it);
+		knot_dname_store(name, zone->name);
+	}
+	knot_zonedb_iter_free(it);
+	rcu_read_unlock();
+
+	return KNOT_EOK;
+}
+
+/*!
+ * Processes up to limit (0 for unlimited) zones after the given one. Each zone
+ * is processed under a separate RCU read lock, so the zone database can be
+ * replaced in the meantime.
+ */
+static int zones_apply_rcu(ctl_args_t *args, int (*fcn)(zone_t *, ctl_args_t *),
+                           const knot_dname_t *after, size_t limit,
+                           knot_dname_t *last, bool *more)
+{
+	knot_dname_storage_t name;
+	*more = false;
+
+	for (size_t count = 0; ; count++) {
+		bool found;
+		int ret = next_zone_name(args, after, name, &found);
+		if (ret != KNOT_EOK || !found) {
+			return ret;
+		}
+		if (limit > 0 && count == limit) {
+			*more = true;
+			return KNOT_EOK;
+		}
+
+		(void)zone_apply_rcu(args, name, fcn);
+		knot_dname_store(last, name);
+		after = last;
+	}
+}
+
 static int zones_apply(ctl_args_t *args, int (*fcn)(zone_t *, ctl_args_t *))
 {
 	int ret = KNOT_EOK;
@@ -153,7 +388,15 @@ static int zones_apply(ctl_args_t *args, int (*fcn)(zone_t *, ctl_args_t *))
 	// Process all configured zones if none is specified.
 	if (args->data[KNOT_CTL_IDX_ZONE] == NULL) {
 		args->failed = false;
-		knot_zonedb_foreach(args->server->zone_db, fcn, args);
+		if (args->out != NULL) {
+			knot_dname_storage_t last;
+			bool more;
+			if (zones_apply_rcu(args, fcn, NULL, 0, last, &more) != KNOT_EOK) {
+				args->failed = true;
+			}
+		} else {
+			knot_zonedb_foreach(args->server->zone_db, fcn, args);
+		}
 		if (args->failed) {
 			ret = KNOT_CTL_EZONE;
 			log_ctl_error("control, error (%s)", knot_strerror(ret));
@@ -164,10 +407,18 @@ static int zones_apply(ctl_args_t *args, int (*fcn)(zone_t *, ctl_args_t *))
 	}
 
 	while (true) {
-		zone_t *zone;
-		ret = get_zone(args, &zone);
-		if (ret == KNOT_EOK) {
-			ret = fcn(zone, args);
+		if (args->out != NULL) {
+			knot_dname_storage_t name;
+			ret = get_zone_name(args, name, sizeof(name));
+			if (ret == KNOT_EOK) {
+				ret = zone_apply_rcu(args, name, fcn);
+			}
+		} else {
+			zone_t *zone;
+			ret = get_zone(args, &zone);
+			if (ret == KNOT_EOK) {
+				ret = fcn(zone, args);
+			}
 		}
 		if (ret != KNOT_EOK) {
 			log_ctl_zone_str_error(args->data[KNOT_CTL_IDX_ZONE],
@@ -186,6 +437,78 @@ static int zones_apply(ctl_args_t *args, int (*fcn)(zone_t *, ctl_args_t *))
 	return ret;
 }
 
+static int get_page(ctl_args_t *args, uint8_t *cursor, size_t cursor_len,
+                    bool *has_cursor, size_t *limit)
+{
+	const char *cursor_str = args->data[KNOT_CTL_IDX_ID];
+	const char *limit_str = args->data[KNOT_CTL_IDX_DATA];
+
+	*has_cursor = false;
+	if (cursor_str != NULL) {
+		if (knot_dname_from_str(cursor, cursor_str, cursor_len) == NULL) {
+			return KNOT_EINVAL;
+		}
+		knot_dname_to_lower(cursor);
+		*has_cursor = true;
+	}
+
+	*limit = 0;
+	if (limit_str != NULL &&
+	    str_to_size(limit_str, limit, 1, SIZE_MAX) != KNOT_EOK) {
+		return KNOT_EINVAL;
+	}
+
+	return KNOT_EOK;
+}
+
+static int zones_apply_paged(ctl_args_t *args, int (*fcn)(zone_t *, ctl_args_t *))
+{
+	// Pagination only applies if all zones are processed.
+	if (args->data[KNOT_CTL_IDX_ZONE] != NULL ||
+	    (args->data[KNOT_CTL_IDX_ID] == NULL && args->data[KNOT_CTL_IDX_DATA] == NULL)) {
+		return zones_apply(args, fcn);
+	}
+
+	knot_dname_storage_t cursor;
+	bool has_cursor;
+	size_t limit;
+	int ret = get_page(args, cursor, sizeof(cursor), &has_cursor, &limit);
+	if (ret != KNOT_EOK) {
+		send_error(args, knot_strerror(ret));
+		return ret;
+	}
+
+	args->failed = false;
+	knot_dname_storage_t last;
+	bool more;
+	ret = zones_apply_rcu(args, fcn, has_cursor ? cursor : NULL, limit, last, &more);
+	if (ret != KNOT_EOK) {
+		send_error(args, knot_strerror(ret));
+		return ret;
+	}
+
+	if (args->failed) {
+		ret = KNOT_CTL_EZONE;
+		log_ctl_error("control, error (%s)", knot_strerror(ret));
+		send_error(args, knot_strerror(ret));
+		args->failed = false;
+	}
+
+	// Let the client continue after the last processed zone.
+	if (more) {
+		knot_dname_txt_storage_t name;
+		if (knot_dname_to_str(name, last, sizeof(name)) == NULL) {
+			return KNOT_EINVAL;
+		}
+		knot_ctl_data_t data = {
+			[KNOT_CTL_IDX_ID] = name
+		};
+		return ctl_send(args, KNOT_CTL_TYPE_DATA, &data);
+	}
+
+	return KNOT_EOK;
+}
+
 static int zone_status(zone_t *zone, ctl_args_t *args)
 {
 	knot_dname_txt_storage_t name;
@@ -210,7 +533,7 @@ static int zone_status(zone_t *zone, ctl_args_t *args)
 			data[KNOT_CTL_IDX_DATA] = "master";
 		}
 
-		ret = knot_ctl_send(args->ctl, type, &data);
+		ret = ctl_send(args, type, &data);
 		if (ret != KNOT_EOK) {
 			return ret;
 		} else {
@@ -234,7 +557,7 @@ static int zone_status(zone_t *zone, ctl_args_t *args)
 
 		data[KNOT_CTL_IDX_DATA] = buff;
 
-		ret = knot_ctl_send(args->ctl, type, &data);
+		ret = ctl_send(args, type, &data);
 		if (ret != KNOT_EOK) {
 			return ret;
 		} else {
@@ -245,7 +568,7 @@ static int zone_status(zone_t *zone, ctl_args_t *args)
 	if (MATCH_OR_FILTER(args, CTL_FILTER_STATUS_TRANSACTION)) {
 		data[KNOT_CTL_IDX_TYPE] = "transaction";
 		data[KNOT_CTL_IDX_DATA] = (zone->control_update != NULL) ? "open" : "none";
-		ret = knot_ctl_send(args->ctl, type, &data);
+		ret = ctl_send(args, type, &data);
 		if (ret != KNOT_EOK) {
 			return ret;
 		} else {
@@ -270,7 +593,7 @@ static int zone_status(zone_t *zone, ctl_args_t *args)
 
 			}
 		}
-		ret = knot_ctl_send(args->ctl, type, &data);
+		ret = ctl_send(args, type, &data);
 		if (ret != KNOT_EOK) {
 			return ret;
 		}
@@ -305,7 +628,7 @@ static int zone_status(zone_t *zone, ctl_args_t *args)
 			}
 			data[KNOT_CTL_IDX_DATA] = buff;
 
-			ret = knot_ctl_send(args->ctl, type, &data);
+			ret = ctl_send(args, type, &data);
 			if (ret != KNOT_EOK) {
 				return ret;
 			}
@@ -655,8 +978,54 @@ static int init_send_ctx(send_ctx_t *ctx, const knot_dname_t *zone_name,
 	return KNOT_EOK;
 }
 
+static int send_bulk(send_ctx_t *ctx)
+{
+	if (ctx->bulk_len == 0) {
+		return KNOT_EOK;
+	}
+
+	int ret = ctl_send_bulk(ctx->args, ctx->bulk_buf, ctx->bulk_len);
+	ctx->bulk_len = 0;
+
+	return ret;
+}
+
+static int send_rrset_bulk(knot_rrset_t *rrset, send_ctx_t *ctx)
+{
+	// Records are written separately so that an RRSet can span more units.
+	for (uint16_t i = 0; i < rrset->rrs.count; ++i) {
+		knot_rdata_t *rr = knot_rdataset_at(&rrset->rrs, i);
+		knot_rrset_t single = *rrset;
+		single.rrs.count = 1;
+		single.rrs.size = knot_rdata_size(rr->len);
+		single.rrs.rdata = rr;
+
+		int ret = knot_rrset_to_wire(&single, ctx->bulk_buf + ctx->bulk_len,
+		                             sizeof(ctx->bulk_buf) - ctx->bulk_len, NULL);
+		if (ret == KNOT_ESPACE && ctx->bulk_len > 0) {
+			ret = send_bulk(ctx);
+			if (ret == KNOT_EOK) {
+				ret = knot_rrset_to_wire(&single, ctx->bulk_buf,
+				                         sizeof(ctx->bulk_buf), NULL);
+			}
+		}
+		if (ret < 0) {
+			return ret;
+		}
+		ctx->bulk_len += ret;
+	}
+
+	return KNOT_EOK;
+}
+
 static int send_rrset(knot_rrset_t *rrset, send_ctx_t *ctx)
 {
+	ctx->count += rrset->rrs.count;
+
+	if (ctx->bulk) {
+		return send_rrset_bulk(rrset, ctx);
+	}
+
 	if (rrset->type != KNOT_RRTYPE_RRSIG) {
 		int ret = snprintf(ctx->ttl, sizeof(ctx->ttl), "%u", rrset->ttl);
 		if (ret <= 0 || ret >= sizeof(ctx->ttl)) {
@@ -683,7 +1052,7 @@ static int send_rrset(knot_rrset_t *rrset, send_ctx_t *ctx)
 			return ret;
 		}
 
-		ret = knot_ctl_send(ctx->args->ctl, KNOT_CTL_TYPE_DATA, &ctx->data);
+		ret = ctl_send(ctx->args, KNOT_CTL_TYPE_DATA, &ctx->data);
 		if (ret != KNOT_EOK) {
 			return ret;
 		}
@@ -695,7 +1064,8 @@ static int send_rrset(knot_rrset_t *rrset, send_ctx_t *ctx)
 static int send_node(zone_node_t *node, void *ctx_void)
 {
 	send_ctx_t *ctx = ctx_void;
-	if (knot_dname_to_str(ctx->owner, node->owner, sizeof(ctx->owner)) == NULL) {
+	if (!ctx->bulk &&
+	    knot_dname_to_str(ctx->owner, node->owner, sizeof(ctx->owner)) == NULL) {
 		return KNOT_EINVAL;
 	}
 
@@ -758,34 +1128,165 @@ static int get_owner(uint8_t *out, size_t out_len, knot_dname_t *origin,
 	return KNOT_EOK;
 }
 
-static int zone_read(zone_t *zone, ctl_args_t *args)
+/*!
+ * Sends the nodes of the tree after the last processed one, or from the start
+ * of the subtree. Stops if the page or the output chunk is full.
+ */
+static int read_tree(zone_tree_t *tree, send_ctx_t *ctx)
+{
+	if (zone_tree_is_empty(tree)) {
+		return KNOT_EOK;
+	}
+
+	zone_tree_it_t it = { 0 };
+	int ret;
+	if (ctx->resume) {
+		ret = zone_tree_it_from_begin(tree, ctx->last, true, &it);
+	} else if (ctx->sub_root != NULL) {
+		ret = zone_tree_it_from_begin(tree, ctx->sub_root, false, &it);
+	} else {
+		ret = zone_tree_it_begin(tree, &it);
+	}
+
+	while (ret == KNOT_EOK && !zone_tree_it_finished(&it)) {
+		zone_node_t *node = zone_tree_it_val(&it);
+		if (ctx->sub_root != NULL &&
+		    knot_dname_in_bailiwick(node->owner, ctx->sub_root) < 0) {
+			break;
+		}
+
+		// Stop before the next node if the page is full.
+		if (ctx->limit > 0 && ctx->count >= ctx->limit) {
+			ret = KNOT_ELIMIT;
+			break;
+		}
+
+		// Continue once the collected output is sent.
+		if (ctl_out_full(ctx->args)) {
+			ret = KNOT_EAGAIN;
+			break;
+		}
+
+		ret = send_node(node, ctx);
+		knot_dname_store(ctx->last_owner, node->owner);
+		ctx->last = ctx->last_owner;
+		ctx->resume = true;
+		zone_tree_it_next(&it);
+	}
+	zone_tree_it_free(&it);
+
+	return ret;
+}
+
+static int send_cursor(send_ctx_t *ctx)
+{
+	if (knot_dname_to_str(ctx->owner, ctx->last, sizeof(ctx->owner)) == NULL) {
+		return KNOT_EINVAL;
+	}
+
+	knot_ctl_data_t data = {
+		[KNOT_CTL_IDX_ZONE] = ctx->zone,
+		[KNOT_CTL_IDX_ID] = ctx->owner
+	};
+
+	return ctl_send(ctx->args, KNOT_CTL_TYPE_DATA, &data);
+}
+
+static int zone_read_init(zone_t *zone, ctl_args_t *args, send_ctx_t *ctx)
 {
-	send_ctx_t *ctx = &ctl_globals.send_ctx;
 	int ret = init_send_ctx(ctx, zone->name, args);
 	if (ret != KNOT_EOK) {
 		return ret;
 	}
+	ctx->bulk = MATCH_AND_FILTER(args, CTL_FILTER_READ_BULK);
+
+	ret = get_page(args, ctx->last_owner, sizeof(ctx->last_owner),
+	               &ctx->resume, &ctx->limit);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+	if (ctx->resume) {
+		ctx->last = ctx->last_owner;
+	}
 
 	if (args->data[KNOT_CTL_IDX_OWNER] != NULL) {
-		knot_dname_storage_t owner;
+		ret = get_owner(ctx->sub_root_buf, sizeof(ctx->sub_root_buf),
+		                zone->name, args);
+		if (ret != KNOT_EOK) {
+			return ret;
+		}
+		ctx->sub_root = ctx->sub_root_buf;
 
-		ret = get_owner(owner, sizeof(owner), zone->name, args);
+		if (ctx->resume && knot_dname_in_bailiwick(ctx->last, ctx->sub_root) < 0) {
+			return KNOT_EINVAL;
+		}
+	}
+
+	// NSEC3 nodes follow the normal ones.
+	ctx->nsec3 = (ctx->resume && zone->contents != NULL &&
+	              zone_tree_get(zone->contents->nsec3_nodes, ctx->last) != NULL);
+
+	return KNOT_EOK;
+}
+
+/*!
+ * Sends the zone contents in chunks. KNOT_EAGAIN is returned if the chunk
+ * is full, the reading continues after the last node in the next step,
+ * possibly in newer zone contents.
+ */
+static int zone_read(zone_t *zone, ctl_args_t *args)
+{
+	send_ctx_t *ctx = args->custom_ctx;
+
+	int ret;
+	if (args->step == 0) {
+		ret = zone_read_init(zone, args, ctx);
 		if (ret != KNOT_EOK) {
 			return ret;
 		}
 
-		const zone_node_t *node = zone_contents_node_or_nsec3(zone->contents, owner);
-		if (node == NULL) {
-			return KNOT_ENONODE;
+		if (ctx->sub_root != NULL && !MATCH_AND_FILTER(args, CTL_FILTER_READ_SUBTREE)) {
+			const zone_node_t *node = zone_contents_node_or_nsec3(zone->contents,
+			                                                      ctx->sub_root);
+			if (node == NULL) {
+				return KNOT_ENONODE;
+			}
+
+			ret = send_node((zone_node_t *)node, ctx);
+			if (ret == KNOT_EOK) {
+				ret = send_bulk(ctx);
+			}
+			return ret;
 		}
+	}
 
-		ret = send_node((zone_node_t *)node, ctx);
-	} else if (zone->contents != NULL) {
-		ret = zone_contents_apply(zone->contents, send_node, ctx);
+	ret = KNOT_EOK;
+	zone_contents_t *contents = zone->contents;
+	if (contents != NULL) {
+		if (!ctx->nsec3) {
+			ret = read_tree(contents->nodes, ctx);
+			if (ret == KNOT_EOK) {
+				ctx->nsec3 = true;
+				ctx->resume = false;
+			}
+		}
 		if (ret == KNOT_EOK) {
-			ret = zone_contents_nsec3_apply(zone->contents, send_node, ctx);
+			ret = read_tree(contents->nsec3_nodes, ctx);
 		}
 	}
+
+	if (ret == KNOT_EOK || ret == KNOT_ELIMIT) {
+		int flush_ret = send_bulk(ctx);
+		if (flush_ret != KNOT_EOK) {
+			return flush_ret;
+		}
+	}
+
+	// Let the client continue after the last node sent.
+	if (ret == KNOT_ELIMIT) {
+		ret = send_cursor(ctx);
+	}
+
 	return ret;
 }
 
@@ -1240,7 +1741,7 @@ static int send_stats_ctr(mod_ctr_t *ctr, uint64_t **stats_vals, unsigned thread
 		(*data)[KNOT_CTL_IDX_ID] = NULL;
 		(*data)[KNOT_CTL_IDX_DATA] = value;
 
-		ret = knot_ctl_send(args->ctl, KNOT_CTL_TYPE_DATA, data);
+		ret = ctl_send(args, KNOT_CTL_TYPE_DATA, data);
 		if (ret != KNOT_EOK) {
 			return ret;
 		}
@@ -1281,7 +1782,7 @@ static int send_stats_ctr(mod_ctr_t *ctr, uint64_t **stats_vals, unsigned thread
 
 			knot_ctl_type_t type = (i == 0) ? KNOT_CTL_TYPE_DATA :
 			                                  KNOT_CTL_TYPE_EXTRA;
-			ret = knot_ctl_send(args->ctl, type, data);
+			ret = ctl_send(args, type, data);
 			if (ret != KNOT_EOK) {
 				return ret;
 			}
@@ -1378,7 +1879,7 @@ static int ctl_zone(ctl_args_t *args, ctl_cmd_t cmd)
 	int ret;
 	switch (cmd) {
 	case CTL_ZONE_STATUS:
-		return zones_apply(args, zone_status);
+		return zones_apply_paged(args, zone_status);
 	case CTL_ZONE_RELOAD:
 		return zones_apply(args, zone_reload);
 	case CTL_ZONE_REFRESH:
@@ -1418,7 +1919,16 @@ static int ctl_zone(ctl_args_t *args, ctl_cmd_t cmd)
 	case CTL_ZONE_THAW:
 		return zones_apply(args, zone_thaw);
 	case CTL_ZONE_READ:
-		return zones_apply(args, zone_read);
+		// Read-only commands run concurrently, so the context cannot be shared.
+		args->custom_ctx = malloc(sizeof(send_ctx_t));
+		if (args->custom_ctx == NULL) {
+			send_error(args, knot_strerror(KNOT_ENOMEM));
+			return KNOT_ENOMEM;
+		}
+		ret = zones_apply(args, zone_read);
+		free(args->custom_ctx);
+		args->custom_ctx = NULL;
+		return ret;
 	case CTL_ZONE_BEGIN:
 		return zones_apply(args, zone_txn_begin);
 	case CTL_ZONE_COMMIT:
@@ -1479,7 +1989,7 @@ static int server_status(ctl_args_t *args)
 
 	args->data[KNOT_CTL_IDX_DATA] = buff;
 
-	return knot_ctl_send(args->ctl, KNOT_CTL_TYPE_DATA, &args->data);
+	return ctl_send(args, KNOT_CTL_TYPE_DATA, &args->data);
 }
 
 static int ctl_server(ctl_args_t *args, ctl_cmd_t cmd)
@@ -1488,7 +1998,9 @@ static int ctl_server(ctl_args_t *args, ctl_cmd_t cmd)
 
 	switch (cmd) {
 	case CTL_STATUS:
+		rcu_read_lock();
 		ret = server_status(args);
+		rcu_read_unlock();
 		if (ret != KNOT_EOK) {
 			send_error(args, knot_strerror(ret));
 		}
@@ -1510,7 +2022,55 @@ static int ctl_server(ctl_args_t *args, ctl_cmd_t cmd)
 	return ret;
 }
 
-static int ctl_stats(ctl_args_t *args, ctl_cmd_t cmd)
+static int control_stats(ctl_args_t *args, const char *item)
+{
+	const char *items[] = { "command-count", "command-latency" };
+	bool force = ctl_has_flag(args->data[KNOT_CTL_IDX_FLAGS], CTL_FLAG_FORCE);
+
+	uint64_t count[CTL__COUNT], time_us[CTL__COUNT];
+	pthread_mutex_lock(&ctl_counters.lock);
+	memcpy(count, ctl_counters.count, sizeof(count));
+	memcpy(time_us, ctl_counters.time_us, sizeof(time_us));
+	pthread_mutex_unlock(&ctl_counters.lock);
+
+	char value[32];
+	knot_ctl_data_t data = {
+		[KNOT_CTL_IDX_SECTION] = "control",
+		[KNOT_CTL_IDX_DATA] = value
+	};
+
+	for (int i = 0; i < sizeof(items) / sizeof(*items); i++) {
+		if (item != NULL && strcmp(item, items[i]) != 0) {
+			continue;
+		}
+		data[KNOT_CTL_IDX_ITEM] = items[i];
+
+		for (ctl_cmd_t cmd = CTL_NONE + 1; cmd < CTL__COUNT; cmd++) {
+			// Skip unused commands.
+			if (count[cmd] == 0 && !force) {
+				continue;
+			}
+			data[KNOT_CTL_IDX_ID] = ctl_cmd_to_str(cmd);
+
+			// The latency is the average command duration in microseconds.
+			uint64_t val = (i == 0) ? count[cmd] :
+			               (count[cmd] > 0 ? time_us[cmd] / count[cmd] : 0);
+			int ret = snprintf(value, sizeof(value), "%"PRIu64, val);
+			if (ret <= 0 || ret >= sizeof(value)) {
+				return KNOT_ESPACE;
+			}
+
+			ret = ctl_send(args, KNOT_CTL_TYPE_DATA, &data);
+			if (ret != KNOT_EOK) {
+				return ret;
+			}
+		}
+	}
+
+	return KNOT_EOK;
+}
+
+static int stats_send(ctl_args_t *args)
 {
 	const char *section = args->data[KNOT_CTL_IDX_SECTION];
 	const char *item = args->data[KNOT_CTL_IDX_ITEM];
@@ -1547,7 +2107,7 @@ static int ctl_stats(ctl_args_t *args, ctl_cmd_t cmd)
 				return ret;
 			}
 
-			ret = knot_ctl_send(args->ctl, KNOT_CTL_TYPE_DATA, &data);
+			ret = ctl_send(args, KNOT_CTL_TYPE_DATA, &data);
 			if (ret != KNOT_EOK) {
 				send_error(args, knot_strerror(ret));
 				return ret;
@@ -1555,6 +2115,17 @@ static int ctl_stats(ctl_args_t *args, ctl_cmd_t cmd)
 		}
 	}
 
+	// Process control metrics.
+	if (section == NULL || strcasecmp(section, "control") == 0) {
+		int ret = control_stats(args, item);
+		if (ret != KNOT_EOK) {
+			send_error(args, knot_strerror(ret));
+			return ret;
+		}
+
+		found = true;
+	}
+
 	// Process modules metrics.
 	if (section == NULL || strncasecmp(section, "mod-", strlen("mod-")) == 0) {
 		int ret = modules_stats(conf()->query_modules, args, NULL);
@@ -1574,6 +2145,15 @@ static int ctl_stats(ctl_args_t *args, ctl_cmd_t cmd)
 	return KNOT_EOK;
 }
 
+static int ctl_stats(ctl_args_t *args, ctl_cmd_t cmd)
+{
+	rcu_read_lock();
+	int ret = stats_send(args);
+	rcu_read_unlock();
+
+	return ret;
+}
+
 static int send_block_data(conf_io_t *io, knot_ctl_data_t *data)
 {
 	knot_ctl_t *ctl = (knot_ctl_t *)io->misc;
@@ -1833,17 +2413,18 @@ static int ctl_conf_modify(ctl_args_t *args, ctl_cmd_t cmd)
 typedef struct {
 	const char *name;
 	int (*fcn)(ctl_args_t *, ctl_cmd_t);
+	bool readonly; // Can be processed concurrently with other commands.
 } desc_t;
 
 static const desc_t cmd_table[] = {
 	[CTL_NONE]            = { "" },
 
-	[CTL_STATUS]          = { "status",          ctl_server },
+	[CTL_STATUS]          = { "status",          ctl_server, true },
 	[CTL_STOP]            = { "stop",            ctl_server },
 	[CTL_RELOAD]          = { "reload",          ctl_server },
-	[CTL_STATS]           = { "stats",           ctl_stats },
+	[CTL_STATS]           = { "stats",           ctl_stats, true },
 
-	[CTL_ZONE_STATUS]     = { "zone-status",        ctl_zone },
+	[CTL_ZONE_STATUS]     = { "zone-status",        ctl_zone, true },
 	[CTL_ZONE_RELOAD]     = { "zone-reload",        ctl_zone },
 	[CTL_ZONE_REFRESH]    = { "zone-refresh",       ctl_zone },
 	[CTL_ZONE_RETRANSFER] = { "zone-retransfer",    ctl_zone },
@@ -1857,7 +2438,7 @@ static const desc_t cmd_table[] = {
 	[CTL_ZONE_FREEZE]     = { "zone-freeze",        ctl_zone },
 	[CTL_ZONE_THAW]       = { "zone-thaw",          ctl_zone },
 
-	[CTL_ZONE_READ]       = { "zone-read",       ctl_zone },
+	[CTL_ZONE_READ]       = { "zone-read",       ctl_zone, true },
 	[CTL_ZONE_BEGIN]      = { "zone-begin",      ctl_zone },
 	[CTL_ZONE_COMMIT]     = { "zone-commit",     ctl_zone },
 	[CTL_ZONE_ABORT]      = { "zone-abort",      ctl_zone },
@@ -1866,7 +2447,7 @@ static const desc_t cmd_table[] = {
 	[CTL_ZONE_SET]        = { "zone-set",        ctl_zone },
 	[CTL_ZONE_UNSET]      = { "zone-unset",      ctl_zone },
 	[CTL_ZONE_PURGE]      = { "zone-purge",      ctl_zone },
-	[CTL_ZONE_STATS]      = { "zone-stats",	     ctl_zone },
+	[CTL_ZONE_STATS]      = { "zone-stats",	     ctl_zone, true },
 
 	[CTL_CONF_LIST]       = { "conf-list",       ctl_conf_read },
 	[CTL_CONF_READ]       = { "conf-read",       ctl_conf_read },
@@ -1911,7 +2492,36 @@ int ctl_exec(ctl_cmd_t cmd, ctl_args_t *args)
 		return KNOT_EINVAL;
 	}
 
-	return cmd_table[cmd].fcn(args, cmd);
+	const desc_t *desc = &cmd_table[cmd];
+	struct timespec begin = time_now();
+
+	// Read-only commands collect the output under RCU read lock and send it
+	// after the lock is released, other commands are serialized.
+	int ret;
+	if (desc->readonly) {
+		ctl_out_t out = { 0 };
+		args->out = &out;
+		ret = desc->fcn(args, cmd);
+		int send_ret = ctl_flush(args);
+		if (ret == KNOT_EOK) {
+			ret = send_ret;
+		}
+		args->out = NULL;
+	} else {
+		pthread_mutex_lock(&args->server->ctl_lock);
+		ret = desc->fcn(args, cmd);
+		pthread_mutex_unlock(&args->server->ctl_lock);
+	}
+
+	struct timespec end = time_now();
+	struct timespec diff = time_diff(&begin, &end);
+
+	pthread_mutex_lock(&ctl_counters.lock);
+	ctl_counters.count[cmd]++;
+	ctl_counters.time_us[cmd] += diff.tv_sec * 1000000 + diff.tv_nsec / 1000;
+	pthread_mutex_unlock(&ctl_counters.lock);
+
+	return ret;
 }
 
 bool ctl_has_flag(const char *flags, const char *flag)
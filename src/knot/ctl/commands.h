@@ -32,6 +32,9 @@
 #define CTL_FILTER_STATUS_FREEZE	'f'
 #define CTL_FILTER_STATUS_EVENTS	'e'
 
+#define CTL_FILTER_READ_BULK		'b'
+#define CTL_FILTER_READ_SUBTREE		's'
+
 #define CTL_FILTER_PURGE_EXPIRE		'e'
 #define CTL_FILTER_PURGE_TIMERS		't'
 #define CTL_FILTER_PURGE_ZONEFILE	'f'
@@ -82,8 +85,13 @@ typedef enum {
 	CTL_CONF_GET,
 	CTL_CONF_SET,
 	CTL_CONF_UNSET,
+
+	CTL__COUNT, /*!< The number of commands. */
 } ctl_cmd_t;
 
+/*! Output of a read-only command waiting to be sent. */
+typedef struct ctl_out ctl_out_t;
+
 /*! Control command parameters. */
 typedef struct {
 	knot_ctl_t *ctl;
@@ -92,6 +100,8 @@ typedef struct {
 	server_t *server;
 	bool failed;
 	void *custom_ctx;
+	ctl_out_t *out;  // Output collected under RCU read lock, NULL if sent directly.
+	unsigned step;   // Processing step of the current zone.
 } ctl_args_t;
 
 /*!
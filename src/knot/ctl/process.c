@@ -14,12 +14,41 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <unistd.h>
+
 #include "knot/common/log.h"
 #include "knot/ctl/commands.h"
 #include "knot/ctl/process.h"
+#include "knot/worker/pool.h"
 #include "libknot/error.h"
 #include "contrib/string.h"
 
+/*! Maximum number of connections (processed or queued) per worker. */
+#define CTL_PENDING_PER_WORKER	4
+
+struct ctl_pool {
+	worker_pool_t *workers;
+	server_t *server;
+	int pending_max;
+	pthread_mutex_t lock;
+	bool stopping;
+};
+
+typedef struct {
+	task_t task;
+	ctl_pool_t *pool;
+	knot_ctl_t *ctl;
+} ctl_client_t;
+
+typedef struct {
+	task_t task;
+	ctl_pool_t *pool;
+	bool catalog;
+} ctl_reload_t;
+
 int ctl_process(knot_ctl_t *ctl, server_t *server)
 {
 	if (ctl == NULL || server == NULL) {
@@ -58,6 +87,9 @@ int ctl_process(knot_ctl_t *ctl, server_t *server)
 			// All non-first data units should be parsed in a callback.
 			// Ignore if probable previous error.
 			continue;
+		case KNOT_CTL_TYPE_BULK:
+			// Bulk units are only sent by the server.
+			continue;
 		case KNOT_CTL_TYPE_BLOCK:
 			strip = false;
 			continue;
@@ -122,3 +154,126 @@ int ctl_process(knot_ctl_t *ctl, server_t *server)
 		}
 	}
 }
+
+static void ctl_client_run(task_t *task)
+{
+	ctl_client_t *client = task->ctx;
+	ctl_pool_t *pool = client->pool;
+
+	int ret = ctl_process(client->ctl, pool->server);
+	knot_ctl_close(client->ctl);
+	knot_ctl_free(client->ctl);
+	free(client);
+
+	if (ret == KNOT_CTL_ESTOP) {
+		// Only the main thread receives the signal and finishes the server.
+		pthread_mutex_lock(&pool->lock);
+		if (!pool->stopping) {
+			pool->stopping = true;
+			kill(getpid(), SIGTERM);
+		}
+		pthread_mutex_unlock(&pool->lock);
+	}
+}
+
+ctl_pool_t *ctl_pool_create(unsigned workers, server_t *server)
+{
+	if (workers == 0 || server == NULL) {
+		return NULL;
+	}
+
+	ctl_pool_t *pool = calloc(1, sizeof(*pool));
+	if (pool == NULL) {
+		return NULL;
+	}
+
+	pool->workers = worker_pool_create(workers);
+	if (pool->workers == NULL) {
+		free(pool);
+		return NULL;
+	}
+	pool->server = server;
+	pool->pending_max = workers * CTL_PENDING_PER_WORKER;
+	pthread_mutex_init(&pool->lock, NULL);
+
+	worker_pool_start(pool->workers);
+
+	return pool;
+}
+
+int ctl_pool_assign(ctl_pool_t *pool, knot_ctl_t *ctl)
+{
+	if (pool == NULL || ctl == NULL) {
+		return KNOT_EINVAL;
+	}
+
+	int running, queued;
+	worker_pool_status(pool->workers, &running, &queued);
+	if (running + queued >= pool->pending_max) {
+		return KNOT_EBUSY;
+	}
+
+	ctl_client_t *client = malloc(sizeof(*client));
+	if (client == NULL) {
+		return KNOT_ENOMEM;
+	}
+	client->task.ctx = client;
+	client->task.run = ctl_client_run;
+	client->pool = pool;
+	client->ctl = ctl;
+
+	worker_pool_assign(pool->workers, &client->task);
+
+	return KNOT_EOK;
+}
+
+static void ctl_reload_run(task_t *task)
+{
+	ctl_reload_t *reload = task->ctx;
+	server_t *server = reload->pool->server;
+
+	pthread_mutex_lock(&server->ctl_lock);
+	if (reload->catalog) {
+		server_update_catalog(conf(), server);
+	} else {
+		server_reload(server);
+	}
+	pthread_mutex_unlock(&server->ctl_lock);
+
+	free(reload);
+}
+
+int ctl_pool_reload(ctl_pool_t *pool, bool catalog)
+{
+	if (pool == NULL) {
+		return KNOT_EINVAL;
+	}
+
+	ctl_reload_t *reload = malloc(sizeof(*reload));
+	if (reload == NULL) {
+		return KNOT_ENOMEM;
+	}
+	reload->task.ctx = reload;
+	reload->task.run = ctl_reload_run;
+	reload->pool = pool;
+	reload->catalog = catalog;
+
+	worker_pool_assign(pool->workers, &reload->task);
+
+	return KNOT_EOK;
+}
+
+void ctl_pool_destroy(ctl_pool_t *pool)
+{
+	if (pool == NULL) {
+		return;
+	}
+
+	worker_pool_wait(pool->workers);
+	worker_pool_stop(pool->workers);
+	worker_pool_join(pool->workers);
+	worker_pool_destroy(pool->workers);
+
+	pthread_mutex_destroy(&pool->lock);
+	free(pool);
+}
@@ -28,3 +28,45 @@
  * \return Error code, KNOT_EOK if successful.
  */
 int ctl_process(knot_ctl_t *ctl, server_t *server);
+
+/*! Control connections processing pool. */
+typedef struct ctl_pool ctl_pool_t;
+
+/*!
+ * Creates a pool of threads processing control connections.
+ *
+ * \param[in] workers  Number of worker threads.
+ * \param[in] server   Server instance.
+ *
+ * \return Pool or NULL if failed.
+ */
+ctl_pool_t *ctl_pool_create(unsigned workers, server_t *server);
+
+/*!
+ * Passes an accepted control connection to the pool.
+ *
+ * \note The pool takes ownership of the control context if successful.
+ *
+ * \param[in] pool  Control pool.
+ * \param[in] ctl   Control context with an accepted connection.
+ *
+ * \return KNOT_EBUSY if too many connections are pending, KNOT_EOK if successful.
+ */
+int ctl_pool_assign(ctl_pool_t *pool, knot_ctl_t *ctl);
+
+/*!
+ * Schedules a server reload in the pool, serialized with the control commands.
+ *
+ * \param[in] pool     Control pool.
+ * \param[in] catalog  Only update the catalog zones instead of full reload.
+ *
+ * \return Error code, KNOT_EOK if successful.
+ */
+int ctl_pool_reload(ctl_pool_t *pool, bool catalog);
+
+/*!
+ * Waits for pending control connections and destroys the pool.
+ *
+ * \param[in] pool  Control pool.
+ */
+void ctl_pool_destroy(ctl_pool_t *pool);
@@ -43,6 +43,8 @@ typedef struct {
 	bool validation_mode;
 
 	knot_rrset_t *offline_rrsig;
+
+	const struct knot_nsec3_shadow *nsec3_shadow; // NSEC3 chain signed in advance
 } kdnssec_ctx_t;
 
 /*!
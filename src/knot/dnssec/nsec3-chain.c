@@ -15,7 +15,9 @@
  */
 
 #include <assert.h>
+#include <pthread.h>
 
+#include "libdnssec/error.h"
 #include "libknot/dname.h"
 #include "knot/dnssec/nsec-chain.h"
 #include "knot/dnssec/nsec3-chain.h"
@@ -414,54 +416,162 @@ static int reconnect_nsec3_nodes2(zone_node_t *a, zone_node_t *b,
 	return ret;
 }
 
+typedef struct {
+	const zone_contents_t *zone;
+	const dnssec_nsec3_params_t *params;
+	uint32_t ttl;
+	zone_node_t **nodes;       // regular nodes (delsafe iterator snapshot)
+	zone_node_t **nsec3_nodes; // created NSEC3 nodes, same indices
+	size_t count;
+	size_t num_threads;
+	size_t thread_index;
+	pthread_t thread;
+	int thread_init_errcode;
+	int errcode;
+} nsec3_create_args_t;
+
+static bool nsec3_node_skip(const zone_node_t *node)
+{
+	return (node->flags & (NODE_FLAGS_NONAUTH | NODE_FLAGS_EMPTY | NODE_FLAGS_DELETED));
+}
+
+/*!
+ * \brief Creates NSEC3 nodes for every num_threads-th regular node.
+ *
+ * Owner hashing is the expensive part, so it's done in parallel before the
+ * changeset is touched.
+ */
+static void *create_nsec3_nodes_thread(void *_arg)
+{
+	nsec3_create_args_t *arg = _arg;
+
+	for (size_t i = arg->thread_index; i < arg->count; i += arg->num_threads) {
+		const zone_node_t *node = arg->nodes[i];
+		if (nsec3_node_skip(node)) {
+			continue;
+		}
+
+		arg->nsec3_nodes[i] = create_nsec3_node_for_node(node, arg->zone->apex,
+		                                                 arg->params, arg->ttl);
+		if (arg->nsec3_nodes[i] == NULL) {
+			arg->errcode = KNOT_ENOMEM;
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+static int create_nsec3_nodes_parallel(const zone_contents_t *zone,
+                                       const dnssec_nsec3_params_t *params,
+                                       uint32_t ttl, size_t num_threads,
+                                       zone_tree_delsafe_it_t *it,
+                                       zone_node_t **nsec3_nodes)
+{
+	nsec3_create_args_t args[num_threads];
+	memset(args, 0, sizeof(args));
+
+	for (size_t i = 0; i < num_threads; i++) {
+		args[i].zone = zone;
+		args[i].params = params;
+		args[i].ttl = ttl;
+		args[i].nodes = it->nodes;
+		args[i].nsec3_nodes = nsec3_nodes;
+		args[i].count = it->total;
+		args[i].num_threads = num_threads;
+		args[i].thread_index = i;
+		args[i].errcode = KNOT_EOK;
+		args[i].thread_init_errcode = -1;
+	}
+
+	if (num_threads == 1) {
+		args[0].thread_init_errcode = 0;
+		create_nsec3_nodes_thread(&args[0]);
+	} else {
+		for (size_t i = 0; i < num_threads; i++) {
+			args[i].thread_init_errcode =
+				pthread_create(&args[i].thread, NULL, create_nsec3_nodes_thread, &args[i]);
+		}
+		for (size_t i = 0; i < num_threads; i++) {
+			if (args[i].thread_init_errcode == 0) {
+				args[i].thread_init_errcode = pthread_join(args[i].thread, NULL);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < num_threads; i++) {
+		if (args[i].thread_init_errcode != 0) {
+			return knot_map_errno_code(args[i].thread_init_errcode);
+		} else if (args[i].errcode != KNOT_EOK) {
+			return args[i].errcode;
+		}
+	}
+
+	return KNOT_EOK;
+}
+
 /*!
  * \brief Create NSEC3 node for each regular node in the zone.
  *
  * \param zone         Zone.
  * \param params       NSEC3 params.
  * \param ttl          TTL for the created NSEC records.
- * \param cds_in_apex  Hint to guess apex node type bitmap: false=just DNSKEY, true=DNSKEY,CDS,CDNSKEY.
+ * \param num_threads  Number of threads computing the NSEC3 nodes.
  * \param nsec3_nodes  Tree whereto new NSEC3 nodes will be added.
- * \param update       Zone update for possible NSEC removals
+ * \param update       Zone update for possible NSEC removals, or NULL.
  *
  * \return Error code, KNOT_EOK if successful.
  */
 static int create_nsec3_nodes(const zone_contents_t *zone,
                               const dnssec_nsec3_params_t *params,
                               uint32_t ttl,
+                              size_t num_threads,
                               zone_tree_t *nsec3_nodes,
                               zone_update_t *update)
 {
 	assert(zone);
 	assert(nsec3_nodes);
-	assert(update);
 
 	zone_tree_delsafe_it_t it = { 0 };
 	int result = zone_tree_delsafe_it_begin(zone->nodes, &it, false); // delsafe - removing nodes that contain only NSEC+RRSIG
+	if (result != KNOT_EOK || it.total == 0) {
+		zone_tree_delsafe_it_free(&it);
+		return result;
+	}
+
+	zone_node_t **created = calloc(it.total, sizeof(*created));
+	if (created == NULL) {
+		zone_tree_delsafe_it_free(&it);
+		return KNOT_ENOMEM;
+	}
 
-	while (!zone_tree_delsafe_it_finished(&it)) {
+	result = create_nsec3_nodes_parallel(zone, params, ttl, MAX(num_threads, 1),
+	                                     &it, created);
+
+	while (result == KNOT_EOK && !zone_tree_delsafe_it_finished(&it)) {
 		zone_node_t *node = zone_tree_delsafe_it_val(&it);
 
 		/*!
 		 * Remove possible NSEC from the node. (Do not allow both NSEC
 		 * and NSEC3 in the zone at once.)
 		 */
-		result = knot_nsec_changeset_remove(node, update);
-		if (result != KNOT_EOK) {
-			break;
+		if (update != NULL) {
+			result = knot_nsec_changeset_remove(node, update);
+			if (result != KNOT_EOK) {
+				break;
+			}
 		}
-		if (node->flags & NODE_FLAGS_NONAUTH || node->flags & NODE_FLAGS_EMPTY || node->flags & NODE_FLAGS_DELETED) {
+		if (nsec3_node_skip(node)) {
 			zone_tree_delsafe_it_next(&it);
 			continue;
 		}
 
-		zone_node_t *nsec3_node;
-		nsec3_node = create_nsec3_node_for_node(node, zone->apex,
-							params, ttl);
-		if (!nsec3_node) {
-			result = KNOT_ENOMEM;
-			break;
-		}
+		// The NSEC removal doesn't clear the node flags, so the node wasn't
+		// skipped by the parallel creation either. Neither does it change
+		// the NSEC3 bitmap, which ignores NSEC and RRSIG records.
+		zone_node_t *nsec3_node = created[it.current];
+		assert(nsec3_node != NULL);
+		created[it.current] = NULL;
 
 		result = zone_tree_insert(nsec3_nodes, &nsec3_node);
 		if (result != KNOT_EOK) {
@@ -471,6 +581,13 @@ static int create_nsec3_nodes(const zone_contents_t *zone,
 		zone_tree_delsafe_it_next(&it);
 	}
 
+	// free the NSEC3 nodes that have not been used
+	for (size_t i = 0; i < it.total; i++) {
+		node_free_rrsets(created[i], NULL);
+		node_free(created[i], NULL);
+	}
+	free(created);
+
 	zone_tree_delsafe_it_free(&it);
 
 	return result;
@@ -716,23 +833,19 @@ int delete_nsec3_chain(zone_update_t *up)
 }
 
 /*!
- * \brief Create new NSEC3 chain, add differences from current into a changeset.
+ * \brief Create connected NSEC3 nodes for the zone.
+ *
+ * \param update  Zone update for possible NSEC removals, or NULL.
  */
-int knot_nsec3_create_chain(const zone_contents_t *zone,
-                            const dnssec_nsec3_params_t *params,
-                            uint32_t ttl,
-                            zone_update_t *update)
+static int create_nsec3_tree(const zone_contents_t *zone,
+                             const dnssec_nsec3_params_t *params,
+                             uint32_t ttl,
+                             size_t num_threads,
+                             zone_update_t *update,
+                             zone_tree_t *nsec3_nodes)
 {
-	assert(zone);
-	assert(params);
-
 	bool opt_out = (params->flags & KNOT_NSEC3_FLAG_OPT_OUT);
 
-	zone_tree_t *nsec3_nodes = zone_tree_create(false);
-	if (!nsec3_nodes) {
-		return KNOT_ENOMEM;
-	}
-
 	/* Before creating NSEC3 nodes, we must temporarily mark those nodes
 	 * that may still be in the zone, but for which the NSEC3s should not
 	 * be created. I.e. nodes with only RRSIG (or NSEC+RRSIG) and their
@@ -744,13 +857,11 @@ int knot_nsec3_create_chain(const zone_contents_t *zone,
 	mark_empty_ctx_t mctx = { opt_out, false, NULL };
 	int result = zone_tree_apply(zone->nodes, nsec3_mark_empty, &mctx);
 	if (result != KNOT_EOK) {
-		free_nsec3_tree(nsec3_nodes);
 		return result;
 	}
 
-	result = create_nsec3_nodes(zone, params, ttl, nsec3_nodes, update);
+	result = create_nsec3_nodes(zone, params, ttl, num_threads, nsec3_nodes, update);
 	if (result != KNOT_EOK) {
-		free_nsec3_tree(nsec3_nodes);
 		return result;
 	}
 
@@ -761,27 +872,113 @@ int knot_nsec3_create_chain(const zone_contents_t *zone,
 	 */
 	result = zone_tree_apply(zone->nodes, nsec3_reset, NULL);
 	if (result != KNOT_EOK) {
-		free_nsec3_tree(nsec3_nodes);
 		return result;
 	}
 
-	result = knot_nsec_chain_iterate_create(nsec3_nodes,
-	                                        connect_nsec3_nodes, NULL);
-	if (result != KNOT_EOK) {
-		free_nsec3_tree(nsec3_nodes);
-		return result;
+	return knot_nsec_chain_iterate_create(nsec3_nodes, connect_nsec3_nodes, NULL);
+}
+
+/*!
+ * \brief Create new NSEC3 chain, add differences from current into a changeset.
+ */
+int knot_nsec3_create_chain(const zone_contents_t *zone,
+                            const dnssec_nsec3_params_t *params,
+                            uint32_t ttl,
+                            size_t num_threads,
+                            zone_update_t *update)
+{
+	assert(zone);
+	assert(params);
+
+	zone_tree_t *nsec3_nodes = zone_tree_create(false);
+	if (!nsec3_nodes) {
+		return KNOT_ENOMEM;
 	}
 
-	result = zone_update_nsec3_nodes(update, nsec3_nodes);
+	int result = create_nsec3_tree(zone, params, ttl, num_threads, update, nsec3_nodes);
+	if (result == KNOT_EOK) {
+		result = zone_update_nsec3_nodes(update, nsec3_nodes);
+	}
 
 	free_nsec3_tree(nsec3_nodes);
 
 	return result;
 }
 
+int knot_nsec3_shadow_create(zone_update_t *update,
+                             const dnssec_nsec3_params_t *params,
+                             uint32_t ttl,
+                             size_t num_threads,
+                             knot_nsec3_shadow_t **shadow)
+{
+	if (update == NULL || params == NULL || shadow == NULL) {
+		return KNOT_EINVAL;
+	}
+
+	knot_nsec3_shadow_t *s = calloc(1, sizeof(*s));
+	if (s == NULL) {
+		return KNOT_ENOMEM;
+	}
+
+	s->params = *params;
+	s->params.salt.data = NULL;
+	s->params.salt.size = 0;
+	s->nodes = zone_tree_create(false);
+	if (s->nodes == NULL ||
+	    dnssec_binary_dup(&params->salt, &s->params.salt) != DNSSEC_EOK) {
+		knot_nsec3_shadow_free(s);
+		return KNOT_ENOMEM;
+	}
+
+	// no update passed, the chain is created aside and nothing is changed
+	int ret = create_nsec3_tree(update->new_cont, params, ttl, num_threads,
+	                            NULL, s->nodes);
+	if (ret != KNOT_EOK) {
+		knot_nsec3_shadow_free(s);
+		return ret;
+	}
+
+	*shadow = s;
+	return KNOT_EOK;
+}
+
+bool knot_nsec3_shadow_rrsigs(const knot_nsec3_shadow_t *shadow,
+                              const knot_rrset_t *nsec3,
+                              knot_rrset_t *rrsigs)
+{
+	if (shadow == NULL || nsec3 == NULL || rrsigs == NULL) {
+		return false;
+	}
+
+	const zone_node_t *node = zone_tree_get(shadow->nodes, nsec3->owner);
+	knot_rrset_t shadow_nsec3 = node_rrset(node, KNOT_RRTYPE_NSEC3);
+	if (knot_rrset_empty(&shadow_nsec3) ||
+	    !knot_rrset_equal(&shadow_nsec3, nsec3, true)) {
+		return false;
+	}
+
+	*rrsigs = node_rrset(node, KNOT_RRTYPE_RRSIG);
+	return !knot_rrset_empty(rrsigs);
+}
+
+void knot_nsec3_shadow_free(knot_nsec3_shadow_t *shadow)
+{
+	if (shadow == NULL) {
+		return;
+	}
+
+	if (shadow->nodes != NULL) {
+		free_nsec3_tree(shadow->nodes);
+	}
+	knot_dname_free(shadow->last_signed, NULL);
+	dnssec_binary_free(&shadow->params.salt);
+	free(shadow);
+}
+
 int knot_nsec3_fix_chain(zone_update_t *update,
                          const dnssec_nsec3_params_t *params,
-                         uint32_t ttl)
+                         uint32_t ttl,
+                         size_t num_threads)
 {
 	assert(update);
 	assert(params);
@@ -794,7 +991,8 @@ int knot_nsec3_fix_chain(zone_update_t *update,
 		if (ret != KNOT_EOK) {
 			return ret;
 		}
-		return knot_nsec3_create_chain(update->new_cont, params, ttl, update);
+		return knot_nsec3_create_chain(update->new_cont, params, ttl,
+		                               num_threads, update);
 	}
 
 	mark_empty_ctx_t mctx = { opt_out, true, update->new_cont };
@@ -22,6 +22,16 @@
 #include "knot/updates/zone-update.h"
 #include "knot/zone/contents.h"
 
+/*!
+ * \brief NSEC3 chain with new parameters, signed in advance out of the zone.
+ */
+typedef struct knot_nsec3_shadow {
+	dnssec_nsec3_params_t params; //!< Parameters of the new chain.
+	zone_tree_t *nodes;           //!< NSEC3 nodes of the new chain.
+	knot_dname_t *last_signed;    //!< Owner of the last signed node, or NULL.
+	bool complete;                //!< All the nodes have been signed.
+} knot_nsec3_shadow_t;
+
 /*!
  * \brief delete_nsec3_chain   Delete all NSEC3 records and their RRSIGs.
  */
@@ -30,31 +40,73 @@ int delete_nsec3_chain(zone_update_t *up);
 /*!
  * \brief Creates new NSEC3 chain, add differences from current into a changeset.
  *
- * \param zone       Zone to be checked.
- * \param params     NSEC3 parameters.
- * \param ttl        TTL for new records.
- * \param update     Zone update to stare immediate changes into.
+ * \param zone         Zone to be checked.
+ * \param params       NSEC3 parameters.
+ * \param ttl          TTL for new records.
+ * \param num_threads  Number of threads hashing the node owners.
+ * \param update       Zone update to stare immediate changes into.
  *
  * \return KNOT_E*
  */
 int knot_nsec3_create_chain(const zone_contents_t *zone,
                             const dnssec_nsec3_params_t *params,
                             uint32_t ttl,
+                            size_t num_threads,
                             zone_update_t *update);
 
+/*!
+ * \brief Creates a shadow NSEC3 chain, leaving the zone intact.
+ *
+ * \note The node flags of the zone are temporarily modified, so the update
+ *       must not be published (it's expected to be rolled back afterwards).
+ *
+ * \param update       Zone update with the zone contents to create the chain for.
+ * \param params       NSEC3 parameters of the new chain.
+ * \param ttl          TTL for new records.
+ * \param num_threads  Number of threads hashing the node owners.
+ * \param shadow       Output: the new shadow chain.
+ *
+ * \return KNOT_E*
+ */
+int knot_nsec3_shadow_create(zone_update_t *update,
+                             const dnssec_nsec3_params_t *params,
+                             uint32_t ttl,
+                             size_t num_threads,
+                             knot_nsec3_shadow_t **shadow);
+
+/*!
+ * \brief Finds RRSIGs made in advance for an NSEC3 RRSet.
+ *
+ * \param shadow  Shadow NSEC3 chain.
+ * \param nsec3   NSEC3 RRSet to find the signatures for.
+ * \param rrsigs  Output: the RRSIGs, if the RRSet is identical in the shadow.
+ *
+ * \return True if the RRSIGs were found.
+ */
+bool knot_nsec3_shadow_rrsigs(const knot_nsec3_shadow_t *shadow,
+                              const knot_rrset_t *nsec3,
+                              knot_rrset_t *rrsigs);
+
+/*!
+ * \brief Frees the shadow NSEC3 chain.
+ */
+void knot_nsec3_shadow_free(knot_nsec3_shadow_t *shadow);
+
 /*!
  * \brief Updates zone's NSEC3 chain to follow the differences in zone update.
  *
- * \param update     Zone Update structure holding the zone and its update. Also modified!
- * \param params     NSEC3 parameters.
- * \param ttl        TTL for new records.
+ * \param update       Zone Update structure holding the zone and its update. Also modified!
+ * \param params       NSEC3 parameters.
+ * \param ttl          TTL for new records.
+ * \param num_threads  Number of threads for possible chain re-creation.
  *
  * \retval KNOT_ENORECORD if the chain must be recreated from scratch.
  * \return KNOT_E*
  */
 int knot_nsec3_fix_chain(zone_update_t *update,
                          const dnssec_nsec3_params_t *params,
-                         uint32_t ttl);
+                         uint32_t ttl,
+                         size_t num_threads);
 
 /*!
  * \brief Validate NSEC3 chain in new_cont as whole.
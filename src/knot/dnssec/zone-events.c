@@ -29,6 +29,8 @@
 #include "knot/dnssec/zone-sign.h"
 #include "knot/zone/adjust.h"
 
+#define NSEC3_SHADOW_SLICE 10000 // NSEC3 records signed in advance per resalt event
+
 static int sign_init(zone_contents_t *zone, zone_sign_flags_t flags, zone_sign_roll_flags_t roll_flags,
                      knot_time_t adjust_now, knot_lmdb_db_t *kaspdb, kdnssec_ctx_t *ctx,
                      zone_sign_reschedule_t *reschedule)
@@ -107,14 +109,8 @@ static int generate_salt(dnssec_binary_t *salt, uint16_t length)
 	return KNOT_EOK;
 }
 
-int knot_dnssec_nsec3resalt(kdnssec_ctx_t *ctx, knot_time_t *salt_changed, knot_time_t *when_resalt)
+static int nsec3resalt_when(const kdnssec_ctx_t *ctx, knot_time_t *when_resalt)
 {
-	int ret = KNOT_EOK;
-
-	if (!ctx->policy->nsec3_enabled) {
-		return KNOT_EOK;
-	}
-
 	if (ctx->zone->nsec3_salt.size != ctx->policy->nsec3_salt_length || ctx->zone->nsec3_salt_created == 0) {
 		*when_resalt = ctx->now;
 	} else if (knot_time_cmp(ctx->now, ctx->zone->nsec3_salt_created) < 0) {
@@ -123,6 +119,20 @@ int knot_dnssec_nsec3resalt(kdnssec_ctx_t *ctx, knot_time_t *salt_changed, knot_
 		*when_resalt = knot_time_plus(ctx->zone->nsec3_salt_created, ctx->policy->nsec3_salt_lifetime);
 	}
 
+	return KNOT_EOK;
+}
+
+int knot_dnssec_nsec3resalt(kdnssec_ctx_t *ctx, knot_time_t *salt_changed, knot_time_t *when_resalt)
+{
+	if (!ctx->policy->nsec3_enabled) {
+		return KNOT_EOK;
+	}
+
+	int ret = nsec3resalt_when(ctx, when_resalt);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
 	if (knot_time_cmp(*when_resalt, ctx->now) <= 0) {
 		if (ctx->policy->nsec3_salt_length == 0) {
 			ctx->zone->nsec3_salt.size = 0;
@@ -145,6 +155,126 @@ int knot_dnssec_nsec3resalt(kdnssec_ctx_t *ctx, knot_time_t *salt_changed, knot_
 	return ret;
 }
 
+static int nsec3_shadow_start(kdnssec_ctx_t *ctx, zone_t *zone)
+{
+	dnssec_binary_t salt = { 0 };
+	int ret = generate_salt(&salt, ctx->policy->nsec3_salt_length);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
+	// the chain is created from a private copy of the zone, never published
+	zone_update_t up;
+	ret = zone_update_init(&up, zone, UPDATE_INCREMENTAL);
+	if (ret != KNOT_EOK) {
+		dnssec_binary_free(&salt);
+		return ret;
+	}
+
+	ret = knot_zone_create_nsec3_shadow(&up, ctx, &salt, &zone->nsec3_shadow);
+	zone_update_clear(&up);
+	dnssec_binary_free(&salt);
+	if (ret == KNOT_EOK) {
+		log_zone_info(zone->name, "DNSSEC, NSEC3 resalt, signing new chain in advance, "
+		              "records %zu", zone_tree_count(zone->nsec3_shadow->nodes));
+	}
+
+	return ret;
+}
+
+static int nsec3_shadow_continue(kdnssec_ctx_t *ctx, zone_t *zone)
+{
+	zone_keyset_t keyset = { 0 };
+	int ret = load_zone_keys(ctx, &keyset, false);
+	if (ret == KNOT_EOK) {
+		ret = knot_zone_sign_nsec3_shadow(zone->nsec3_shadow, NSEC3_SHADOW_SLICE,
+		                                  &keyset, ctx);
+		free_zone_keys(&keyset);
+	}
+
+	return ret;
+}
+
+static int nsec3_shadow_switch(kdnssec_ctx_t *ctx, zone_t *zone,
+                               knot_time_t *salt_changed, knot_time_t *when_resalt)
+{
+	dnssec_binary_t salt = { 0 };
+	int ret = dnssec_binary_dup(&zone->nsec3_shadow->params.salt, &salt);
+	if (ret != DNSSEC_EOK) {
+		return knot_error_from_libdnssec(ret);
+	}
+
+	dnssec_binary_free(&ctx->zone->nsec3_salt);
+	ctx->zone->nsec3_salt = salt;
+	ctx->zone->nsec3_salt_created = ctx->now;
+	ret = kdnssec_ctx_commit(ctx);
+	if (ret == KNOT_EOK) {
+		*salt_changed = ctx->now;
+		log_zone_info(zone->name, "DNSSEC, NSEC3 resalt, new chain signed");
+	}
+	// continue to planning next resalt even if NOK
+	*when_resalt = knot_time_plus(ctx->now, ctx->policy->nsec3_salt_lifetime);
+
+	return ret;
+}
+
+int knot_dnssec_nsec3resalt_shadow(kdnssec_ctx_t *ctx, zone_t *zone,
+                                   knot_time_t *salt_changed, knot_time_t *when_resalt)
+{
+	knot_nsec3_shadow_t *shadow = zone->nsec3_shadow;
+	if (shadow != NULL && (shadow->complete || !ctx->policy->nsec3_enabled ||
+	    shadow->params.iterations != ctx->policy->nsec3_iterations ||
+	    shadow->params.salt.size != ctx->policy->nsec3_salt_length)) {
+		// leftover or outdated by the policy change
+		knot_nsec3_shadow_free(shadow);
+		zone->nsec3_shadow = NULL;
+	}
+
+	if (!ctx->policy->nsec3_enabled) {
+		return KNOT_EOK;
+	}
+
+	int ret = KNOT_EOK;
+	if (zone->nsec3_shadow == NULL) {
+		ret = nsec3resalt_when(ctx, when_resalt);
+		if (ret != KNOT_EOK || knot_time_cmp(*when_resalt, ctx->now) > 0) {
+			return ret;
+		}
+
+		// the first salt, its length change, or an empty zone are done at once
+		if (ctx->zone->nsec3_salt.size != ctx->policy->nsec3_salt_length ||
+		    ctx->zone->nsec3_salt_created == 0 || ctx->policy->nsec3_salt_length == 0 ||
+		    zone_contents_is_empty(zone->contents)) {
+			return knot_dnssec_nsec3resalt(ctx, salt_changed, when_resalt);
+		}
+
+		ret = nsec3_shadow_start(ctx, zone);
+	} else {
+		ret = nsec3_shadow_continue(ctx, zone);
+	}
+
+	if (ret != KNOT_EOK) {
+		log_zone_warning(zone->name, "DNSSEC, NSEC3 resalt, failed to sign new "
+		                 "chain in advance (%s)", knot_strerror(ret));
+		knot_nsec3_shadow_free(zone->nsec3_shadow);
+		zone->nsec3_shadow = NULL;
+		return knot_dnssec_nsec3resalt(ctx, salt_changed, when_resalt);
+	}
+
+	if (!zone->nsec3_shadow->complete) {
+		*when_resalt = ctx->now;
+		return KNOT_EOK;
+	}
+
+	ret = nsec3_shadow_switch(ctx, zone, salt_changed, when_resalt);
+	if (ret != KNOT_EOK) {
+		knot_nsec3_shadow_free(zone->nsec3_shadow);
+		zone->nsec3_shadow = NULL;
+	}
+
+	return ret;
+}
+
 int knot_dnssec_zone_sign(zone_update_t *update,
                           zone_sign_flags_t flags,
                           zone_sign_roll_flags_t roll_flags,
@@ -160,6 +290,12 @@ int knot_dnssec_zone_sign(zone_update_t *update,
 	kdnssec_ctx_t ctx = { 0 };
 	zone_keyset_t keyset = { 0 };
 
+	knot_nsec3_shadow_t *shadow = update->zone->nsec3_shadow;
+	if (shadow != NULL && !shadow->complete) {
+		// the resalt is in progress, let it finish in advance
+		roll_flags &= ~KEY_ROLL_ALLOW_NSEC3RESALT;
+	}
+
 	// signing pipeline
 
 	result = sign_init(update->new_cont, flags, roll_flags, adjust_now,
@@ -177,6 +313,11 @@ int knot_dnssec_zone_sign(zone_update_t *update,
 		goto done;
 	}
 
+	if (shadow != NULL && shadow->complete &&
+	    dnssec_binary_cmp(&shadow->params.salt, &ctx.zone->nsec3_salt) == 0) {
+		ctx.nsec3_shadow = shadow;
+	}
+
 	log_zone_info(zone_name, "DNSSEC, signing started");
 
 	knot_time_t next_resign = 0;
@@ -238,6 +379,11 @@ done:
 		reschedule->next_sign = knot_dnssec_failover_delay(&ctx);
 	}
 
+	if (shadow != NULL && shadow->complete) {
+		knot_nsec3_shadow_free(shadow);
+		update->zone->nsec3_shadow = NULL;
+	}
+
 	free_zone_keys(&keyset);
 	kdnssec_ctx_deinit(&ctx);
 
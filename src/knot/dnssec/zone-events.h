@@ -108,6 +108,24 @@ int knot_dnssec_sign_update(zone_update_t *update, zone_sign_reschedule_t *resch
  */
 int knot_dnssec_nsec3resalt(kdnssec_ctx_t *ctx, knot_time_t *salt_changed, knot_time_t *when_resalt);
 
+/*!
+ * \brief Check NSEC3 salt like knot_dnssec_nsec3resalt(), but prepare the new chain in advance.
+ *
+ * When the salt is due, the new NSEC3 chain is created aside from the zone and
+ * signed in slices by repeated calls, while the old salt stays in effect. The
+ * new salt is committed once the chain is fully signed, and the following
+ * signing reuses its RRSIGs. On failure, the salt is changed immediately.
+ *
+ * \param ctx           zone signing context
+ * \param zone          zone holding the chain being prepared
+ * \param salt_changed  output if KNOT_EOK: when was the salt last changed? (either ctx->now or 0)
+ * \param when_resalt   output: timestamp when to call this again
+ *
+ * \return KNOT_E*
+ */
+int knot_dnssec_nsec3resalt_shadow(kdnssec_ctx_t *ctx, zone_t *zone,
+                                   knot_time_t *salt_changed, knot_time_t *when_resalt);
+
 /*!
  * \brief When DNSSEC signing failed, re-plan on this time.
  *
@@ -343,7 +343,7 @@ int knot_zone_create_nsec_chain(zone_update_t *update, const kdnssec_ctx_t *ctx)
 
 	if (ctx->policy->nsec3_enabled) {
 		ret = knot_nsec3_create_chain(update->new_cont, &params, nsec_ttl,
-		                              update);
+		                              ctx->policy->signing_threads, update);
 	} else {
 		ret = knot_nsec_create_chain(update, nsec_ttl);
 		if (ret == KNOT_EOK) {
@@ -353,6 +353,27 @@ int knot_zone_create_nsec_chain(zone_update_t *update, const kdnssec_ctx_t *ctx)
 	return ret;
 }
 
+int knot_zone_create_nsec3_shadow(zone_update_t *update, const kdnssec_ctx_t *ctx,
+                                  const dnssec_binary_t *salt,
+                                  knot_nsec3_shadow_t **shadow)
+{
+	if (update == NULL || ctx == NULL || salt == NULL || shadow == NULL ||
+	    !ctx->policy->nsec3_enabled) {
+		return KNOT_EINVAL;
+	}
+
+	int nsec_ttl = zone_nsec_ttl(update->new_cont);
+	if (nsec_ttl < 0) {
+		return nsec_ttl;
+	}
+
+	dnssec_nsec3_params_t params = nsec3param_init(ctx->policy, ctx->zone);
+	params.salt = *salt;
+
+	return knot_nsec3_shadow_create(update, &params, nsec_ttl,
+	                                ctx->policy->signing_threads, shadow);
+}
+
 int knot_zone_fix_nsec_chain(zone_update_t *update,
                              const zone_keyset_t *zone_keys,
                              const kdnssec_ctx_t *ctx)
@@ -373,7 +394,8 @@ int knot_zone_fix_nsec_chain(zone_update_t *update,
 	if (nsec_ttl_old != nsec_ttl_new || (update->flags & UPDATE_CHANGED_NSEC)) {
 		ret = KNOT_ENORECORD;
 	} else if (ctx->policy->nsec3_enabled) {
-		ret = knot_nsec3_fix_chain(update, &params, nsec_ttl_new);
+		ret = knot_nsec3_fix_chain(update, &params, nsec_ttl_new,
+		                           ctx->policy->signing_threads);
 	} else {
 		ret = knot_nsec_fix_chain(update, nsec_ttl_new);
 	}
@@ -382,7 +404,9 @@ int knot_zone_fix_nsec_chain(zone_update_t *update,
 		              (ctx->policy->nsec3_enabled ? "3" : ""));
 		if (ctx->policy->nsec3_enabled) {
 			ret = knot_nsec3_create_chain(update->new_cont, &params,
-			                              nsec_ttl_new, update);
+			                              nsec_ttl_new,
+			                              ctx->policy->signing_threads,
+			                              update);
 		} else {
 			ret = knot_nsec_create_chain(update, nsec_ttl_new);
 		}
@@ -19,6 +19,7 @@
 #include <stdbool.h>
 
 #include "knot/dnssec/context.h"
+#include "knot/dnssec/nsec3-chain.h"
 #include "knot/dnssec/zone-keys.h"
 #include "knot/updates/zone-update.h"
 #include "knot/zone/contents.h"
@@ -135,6 +136,20 @@ int knot_nsec3param_update(zone_update_t *update,
  */
 int knot_zone_create_nsec_chain(zone_update_t *update, const kdnssec_ctx_t *ctx);
 
+/*!
+ * \brief Create NSEC3 chain with a new salt aside from the zone.
+ *
+ * \param update          Zone update with current zone contents, left intact.
+ * \param ctx             Signing context.
+ * \param salt            The new NSEC3 salt.
+ * \param shadow          Output: the new NSEC3 chain, to be signed in advance.
+ *
+ * \return Error code, KNOT_EOK if successful.
+ */
+int knot_zone_create_nsec3_shadow(zone_update_t *update, const kdnssec_ctx_t *ctx,
+                                  const dnssec_binary_t *salt,
+                                  knot_nsec3_shadow_t **shadow);
+
 /*!
  * \brief Fix NSEC or NSEC3 chain after zone was updated, and sign the changed NSECs.
  *
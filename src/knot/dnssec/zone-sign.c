@@ -202,6 +202,48 @@ static void note_earliest_expiration(const knot_rdata_t *rrsig, knot_time_t *exp
 	*expires_at = knot_time_min(current, *expires_at);
 }
 
+/*!
+ * \brief Reuse an RRSIG of identical NSEC3 from the chain signed in advance.
+ *
+ * \param covered     NSEC3 RR set to be signed.
+ * \param key         Signing key.
+ * \param sign_ctx    Signing context of the key.
+ * \param dnssec_ctx  DNSSEC context with the shadow chain.
+ * \param to_add      RRSIGs to be added, updated if found.
+ * \param expires_at  Current earliest expiration, will be updated.
+ * \param result      Output: error code.
+ *
+ * \return True if the RRSIG was found (and added if no error).
+ */
+static bool use_presigned(const knot_rrset_t *covered,
+                          const zone_key_t *key,
+                          dnssec_sign_ctx_t *sign_ctx,
+                          const kdnssec_ctx_t *dnssec_ctx,
+                          knot_rrset_t *to_add,
+                          knot_time_t *expires_at,
+                          int *result)
+{
+	if (covered->type != KNOT_RRTYPE_NSEC3 || dnssec_ctx->nsec3_shadow == NULL) {
+		return false;
+	}
+
+	knot_rrset_t rrsigs;
+	if (!knot_nsec3_shadow_rrsigs(dnssec_ctx->nsec3_shadow, covered, &rrsigs)) {
+		return false;
+	}
+
+	uint16_t valid_at;
+	if (!valid_signature_exists(covered, &rrsigs, key->key, sign_ctx,
+	                            dnssec_ctx, true, NULL, &valid_at)) {
+		return false;
+	}
+
+	knot_rdata_t *valid_rr = knot_rdataset_at(&rrsigs.rrs, valid_at);
+	*result = knot_rdataset_add(&to_add->rrs, valid_rr, NULL);
+	note_earliest_expiration(valid_rr, expires_at);
+	return true;
+}
+
 bool rrsig_covers_type(const knot_rrset_t *rrsig, uint16_t type)
 {
 	if (knot_rrset_empty(rrsig)) {
@@ -280,6 +322,11 @@ static int add_missing_rrsigs(const knot_rrset_t *covered,
 			continue;
 		}
 
+		if (use_presigned(covered, key, sign_ctx->sign_ctxs[i], sign_ctx->dnssec_ctx,
+		                  &to_add, expires_at, &result)) {
+			continue;
+		}
+
 		result = knot_sign_rrset(&to_add, covered, key->key, sign_ctx->sign_ctxs[i],
 		                         sign_ctx->dnssec_ctx, NULL, expires_at);
 	}
@@ -1011,6 +1058,60 @@ int knot_zone_sign_nsecs_in_changeset(const zone_keyset_t *zone_keys,
 	return ret;
 }
 
+int knot_zone_sign_nsec3_shadow(knot_nsec3_shadow_t *shadow,
+                                size_t max_count,
+                                const zone_keyset_t *zone_keys,
+                                const kdnssec_ctx_t *dnssec_ctx)
+{
+	if (shadow == NULL || zone_keys == NULL || dnssec_ctx == NULL) {
+		return KNOT_EINVAL;
+	}
+
+	zone_sign_ctx_t *sign_ctx = zone_sign_ctx(zone_keys, dnssec_ctx);
+	if (sign_ctx == NULL) {
+		return KNOT_ENOMEM;
+	}
+
+	// resume after the last signed node
+	zone_tree_it_t it = { 0 };
+	int ret = (shadow->last_signed == NULL) ?
+	          zone_tree_it_begin(shadow->nodes, &it) :
+	          zone_tree_it_from_begin(shadow->nodes, shadow->last_signed, true, &it);
+
+	zone_node_t *n = NULL;
+	for (size_t i = 0; i < max_count && ret == KNOT_EOK &&
+	                   !zone_tree_it_finished(&it); i++) {
+		n = zone_tree_it_val(&it);
+		knot_rrset_t nsec3 = node_rrset(n, KNOT_RRTYPE_NSEC3);
+		if (!knot_rrset_empty(&nsec3)) {
+			knot_rrset_t rrsigs = create_empty_rrsigs_for(&nsec3);
+			ret = knot_sign_rrset2(&rrsigs, &nsec3, sign_ctx, NULL);
+			if (ret == KNOT_EOK && !knot_rrset_empty(&rrsigs)) {
+				ret = node_add_rrset(n, &rrsigs, NULL);
+			}
+			knot_rdataset_clear(&rrsigs.rrs, NULL);
+		}
+		zone_tree_it_next(&it);
+	}
+
+	if (ret == KNOT_EOK && n != NULL) {
+		knot_dname_free(shadow->last_signed, NULL);
+		shadow->last_signed = knot_dname_copy(n->owner, NULL);
+		if (shadow->last_signed == NULL) {
+			ret = KNOT_ENOMEM;
+		}
+	}
+
+	if (ret == KNOT_EOK && zone_tree_it_finished(&it)) {
+		shadow->complete = true;
+	}
+
+	zone_tree_it_free(&it);
+	zone_sign_ctx_free(sign_ctx);
+
+	return ret;
+}
+
 bool knot_zone_sign_rr_should_be_signed(const zone_node_t *node,
                                         const knot_rrset_t *rrset)
 {
@@ -20,6 +20,7 @@
 #include "knot/updates/zone-update.h"
 #include "knot/zone/contents.h"
 #include "knot/dnssec/context.h"
+#include "knot/dnssec/nsec3-chain.h"
 #include "knot/dnssec/zone-keys.h"
 
 int rrset_add_zone_key(knot_rrset_t *rrset, zone_key_t *zone_key);
@@ -118,6 +119,21 @@ bool knot_zone_sign_soa_expired(const zone_contents_t *zone,
                                 const zone_keyset_t *zone_keys,
                                 const kdnssec_ctx_t *dnssec_ctx);
 
+/*!
+ * \brief Sign next slice of the shadow NSEC3 chain.
+ *
+ * \param shadow      Shadow NSEC3 chain, the RRSIGs are stored into its nodes.
+ * \param max_count   Maximal number of NSEC3 RRSets to be signed.
+ * \param zone_keys   Zone keys.
+ * \param dnssec_ctx  DNSSEC context.
+ *
+ * \return Error code, KNOT_EOK if successful.
+ */
+int knot_zone_sign_nsec3_shadow(knot_nsec3_shadow_t *shadow,
+                                size_t max_count,
+                                const zone_keyset_t *zone_keys,
+                                const kdnssec_ctx_t *dnssec_ctx);
+
 /*!
  * \brief Sign NSEC/NSEC3 nodes in changeset and update the changeset.
  *
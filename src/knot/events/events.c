@@ -51,6 +51,7 @@ static const event_info_t EVENT_INFO[] = {
 	{ ZONE_EVENT_NSEC3RESALT,  event_nsec3resalt, "NSEC3 resalt" },
 	{ ZONE_EVENT_DS_CHECK,     event_ds_check,    "DS check" },
 	{ ZONE_EVENT_DS_PUSH,      event_ds_push,     "DS push" },
+	{ ZONE_EVENT_UNLOAD,       event_unload,      "unload" },
 	{ 0 }
 };
 
@@ -82,6 +83,7 @@ bool ufreeze_applies(zone_event_type_t type)
 	case ZONE_EVENT_DNSSEC:
 	case ZONE_EVENT_NSEC3RESALT:
 	case ZONE_EVENT_DS_CHECK:
+	case ZONE_EVENT_UNLOAD:
 		return true;
 	default:
 		return false;
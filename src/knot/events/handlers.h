@@ -22,6 +22,8 @@
 
 /*! \brief Loads or reloads potentially changed zone. */
 int event_load(conf_t *conf, zone_t *zone);
+/*! \brief Drops idle lazily loaded zone contents from memory. */
+int event_unload(conf_t *conf, zone_t *zone);
 /*! \brief Refresh a zone from a master. */
 int event_refresh(conf_t *conf, zone_t *zone);
 /*! \brief Processes DDNS updates in the zone's DDNS queue. */
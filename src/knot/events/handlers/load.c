@@ -15,6 +15,8 @@
  */
 
 #include <assert.h>
+#include <sys/stat.h>
+#include <urcu.h>
 
 #include "knot/common/log.h"
 #include "knot/conf/conf.h"
@@ -22,12 +24,14 @@
 #include "knot/dnssec/zone-events.h"
 #include "knot/events/handlers.h"
 #include "knot/events/replan.h"
+#include "knot/journal/journal_metadata.h"
 #include "knot/zone/serial.h"
 #include "knot/zone/zone-diff.h"
 #include "knot/zone/zone-load.h"
 #include "knot/zone/zone.h"
 #include "knot/zone/zonefile.h"
 #include "knot/updates/acl.h"
+#include "contrib/macros.h"
 
 static bool dontcare_load_error(conf_t *conf, const zone_t *zone)
 {
@@ -51,18 +55,67 @@ static bool allowed_xfr(conf_t *conf, const zone_t *zone)
 	return false;
 }
 
+/*!
+ * \brief Check if the zone file is the same as when last loaded or written.
+ *
+ * If so, the known zone file attributes are restored.
+ */
+static bool zonefile_known(conf_t *conf, zone_t *zone)
+{
+	if (zone->timers.zonefile_hash == 0) {
+		return false;
+	}
+
+	struct timespec mtime;
+	uint64_t size, hash;
+	char *filename = conf_zonefile(conf, zone->name);
+	int ret = zonefile_exists(filename, &mtime);
+	if (ret == KNOT_EOK) {
+		ret = zonefile_fingerprint(filename, &size, &hash);
+	}
+	free(filename);
+
+	if (ret != KNOT_EOK || size != zone->timers.zonefile_size ||
+	    hash != zone->timers.zonefile_hash) {
+		return false;
+	}
+
+	zone->zonefile.serial = zone->timers.zonefile_serial;
+	zone->zonefile.exists = true;
+	zone->zonefile.mtime = mtime;
+
+	return true;
+}
+
+/*!
+ * \brief Check if the zone file wasn't modified since it was fingerprinted.
+ *
+ * The fingerprint is computed in a separate read, so the parser could have
+ * consumed different bytes if the file was being rewritten meanwhile.
+ */
+static bool zonefile_stable(const char *filename, uint64_t size,
+                            const struct timespec *mtime)
+{
+	struct stat st;
+	return (stat(filename, &st) == 0 && (uint64_t)st.st_size == size &&
+	        st.st_mtim.tv_sec == mtime->tv_sec &&
+	        st.st_mtim.tv_nsec == mtime->tv_nsec);
+}
+
 int event_load(conf_t *conf, zone_t *zone)
 {
 	zone_update_t up = { 0 };
 	zone_contents_t *journal_conts = NULL, *zf_conts = NULL;
 	bool old_contents_exist = (zone->contents != NULL), zone_in_journal_exists = false;
 
-	conf_val_t val = conf_zone_get(conf, C_JOURNAL_CONTENT, zone->name);
-	unsigned load_from = conf_opt(&val);
+	conf_zone_cache_t zcache = conf_zone_cache(conf, zone->name);
+	unsigned load_from = zcache.journal_content;
 
-	val = conf_zone_get(conf, C_ZONEFILE_LOAD, zone->name);
+	conf_val_t val = conf_zone_get(conf, C_ZONEFILE_LOAD, zone->name);
 	unsigned zf_from = conf_opt(&val);
 
+	bool dnssec_enable = zcache.dnssec_signing, zu_from_zf_conts = false;
+
 	int ret = KNOT_EOK;
 
 	// If configured, load journal contents.
@@ -76,18 +129,37 @@ int event_load(conf_t *conf, zone_t *zone)
 		zone_in_journal_exists = zone_journal_has_zij(zone);
 	}
 
+	// Parsing the same zone file again would make no difference to the
+	// existing contents, unless DNSSEC records are to be handled.
+	bool zf_skip = (zf_from == ZONEFILE_LOAD_DIFF && !dnssec_enable &&
+	                (old_contents_exist || journal_conts != NULL) &&
+	                zonefile_known(conf, zone));
+	if (zf_skip) {
+		log_zone_info(zone->name, "zone file unchanged, serial %u",
+		              zone->zonefile.serial);
+	}
+
 	// If configured, attempt to load zonefile.
-	if (zf_from != ZONEFILE_LOAD_NONE) {
+	uint64_t zf_size = 0, zf_hash = 0;
+	if (zf_from != ZONEFILE_LOAD_NONE && !zf_skip) {
 		struct timespec mtime;
 		char *filename = conf_zonefile(conf, zone->name);
 		ret = zonefile_exists(filename, &mtime);
 		bool zonefile_unchanged = (zone->zonefile.exists &&
 					   zone->zonefile.mtime.tv_sec == mtime.tv_sec &&
 					   zone->zonefile.mtime.tv_nsec == mtime.tv_nsec);
-		free(filename);
+		if (ret == KNOT_EOK &&
+		    zonefile_fingerprint(filename, &zf_size, &zf_hash) != KNOT_EOK) {
+			zf_hash = 0; // Not fatal, the zone file just won't be skipped.
+		}
 		if (ret == KNOT_EOK) {
 			ret = zone_load_contents(conf, zone->name, &zf_conts, false);
 		}
+		if (ret == KNOT_EOK && zf_hash != 0 &&
+		    !zonefile_stable(filename, zf_size, &mtime)) {
+			zf_hash = 0; // The parsed contents may not match the hash.
+		}
+		free(filename);
 		if (ret != KNOT_EOK) {
 			zf_conts = NULL;
 			if (dontcare_load_error(conf, zone)) {
@@ -109,8 +181,7 @@ int event_load(conf_t *conf, zone_t *zone)
 		zone_contents_t *relevant = (zone->contents != NULL ? zone->contents : journal_conts);
 		if (zf_conts != NULL && zf_from == ZONEFILE_LOAD_DIFSE && relevant != NULL) {
 			uint32_t serial = zone_contents_serial(relevant);
-			conf_val_t policy = conf_zone_get(conf, C_SERIAL_POLICY, zone->name);
-			uint32_t set = serial_next(serial, conf_opt(&policy));
+			uint32_t set = serial_next(serial, zcache.serial_policy);
 			zone_contents_set_soa_serial(zf_conts, set);
 			log_zone_info(zone->name, "zone file parsed, serial corrected %u -> %u",
 			              zone->zonefile.serial, set);
@@ -146,8 +217,7 @@ int event_load(conf_t *conf, zone_t *zone)
 		}
 	}
 
-	val = conf_zone_get(conf, C_DNSSEC_SIGNING, zone->name);
-	bool dnssec_enable = conf_bool(&val), zu_from_zf_conts = false;
+	bool zf_loaded = (zf_conts != NULL);
 	bool do_diff = (zf_from == ZONEFILE_LOAD_DIFF || zf_from == ZONEFILE_LOAD_DIFSE);
 	bool ignore_dnssec = (do_diff && dnssec_enable);
 
@@ -281,6 +351,14 @@ int event_load(conf_t *conf, zone_t *zone)
 
 	log_zone_info(zone->name, "loaded, serial %s -> %u%s, %zu bytes",
 	              old_serial_str, middle_serial, new_serial_str, zone->contents->size);
+	zone->lazy.pending = false;
+
+	// Remember the applied zone file.
+	if (zf_loaded) {
+		zone->timers.zonefile_size = zf_size;
+		zone->timers.zonefile_hash = zf_hash;
+		zone->timers.zonefile_serial = zone->zonefile.serial;
+	}
 
 	// Schedule depedent events.
 	const knot_rdataset_t *soa = zone_soa(zone);
@@ -299,6 +377,9 @@ int event_load(conf_t *conf, zone_t *zone)
 	return KNOT_EOK;
 
 cleanup:
+	// Let the next query retry a failed lazy load.
+	zone->lazy.pending = false;
+
 	// Try to bootstrap the zone if local error.
 	replan_from_timers(conf, zone);
 
@@ -308,3 +389,40 @@ cleanup:
 
 	return (dontcare_load_error(conf, zone) ? KNOT_EOK : ret);
 }
+
+int event_unload(conf_t *conf, zone_t *zone)
+{
+	UNUSED(conf);
+	assert(zone);
+
+	if (!zone->lazy.enabled || zone->contents == NULL) {
+		return KNOT_EOK;
+	}
+
+	// The contents must be possible to load again in the same state.
+	uint32_t serial = zone_contents_serial(zone->contents);
+	if (!zone->zonefile.exists || zone->zonefile.serial != serial) {
+		bool exists = false;
+		uint32_t journal_serial = 0;
+		int ret = journal_info(zone_journal(zone), &exists, NULL, NULL,
+		                       &journal_serial, NULL, NULL, NULL, NULL);
+		if (ret != KNOT_EOK || !exists || journal_serial != serial) {
+			log_zone_debug(zone->name, "unflushed changes, not unloading");
+			return KNOT_EOK;
+		}
+	}
+
+	size_t size = zone->contents->size;
+	zone_contents_t *unloaded = zone_switch_contents(zone, NULL);
+
+	synchronize_rcu();
+	knot_sem_wait(&zone->cow_lock);
+	zone_contents_deep_free(unloaded);
+	knot_sem_post(&zone->cow_lock);
+
+	zone->lazy.pending = false;
+
+	log_zone_info(zone->name, "unloaded, serial %u, %zu bytes", serial, size);
+
+	return KNOT_EOK;
+}
@@ -29,7 +29,7 @@ int event_nsec3resalt(conf_t *conf, zone_t *zone)
 		return ret;
 	}
 
-	ret = knot_dnssec_nsec3resalt(&kctx, &salt_changed, &next_resalt);
+	ret = knot_dnssec_nsec3resalt_shadow(&kctx, zone, &salt_changed, &next_resalt);
 	if (ret == KNOT_EOK && salt_changed != 0) {
 		zone_events_schedule_now(zone, ZONE_EVENT_DNSSEC);
 		zone->timers.last_resalt = kctx.now;
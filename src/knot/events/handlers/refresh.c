@@ -165,7 +165,7 @@ static int xfr_validate(zone_contents_t *zone)
 		.cb = err_handler_logger
 	};
 
-	ret = sem_checks_process(zone, SEMCHECK_MANDATORY_ONLY, &handler, time(NULL));
+	ret = sem_checks_process(zone, SEMCHECK_MANDATORY_ONLY, &handler, time(NULL), 1);
 	if (ret != KNOT_EOK) {
 		// error is logged by the error handler
 		return ret;
@@ -212,6 +212,14 @@ static int axfr_init(struct refresh_data *data)
 		return KNOT_ENOMEM;
 	}
 
+	if (conf_zone_cache(data->conf, data->zone->name).compact_nodes) {
+		int ret = zone_contents_arena_init(new_zone);
+		if (ret != KNOT_EOK) {
+			zone_contents_deep_free(new_zone);
+			return ret;
+		}
+	}
+
 	data->axfr.zone = new_zone;
 	return KNOT_EOK;
 }
@@ -227,8 +235,7 @@ static void axfr_slave_sign_serial(zone_contents_t *new_contents, zone_t *zone,
 {
 	// Update slave's serial to ensure it's growing and consistent with
 	// its serial policy.
-	conf_val_t val = conf_zone_get(conf, C_SERIAL_POLICY, zone->name);
-	unsigned serial_policy = conf_opt(&val);
+	unsigned serial_policy = conf_zone_cache(conf, zone->name).serial_policy;
 
 	*master_serial = zone_contents_serial(new_contents);
 
@@ -258,8 +265,7 @@ static int axfr_finalize(struct refresh_data *data)
 		return ret;
 	}
 
-	conf_val_t val = conf_zone_get(data->conf, C_DNSSEC_SIGNING, data->zone->name);
-	bool dnssec_enable = conf_bool(&val);
+	bool dnssec_enable = conf_zone_cache(data->conf, data->zone->name).dnssec_signing;
 	uint32_t old_serial = zone_contents_serial(data->zone->contents), master_serial = 0;
 	bool bootstrap = (data->zone->contents == NULL);
 
@@ -472,8 +478,7 @@ static int ixfr_slave_sign_serial(list_t *changesets, zone_t *zone,
 		return KNOT_ERROR;
 	}
 
-	conf_val_t val = conf_zone_get(conf, C_SERIAL_POLICY, zone->name);
-	unsigned serial_policy = conf_opt(&val);
+	unsigned serial_policy = conf_zone_cache(conf, zone->name).serial_policy;
 
 	int ret = zone_get_master_serial(zone, master_serial);
 	if (ret != KNOT_EOK) {
@@ -493,8 +498,7 @@ static int ixfr_slave_sign_serial(list_t *changesets, zone_t *zone,
 
 static int ixfr_finalize(struct refresh_data *data)
 {
-	conf_val_t val = conf_zone_get(data->conf, C_DNSSEC_SIGNING, data->zone->name);
-	bool dnssec_enable = conf_bool(&val);
+	bool dnssec_enable = conf_zone_cache(data->conf, data->zone->name).dnssec_signing;
 	uint32_t master_serial = 0, old_serial = zone_contents_serial(data->zone->contents);
 
 	if (dnssec_enable) {
@@ -1105,11 +1109,7 @@ static const knot_layer_api_t REFRESH_API = {
 
 static size_t max_zone_size(conf_t *conf, const knot_dname_t *zone)
 {
-	conf_val_t val = conf_zone_get(conf, C_ZONE_MAX_SIZE, zone);
-	if (val.code != KNOT_EOK) {
-		val = conf_zone_get(conf, C_MAX_ZONE_SIZE, zone);
-	}
-	return conf_int(&val);
+	return conf_zone_cache(conf, zone).zone_max_size;
 }
 
 typedef struct {
@@ -15,6 +15,7 @@
  */
 
 #include <assert.h>
+#include <pthread.h>
 
 #include "knot/events/handlers.h"
 #include "knot/nameserver/log.h"
@@ -25,13 +26,27 @@
 #include "knot/zone/zone.h"
 #include "libdnssec/random.h"
 #include "libknot/libknot.h"
+#include "contrib/macros.h"
 #include "contrib/net.h"
 #include "contrib/time.h"
 
+#define DDNS_BATCH_MIN 64        // Minimal number of updates processed at once.
+#define DDNS_BATCH_MAX 65536     // Maximal number of updates processed at once.
+#define DDNS_BATCH_TIME 500      // Aimed processing time of one batch in milliseconds.
+#define DDNS_BATCHES 4           // Maximal number of batches processed in one event.
+
 #define UPDATE_LOG(priority, qdata, fmt...) \
 	ns_log(priority, knot_pkt_qname(qdata->query), LOG_OPERATION_UPDATE, \
 	       LOG_DIRECTION_IN, (struct sockaddr *)qdata->params->remote, fmt)
 
+typedef struct {
+	conf_t *conf;
+	zone_t *zone;
+	list_t updates;
+	pthread_t thread;
+	bool running;
+} update_responder_t;
+
 static void init_qdata_from_request(knotd_qdata_t *qdata,
                                     const zone_t *zone,
                                     knot_request_t *req,
@@ -152,8 +167,8 @@ static int process_normal(conf_t *conf, zone_t *zone, list_t *requests)
 	}
 
 	// Sign update.
-	conf_val_t val = conf_zone_get(conf, C_DNSSEC_SIGNING, zone->name);
-	bool dnssec_enable = (up.flags & UPDATE_SIGN) && conf_bool(&val);
+	bool dnssec_enable = (up.flags & UPDATE_SIGN) &&
+	                     conf_zone_cache(conf, zone->name).dnssec_signing;
 	if (dnssec_enable) {
 		zone_sign_reschedule_t resch = { 0 };
 		ret = knot_dnssec_sign_update(&up, &resch);
@@ -340,15 +355,56 @@ static void free_request(knot_request_t *req)
 	free(req);
 }
 
-static void send_update_responses(conf_t *conf, const zone_t *zone, list_t *updates)
+static void send_update_responses(conf_t *conf, zone_t *zone, list_t *updates)
 {
+	uint64_t count = 0, latency = 0;
+
 	ptrnode_t *node, *nxt;
 	WALK_LIST_DELSAFE(node, nxt, *updates) {
 		knot_request_t *req = node->d;
 		send_update_response(conf, zone, req);
+
+		struct timespec now = time_now();
+		latency += time_diff_ms(&req->received, &now);
+		count++;
+
 		free_request(req);
 	}
 	ptrlist_free(updates, NULL);
+
+	pthread_mutex_lock(&zone->ddns_lock);
+	zone->ddns_processed += count;
+	zone->ddns_latency += latency;
+	pthread_mutex_unlock(&zone->ddns_lock);
+}
+
+static void *responder_thread(void *data)
+{
+	update_responder_t *responder = data;
+	send_update_responses(responder->conf, responder->zone, &responder->updates);
+	return NULL;
+}
+
+static void responder_wait(update_responder_t *responder)
+{
+	if (responder->running) {
+		pthread_join(responder->thread, NULL);
+		responder->running = false;
+	}
+}
+
+static void responder_start(update_responder_t *responder, list_t *updates)
+{
+	responder_wait(responder);
+
+	init_list(&responder->updates);
+	add_tail_list(&responder->updates, updates);
+
+	if (pthread_create(&responder->thread, NULL, responder_thread, responder) == 0) {
+		responder->running = true;
+	} else {
+		send_update_responses(responder->conf, responder->zone, &responder->updates);
+	}
 }
 
 static int init_update_responses(list_t *updates)
@@ -368,46 +424,52 @@ static int init_update_responses(list_t *updates)
 	return KNOT_EOK;
 }
 
-static size_t update_dequeue(zone_t *zone, list_t *updates)
+static size_t update_dequeue(zone_t *zone, list_t *updates, size_t max_count,
+                             size_t *remaining)
 {
 	assert(zone);
 	assert(updates);
 
+	init_list(updates);
+
 	pthread_mutex_lock(&zone->ddns_lock);
 
-	if (EMPTY_LIST(zone->ddns_queue)) {
-		/* Lost race during reload. */
-		pthread_mutex_unlock(&zone->ddns_lock);
-		return 0;
+	/* The queue may be empty after a lost race during reload. */
+	size_t update_count = 0;
+	ptrnode_t *node, *nxt;
+	WALK_LIST_DELSAFE(node, nxt, zone->ddns_queue) {
+		if (update_count == max_count) {
+			break;
+		}
+		rem_node(&node->n);
+		add_tail(updates, &node->n);
+		update_count++;
 	}
-
-	*updates = zone->ddns_queue;
-	size_t update_count = zone->ddns_queue_size;
-	init_list(&zone->ddns_queue);
-	zone->ddns_queue_size = 0;
+	zone->ddns_queue_size -= update_count;
+	*remaining = zone->ddns_queue_size;
 
 	pthread_mutex_unlock(&zone->ddns_lock);
 
 	return update_count;
 }
 
-int event_update(conf_t *conf, zone_t *zone)
+static void update_batch_adapt(zone_t *zone, size_t update_count, double duration_ms)
 {
-	assert(zone);
-
-	/* Get list of pending updates. */
-	list_t updates;
-	size_t update_count = update_dequeue(zone, &updates);
-	if (update_count == 0) {
-		return KNOT_EOK;
+	if (duration_ms > DDNS_BATCH_TIME) {
+		zone->ddns_batch = MAX(zone->ddns_batch / 2, DDNS_BATCH_MIN);
+	} else if (duration_ms < DDNS_BATCH_TIME / 2 && update_count == zone->ddns_batch) {
+		zone->ddns_batch = MIN(zone->ddns_batch * 2, DDNS_BATCH_MAX);
 	}
+}
 
+static int process_batch(conf_t *conf, zone_t *zone, list_t *updates,
+                         size_t update_count)
+{
 	/* Init updates respones. */
-	int ret = init_update_responses(&updates);
+	int ret = init_update_responses(updates);
 	if (ret != KNOT_EOK) {
 		/* Send what responses we can. */
-		set_rcodes(&updates, KNOT_RCODE_SERVFAIL);
-		send_update_responses(conf, zone, &updates);
+		set_rcodes(updates, KNOT_RCODE_SERVFAIL);
 		return ret;
 	}
 
@@ -416,15 +478,58 @@ int event_update(conf_t *conf, zone_t *zone)
 	if (zone_is_slave(conf, zone)) {
 		log_zone_info(zone->name,
 		              "DDNS, forwarding %zu updates", update_count);
-		forward_requests(conf, zone, &updates);
+		forward_requests(conf, zone, updates);
 	} else {
 		log_zone_info(zone->name,
 		              "DDNS, processing %zu updates", update_count);
-		process_requests(conf, zone, &updates);
+		process_requests(conf, zone, updates);
 	}
 
-	/* Send responses. */
-	send_update_responses(conf, zone, &updates);
-
 	return KNOT_EOK;
 }
+
+int event_update(conf_t *conf, zone_t *zone)
+{
+	assert(zone);
+
+	if (zone->ddns_batch == 0) {
+		zone->ddns_batch = DDNS_BATCH_MIN;
+	}
+
+	update_responder_t responder = {
+		.conf = conf,
+		.zone = zone,
+	};
+
+	/* Process the queue in batches, sending the responses of a processed
+	   batch while the next one is being processed. */
+	int ret = KNOT_EOK;
+	size_t remaining = 0;
+	for (int i = 0; i < DDNS_BATCHES; i++) {
+		list_t updates;
+		size_t update_count = update_dequeue(zone, &updates, zone->ddns_batch,
+		                                     &remaining);
+		if (update_count == 0) {
+			break;
+		}
+
+		struct timespec t_start = time_now();
+		ret = process_batch(conf, zone, &updates, update_count);
+		struct timespec t_end = time_now();
+		update_batch_adapt(zone, update_count, time_diff_ms(&t_start, &t_end));
+
+		/* Send responses. */
+		responder_start(&responder, &updates);
+		if (ret != KNOT_EOK || remaining == 0) {
+			break;
+		}
+	}
+	responder_wait(&responder);
+
+	/* Let other zone events run before the rest of the queue. */
+	if (remaining > 0) {
+		zone_events_schedule_now(zone, ZONE_EVENT_UPDATE);
+	}
+
+	return ret;
+}
@@ -71,8 +71,7 @@ static void replan_dnssec(conf_t *conf, zone_t *zone)
 	assert(conf);
 	assert(zone);
 
-	conf_val_t val = conf_zone_get(conf, C_DNSSEC_SIGNING, zone->name);
-	if (conf_bool(&val)) {
+	if (conf_zone_cache(conf, zone->name).dnssec_signing) {
 		zone_events_schedule_now(zone, ZONE_EVENT_DNSSEC);
 	}
 }
@@ -107,8 +106,7 @@ void replan_from_timers(conf_t *conf, zone_t *zone)
 
 	time_t flush = TIME_IGNORE;
 	if (!zone_is_slave(conf, zone) || can_expire(zone)) {
-		conf_val_t val = conf_zone_get(conf, C_ZONEFILE_SYNC, zone->name);
-		int64_t sync_timeout = conf_int(&val);
+		int64_t sync_timeout = conf_zone_cache(conf, zone->name).zonefile_sync;
 		if (sync_timeout > 0) {
 			flush = zone->timers.last_flush + sync_timeout;
 		}
@@ -64,8 +64,7 @@ bool journal_serial_to(knot_lmdb_txn_t *txn, bool zij, uint32_t serial,
 
 bool journal_allow_flush(zone_journal_t j)
 {
-	conf_val_t val = conf_zone_get(conf(), C_ZONEFILE_SYNC, j.zone);
-	return conf_int(&val) >= 0;
+	return conf_zone_cache(conf(), j.zone).zonefile_sync >= 0;
 }
 
 size_t journal_conf_max_usage(zone_journal_t j)
@@ -213,6 +213,18 @@ void knot_lmdb_close(knot_lmdb_db_t *db)
 	pthread_mutex_unlock(&db->opening_mutex);
 }
 
+int knot_lmdb_sync(knot_lmdb_db_t *db)
+{
+	int ret = KNOT_EOK;
+	pthread_mutex_lock(&db->opening_mutex);
+	if (db->env != NULL) {
+		ret = mdb_env_sync(db->env, 1);
+		err_to_knot(&ret);
+	}
+	pthread_mutex_unlock(&db->opening_mutex);
+	return ret;
+}
+
 static int lmdb_reinit(knot_lmdb_db_t *db, const char *path, size_t mapsize, unsigned env_flags)
 {
 #ifdef __OpenBSD__
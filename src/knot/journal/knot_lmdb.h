@@ -117,6 +117,17 @@ int knot_lmdb_open(knot_lmdb_db_t *db);
  */
 void knot_lmdb_close(knot_lmdb_db_t *db);
 
+/*!
+ * \brief Flush the committed data to disk.
+ *
+ * \note Useful if the DB was opened with MDB_NOSYNC.
+ *
+ * \param db   DB to be synced.
+ *
+ * \return KNOT_E*
+ */
+int knot_lmdb_sync(knot_lmdb_db_t *db);
+
 /*!
  * \brief Re-initialise existing DB with modified parameters.
  *
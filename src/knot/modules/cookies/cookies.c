@@ -20,19 +20,10 @@
 
 #include "knot/include/module.h"
 #include "libknot/libknot.h"
+#include "contrib/atomic.h"
 #include "contrib/string.h"
 #include "libdnssec/random.h"
 
-#ifdef HAVE_ATOMIC
-#define ATOMIC_SET(dst, val) __atomic_store_n(&(dst), (val), __ATOMIC_RELAXED)
-#define ATOMIC_GET(src)      __atomic_load_n(&(src), __ATOMIC_RELAXED)
-#define ATOMIC_ADD(dst, val) __atomic_add_fetch(&(dst), (val), __ATOMIC_RELAXED)
-#else
-#define ATOMIC_SET(dst, val) ((dst) = (val))
-#define ATOMIC_GET(src)      (src)
-#define ATOMIC_ADD(dst, val) ((dst) += (val))
-#endif
-
 #define BADCOOKIE_CTR_INIT	1
 
 #define MOD_SECRET_LIFETIME "\x0F""secret-lifetime"
@@ -586,14 +586,14 @@ static int answer_query(knot_pkt_t *pkt, knotd_qdata_t *qdata)
 {
 	int state = KNOTD_IN_STATE_BEGIN;
 	struct query_plan *plan = qdata->extra->zone->query_plan;
-	struct query_step *step;
+	struct query_hook *hook;
 
 	bool with_dnssec = have_dnssec(qdata);
 
 	/* Resolve PREANSWER. */
 	if (plan != NULL) {
-		WALK_LIST(step, plan->stage[KNOTD_STAGE_PREANSWER]) {
-			SOLVE_STEP(step->process, state, step->ctx);
+		QUERY_PLAN_FOREACH(plan, KNOTD_STAGE_PREANSWER, hook) {
+			SOLVE_STEP(hook->process, state, hook->ctx);
 		}
 	}
 
@@ -604,8 +604,8 @@ static int answer_query(knot_pkt_t *pkt, knotd_qdata_t *qdata)
 		SOLVE_STEP(solve_answer_dnssec, state, NULL);
 	}
 	if (plan != NULL) {
-		WALK_LIST(step, plan->stage[KNOTD_STAGE_ANSWER]) {
-			SOLVE_STEP(step->process, state, step->ctx);
+		QUERY_PLAN_FOREACH(plan, KNOTD_STAGE_ANSWER, hook) {
+			SOLVE_STEP(hook->process, state, hook->ctx);
 		}
 	}
 
@@ -616,8 +616,8 @@ static int answer_query(knot_pkt_t *pkt, knotd_qdata_t *qdata)
 		SOLVE_STEP(solve_authority_dnssec, state, NULL);
 	}
 	if (plan != NULL) {
-		WALK_LIST(step, plan->stage[KNOTD_STAGE_AUTHORITY]) {
-			SOLVE_STEP(step->process, state, step->ctx);
+		QUERY_PLAN_FOREACH(plan, KNOTD_STAGE_AUTHORITY, hook) {
+			SOLVE_STEP(hook->process, state, hook->ctx);
 		}
 	}
 
@@ -628,8 +628,8 @@ static int answer_query(knot_pkt_t *pkt, knotd_qdata_t *qdata)
 		SOLVE_STEP(solve_additional_dnssec, state, NULL);
 	}
 	if (plan != NULL) {
-		WALK_LIST(step, plan->stage[KNOTD_STAGE_ADDITIONAL]) {
-			SOLVE_STEP(step->process, state, step->ctx);
+		QUERY_PLAN_FOREACH(plan, KNOTD_STAGE_ADDITIONAL, hook) {
+			SOLVE_STEP(hook->process, state, hook->ctx);
 		}
 	}
 
@@ -430,6 +430,9 @@ static int prepare_answer(knot_pkt_t *query, knot_pkt_t *resp, knot_layer_t *ctx
 	if (qdata->extra->zone != NULL && qdata->extra->contents == NULL) {
 		qdata->extra->contents = qdata->extra->zone->contents;
 	}
+	if (qdata->extra->zone != NULL && qdata->extra->zone->lazy.enabled) {
+		zone_lazy_touch((zone_t *)qdata->extra->zone);
+	}
 
 	/* Allow normal queries to catalog only over TCP and if allowed by ACL. */
 	if (qdata->extra->zone != NULL && qdata->extra->zone->is_catalog_flag &&
@@ -507,20 +510,20 @@ static int process_query_err(knot_layer_t *ctx, knot_pkt_t *pkt)
 	return KNOT_STATE_DONE;
 }
 
-#define PROCESS_BEGIN(plan, step, next_state, qdata) \
+#define PROCESS_BEGIN(plan, hook, next_state, qdata) \
 	if (plan != NULL) { \
-		WALK_LIST(step, plan->stage[KNOTD_STAGE_BEGIN]) { \
-			next_state = step->process(next_state, pkt, qdata, step->ctx); \
+		QUERY_PLAN_FOREACH(plan, KNOTD_STAGE_BEGIN, hook) { \
+			next_state = hook->process(next_state, pkt, qdata, hook->ctx); \
 			if (next_state == KNOT_STATE_FAIL) { \
 				goto finish; \
 			} \
 		} \
 	}
 
-#define PROCESS_END(plan, step, next_state, qdata) \
+#define PROCESS_END(plan, hook, next_state, qdata) \
 	if (plan != NULL) { \
-		WALK_LIST(step, plan->stage[KNOTD_STAGE_END]) { \
-			next_state = step->process(next_state, pkt, qdata, step->ctx); \
+		QUERY_PLAN_FOREACH(plan, KNOTD_STAGE_END, hook) { \
+			next_state = hook->process(next_state, pkt, qdata, hook->ctx); \
 			if (next_state == KNOT_STATE_FAIL) { \
 				next_state = process_query_err(ctx, pkt); \
 			} \
@@ -536,7 +539,7 @@ static int process_query_out(knot_layer_t *ctx, knot_pkt_t *pkt)
 	knotd_qdata_t *qdata = QUERY_DATA(ctx);
 	struct query_plan *plan = conf()->query_plan;
 	struct query_plan *zone_plan = NULL;
-	struct query_step *step;
+	struct query_hook *hook;
 
 	int next_state = KNOT_STATE_PRODUCE;
 
@@ -559,8 +562,8 @@ static int process_query_out(knot_layer_t *ctx, knot_pkt_t *pkt)
 	}
 
 	/* Before query processing code. */
-	PROCESS_BEGIN(plan, step, next_state, qdata);
-	PROCESS_BEGIN(zone_plan, step, next_state, qdata);
+	PROCESS_BEGIN(plan, hook, next_state, qdata);
+	PROCESS_BEGIN(zone_plan, hook, next_state, qdata);
 
 	/* Answer based on qclass. */
 	if (next_state == KNOT_STATE_PRODUCE) {
@@ -620,8 +623,8 @@ finish:
 	}
 
 	/* After query processing code. */
-	PROCESS_END(plan, step, next_state, qdata);
-	PROCESS_END(zone_plan, step, next_state, qdata);
+	PROCESS_END(plan, hook, next_state, qdata);
+	PROCESS_END(zone_plan, hook, next_state, qdata);
 
 	rcu_read_unlock();
 
@@ -30,15 +30,8 @@
 #include "knot/nameserver/query_module.h"
 #include "knot/nameserver/process_query.h"
 
-#ifdef HAVE_ATOMIC
- #define ATOMIC_ADD(dst, val) __atomic_add_fetch(&(dst), (val), __ATOMIC_RELAXED)
- #define ATOMIC_SUB(dst, val) __atomic_sub_fetch(&(dst), (val), __ATOMIC_RELAXED)
- #define ATOMIC_SET(dst, val) __atomic_store_n(&(dst), (val), __ATOMIC_RELAXED)
-#else
+#ifndef HAVE_ATOMIC
  #warning "Statistics data can be inaccurate"
- #define ATOMIC_ADD(dst, val) ((dst) += (val))
- #define ATOMIC_SUB(dst, val) ((dst) -= (val))
- #define ATOMIC_SET(dst, val) ((dst) = (val))
 #endif
 
 _public_
@@ -56,7 +49,10 @@ struct query_plan *query_plan_create(void)
 
 	for (unsigned i = 0; i < KNOTD_STAGES; ++i) {
 		init_list(&plan->stage[i]);
+		plan->hooks[i] = NULL;
 	}
+	plan->compiled = NULL;
+	plan->steps = 0;
 
 	return plan;
 }
@@ -74,6 +70,7 @@ void query_plan_free(struct query_plan *plan)
 		}
 	}
 
+	free(plan->compiled);
 	free(plan);
 }
 
@@ -98,11 +95,54 @@ int query_plan_step(struct query_plan *plan, knotd_stage_t stage,
 		return KNOT_ENOMEM;
 	}
 
+	// Reserve the hooks including all terminators, so the compilation cannot fail.
+	struct query_hook *compiled = realloc(plan->compiled,
+	        (plan->steps + 1 + KNOTD_STAGES) * sizeof(*compiled));
+	if (compiled == NULL) {
+		free(step);
+		return KNOT_ENOMEM;
+	}
+	plan->compiled = compiled;
+	plan->steps++;
+
 	add_tail(&plan->stage[stage], &step->node);
 
 	return KNOT_EOK;
 }
 
+int query_plan_compile(struct query_plan *plan)
+{
+	if (plan == NULL) {
+		return KNOT_EINVAL;
+	}
+
+	struct query_hook *compiled = plan->compiled;
+	if (compiled != NULL) {
+		memset(compiled, 0, (plan->steps + KNOTD_STAGES) * sizeof(*compiled));
+	}
+
+	struct query_hook *hook = compiled;
+	for (unsigned i = 0; i < KNOTD_STAGES; ++i) {
+		if (EMPTY_LIST(plan->stage[i])) {
+			plan->hooks[i] = NULL;
+			continue;
+		}
+
+		plan->hooks[i] = hook;
+
+		struct query_step *step;
+		WALK_LIST(step, plan->stage[i]) {
+			hook->process = step->process;
+			hook->ctx = step->ctx;
+			hook++;
+		}
+		hook++; // Terminator.
+	}
+	assert(hook <= compiled + plan->steps + KNOTD_STAGES);
+
+	return KNOT_EOK;
+}
+
 _public_
 int knotd_mod_hook(knotd_mod_t *mod, knotd_stage_t stage, knotd_mod_hook_f hook)
 {
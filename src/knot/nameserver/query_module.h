@@ -22,14 +22,9 @@
 #include "knot/dnssec/zone-keys.h"
 #include "knot/include/module.h"
 #include "knot/server/server.h"
+#include "contrib/atomic.h"
 #include "contrib/ucw/lists.h"
 
-#ifdef HAVE_ATOMIC
- #define ATOMIC_GET(src) __atomic_load_n(&(src), __ATOMIC_RELAXED)
-#else
- #define ATOMIC_GET(src) (src)
-#endif
-
 #define KNOTD_STAGES (KNOTD_STAGE_END + 1)
 
 typedef unsigned (*query_step_process_f)
@@ -42,14 +37,31 @@ struct query_step {
 	query_step_process_f process;
 };
 
+/*! \brief Compiled processing step. */
+struct query_hook {
+	query_step_process_f process;
+	void *ctx;
+};
+
 /*! Query plan represents a sequence of steps needed for query processing
  *  divided into several stages, where each stage represents a current response
  *  assembly phase, for example 'before processing', 'answer section' and so on.
+ *
+ *  The planned steps are compiled into flat arrays of hooks terminated with
+ *  an empty hook, which are used for the query processing. Empty stages have
+ *  no hooks array.
  */
 struct query_plan {
 	list_t stage[KNOTD_STAGES];
+	struct query_hook *hooks[KNOTD_STAGES];
+	struct query_hook *compiled;
+	size_t steps;
 };
 
+/*! \brief Iterate over the compiled hooks of the plan stage. */
+#define QUERY_PLAN_FOREACH(plan, stage_id, hook) \
+	for (hook = (plan)->hooks[stage_id]; hook != NULL && hook->process != NULL; hook++)
+
 /*! \brief Create an empty query plan. */
 struct query_plan *query_plan_create(void);
 
@@ -60,6 +72,14 @@ void query_plan_free(struct query_plan *plan);
 int query_plan_step(struct query_plan *plan, knotd_stage_t stage,
                     query_step_process_f process, void *ctx);
 
+/*!
+ * \brief Compile the planned steps into the hooks arrays.
+ *
+ * \note The hooks are reserved when the steps are planned, so the compilation
+ *       of a valid plan doesn't fail.
+ */
+int query_plan_compile(struct query_plan *plan);
+
 /*! \brief Open query module identified by name. */
 knotd_mod_t *query_module_open(conf_t *conf, server_t *server, conf_mod_id_t *mod_id,
                                struct query_plan *plan, const knot_dname_t *zone);
@@ -21,6 +21,7 @@
 #include "knot/nameserver/update.h"
 #include "knot/query/requestor.h"
 #include "libknot/libknot.h"
+#include "contrib/time.h"
 
 static int update_enqueue(zone_t *zone, knotd_qdata_t *qdata)
 {
@@ -36,6 +37,7 @@ static int update_enqueue(zone_t *zone, knotd_qdata_t *qdata)
 	/* Store socket and remote address. */
 	req->fd = dup(qdata->params->socket);
 	memcpy(&req->remote, qdata->params->remote, sizeof(req->remote));
+	req->received = time_now();
 
 	/* Store update request. */
 	req->query = knot_pkt_new(NULL, qdata->query->max_size, NULL);
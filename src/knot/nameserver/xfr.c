@@ -34,6 +34,12 @@ int xfr_process_list(knot_pkt_t *pkt, xfr_put_cb put, knotd_qdata_t *qdata)
 	}
 	knot_rrset_t soa_rr = node_rrset(contents->apex, KNOT_RRTYPE_SOA);
 
+	/* Compress all names as much as possible in the transfer messages. */
+	ret = knot_pkt_init_compr_table(pkt);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
 	/* Prepend SOA on first packet. */
 	if (xfer->stats.messages == 0) {
 		ret = knot_pkt_put(pkt, 0, &soa_rr, KNOT_PF_NOTRUNC);
@@ -51,6 +51,7 @@ typedef struct {
 	tsig_ctx_t tsig;
 
 	knot_sign_context_t sign; /*!< Required for async. DDNS processing. */
+	struct timespec received; /*!< Required for async. DDNS processing. */
 } knot_request_t;
 
 /*!
@@ -18,6 +18,7 @@
 
 #include <assert.h>
 #include <sys/resource.h>
+#include <urcu.h>
 
 #include "libknot/libknot.h"
 #include "libknot/yparser/ypschema.h"
@@ -54,6 +55,9 @@ enum {
 	TCP_MIN_SNDSIZE = sizeof(uint16_t) + UINT16_MAX
 };
 
+/*! \brief Interval of checking the size of lazily loaded zones (seconds). */
+#define LAZY_UNLOAD_PERIOD 10
+
 /*! \brief Unbind interface and clear the structure. */
 static void server_deinit_iface(iface_t *iface, bool dealloc)
 {
@@ -564,6 +568,117 @@ static int configure_sockets(conf_t *conf, server_t *s)
 	return KNOT_EOK;
 }
 
+static void job_dispatch(event_t *event)
+{
+	server_job_t *job = event->data;
+	server_t *server = job->task.ctx;
+
+	// If still running, the task plans itself when finished.
+	pthread_mutex_lock(&job->lock);
+	if (!job->running) {
+		job->running = true;
+		worker_pool_assign(server->workers, &job->task);
+	}
+	pthread_mutex_unlock(&job->lock);
+}
+
+static void job_finish(server_job_t *job, uint32_t period)
+{
+	pthread_mutex_lock(&job->lock);
+	job->running = false;
+	pthread_mutex_unlock(&job->lock);
+
+	if (period > 0) {
+		evsched_schedule(job->event, period * 1000);
+	}
+}
+
+static void job_replan(server_job_t *job, uint32_t period)
+{
+	if (period > 0) {
+		evsched_schedule(job->event, period * 1000);
+	} else {
+		evsched_cancel(job->event);
+	}
+}
+
+static int job_init(server_t *server, server_job_t *job, task_cb run)
+{
+	job->event = evsched_event_create(&server->sched, job_dispatch, job);
+	if (job->event == NULL) {
+		return KNOT_ENOMEM;
+	}
+	job->task.ctx = server;
+	job->task.run = run;
+	pthread_mutex_init(&job->lock, NULL);
+
+	return KNOT_EOK;
+}
+
+static void job_deinit(server_job_t *job)
+{
+	if (job->event == NULL) {
+		return;
+	}
+
+	evsched_cancel(job->event);
+	evsched_event_free(job->event);
+	pthread_mutex_destroy(&job->lock);
+}
+
+static uint32_t timers_sync_period(conf_t *conf)
+{
+	conf_val_t val = conf_db_param(conf, C_TIMER_DB_SYNC, NULL);
+	return conf_int(&val);
+}
+
+static void timers_sync_run(task_t *task)
+{
+	server_t *server = task->ctx;
+
+	rcu_read_lock();
+	if (server->zone_db != NULL) {
+		size_t written = 0;
+		int ret = zone_timers_write_changed(&server->timerdb,
+		                                    server->zone_db, &written);
+		if (ret != KNOT_EOK) {
+			log_warning("failed to update persistent timer DB (%s)",
+			            knot_strerror(ret));
+		} else if (written > 0) {
+			log_debug("updated persistent timers of %zu zones", written);
+		}
+	}
+	uint32_t period = timers_sync_period(conf());
+	rcu_read_unlock();
+
+	job_finish(&server->timers_sync, period);
+}
+
+static uint32_t lazy_unload_period(conf_t *conf)
+{
+	conf_val_t val = conf_get(conf, C_SRV, C_LAZY_LOAD_LIMIT);
+	return conf_int(&val) > 0 ? LAZY_UNLOAD_PERIOD : 0;
+}
+
+static void lazy_unload_run(task_t *task)
+{
+	server_t *server = task->ctx;
+
+	rcu_read_lock();
+	conf_val_t val = conf_get(conf(), C_SRV, C_LAZY_LOAD_LIMIT);
+	size_t limit = conf_int(&val);
+	if (server->zone_db != NULL && limit > 0) {
+		size_t unloaded = zonedb_lazy_unload(server->zone_db, limit);
+		if (unloaded > 0) {
+			log_debug("unloading %zu idle zones", unloaded);
+		}
+	}
+	uint32_t period = lazy_unload_period(conf());
+	rcu_read_unlock();
+
+	job_finish(&server->lazy_unload, period);
+}
+
 int server_init(server_t *server, int bg_workers)
 {
 	if (server == NULL) {
@@ -584,13 +699,24 @@ int server_init(server_t *server, int bg_workers)
 		return KNOT_ENOMEM;
 	}
 
-	int ret = catalog_update_init(&server->catalog_upd);
+	/* Initialize periodic jobs. */
+	int ret = job_init(server, &server->timers_sync, timers_sync_run);
+	if (ret == KNOT_EOK) {
+		ret = job_init(server, &server->lazy_unload, lazy_unload_run);
+	}
+	if (ret == KNOT_EOK) {
+		ret = catalog_update_init(&server->catalog_upd);
+	}
 	if (ret != KNOT_EOK) {
+		job_deinit(&server->lazy_unload);
+		job_deinit(&server->timers_sync);
 		worker_pool_destroy(server->workers);
 		evsched_deinit(&server->sched);
 		return ret;
 	}
 
+	pthread_mutex_init(&server->ctl_lock, NULL);
+
 	char *catalog_dir = conf_db(conf(), C_CATALOG_DB);
 	conf_val_t catalog_size = conf_db_param(conf(), C_CATALOG_DB_MAX_SIZE, NULL);
 	catalog_init(&server->catalog, catalog_dir, conf_int(&catalog_size));
@@ -638,6 +764,10 @@ void server_deinit(server_t *server)
 	/* Free zone database. */
 	knot_zonedb_deep_free(&server->zone_db, true);
 
+	/* Free the periodic jobs. */
+	job_deinit(&server->lazy_unload);
+	job_deinit(&server->timers_sync);
+
 	/* Free remaining events. */
 	evsched_deinit(&server->sched);
 
@@ -645,6 +775,8 @@ void server_deinit(server_t *server)
 	catalog_update_deinit(&server->catalog_upd);
 	catalog_deinit(&server->catalog);
 
+	pthread_mutex_destroy(&server->ctl_lock);
+
 	/* Close persistent timers DB. */
 	knot_lmdb_deinit(&server->timerdb);
 
@@ -963,6 +1095,9 @@ int server_reload(server_t *server)
 		if (conf()->io.zones != NULL) {
 			trie_clear(conf()->io.zones);
 		}
+		if (conf()->io.refs != NULL) {
+			trie_clear(conf()->io.refs);
+		}
 	}
 
 	return KNOT_EOK;
@@ -1045,6 +1180,9 @@ static int reconfigure_timer_db(conf_t *conf, server_t *server)
 	conf_val_t timer_size = conf_db_param(conf, C_TIMER_DB_MAX_SIZE, C_MAX_TIMER_DB_SIZE);
 	int ret = knot_lmdb_reconfigure(&server->timerdb, timer_dir, conf_int(&timer_size), 0);
 	free(timer_dir);
+
+	job_replan(&server->timers_sync, timers_sync_period(conf));
+
 	return ret;
 }
 
@@ -1099,6 +1237,9 @@ int server_reconfigure(conf_t *conf, server_t *server)
 		          knot_strerror(ret));
 	}
 
+	/* Reconfigure unloading of idle zones. */
+	job_replan(&server->lazy_unload, lazy_unload_period(conf));
+
 	return KNOT_EOK;
 }
 
@@ -1129,3 +1270,18 @@ void server_update_zones(conf_t *conf, server_t *server)
 		knot_zonedb_foreach(server->zone_db, zone_events_start);
 	}
 }
+
+void server_update_catalog(conf_t *conf, server_t *server)
+{
+	if (conf == NULL || server == NULL) {
+		return;
+	}
+
+	int ret = zonedb_update_catalog(conf, server);
+	if (ret != KNOT_EOK) {
+		server_update_zones(conf, server);
+	} else {
+		/* Trim extra heap. */
+		mem_trim();
+	}
+}
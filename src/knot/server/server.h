@@ -70,6 +70,18 @@ enum {
 	IO_XDP = 2,
 };
 
+/*!
+ * \brief Periodic background job of the server.
+ *
+ * The job is run by the background workers, at most one instance at a time.
+ */
+typedef struct {
+	event_t *event;
+	task_t task;
+	pthread_mutex_t lock;
+	bool running;
+} server_job_t;
+
 /*!
  * \brief Main server structure.
  *
@@ -103,6 +115,15 @@ typedef struct server {
 
 	/*! \brief Pending changes to catalog member zones. */
 	catalog_update_t catalog_upd;
+
+	/*! \brief Periodic write of changed zone timers. */
+	server_job_t timers_sync;
+
+	/*! \brief Periodic unload of idle lazily loaded zones. */
+	server_job_t lazy_unload;
+
+	/*! \brief Serializes modifying control commands and server reloads. */
+	pthread_mutex_t ctl_lock;
 } server_t;
 
 /*!
@@ -171,3 +192,10 @@ int server_reconfigure(conf_t *conf, server_t *server);
  * Routine for dynamic server zones reconfiguration.
  */
 void server_update_zones(conf_t *conf, server_t *server);
+
+/*!
+ * \brief Apply catalog member changes to the zone database.
+ *
+ * Falls back to full zones reconfiguration if the incremental update fails.
+ */
+void server_update_catalog(conf_t *conf, server_t *server);
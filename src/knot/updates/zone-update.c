@@ -652,14 +652,12 @@ int zone_update_increment_soa(zone_update_t *update, conf_t *conf)
 		return KNOT_EINVAL;
 	}
 
-	conf_val_t val = conf_zone_get(conf, C_SERIAL_POLICY, update->zone->name);
-	return set_new_soa(update, conf_opt(&val));
+	return set_new_soa(update, conf_zone_cache(conf, update->zone->name).serial_policy);
 }
 
 static int commit_journal(conf_t *conf, zone_update_t *update)
 {
-	conf_val_t val = conf_zone_get(conf, C_JOURNAL_CONTENT, update->zone->name);
-	unsigned content = conf_opt(&val);
+	unsigned content = conf_zone_cache(conf, update->zone->name).journal_content;
 	int ret = KNOT_EOK;
 	if ((update->flags & UPDATE_INCREMENTAL) ||
 	    (update->flags & UPDATE_HYBRID)) {
@@ -835,30 +833,35 @@ int zone_update_commit(conf_t *conf, zone_update_t *update)
 		return ret;
 	}
 
-	conf_val_t thr = conf_zone_get(conf, C_ADJUST_THR, update->zone->name);
+	conf_zone_cache_t zcache = conf_zone_cache(conf, update->zone->name);
 	if ((update->flags & (UPDATE_HYBRID | UPDATE_FULL))) {
-		ret = zone_adjust_full(update->new_cont, conf_int(&thr));
+		ret = zone_adjust_full(update->new_cont, zcache.adjust_threads);
 	} else {
-		ret = zone_adjust_incremental_update(update, conf_int(&thr));
+		ret = zone_adjust_incremental_update(update, zcache.adjust_threads);
 	}
 	if (ret != KNOT_EOK) {
 		discard_adds_tree(update);
 		return ret;
 	}
 
-	/* Check the zone size. */
-	conf_val_t val = conf_zone_get(conf, C_ZONE_MAX_SIZE, update->zone->name);
-	if (val.code != KNOT_EOK) {
-		val = conf_zone_get(conf, C_MAX_ZONE_SIZE, update->zone->name);
+	/* Compact the freshly loaded nodes. */
+	if ((update->flags & UPDATE_FULL) && zcache.compact_nodes) {
+		ret = zone_contents_compact(update->new_cont);
+		if (ret != KNOT_EOK) {
+			discard_adds_tree(update);
+			return ret;
+		}
 	}
-	size_t size_limit = conf_int(&val);
+
+	/* Check the zone size. */
+	size_t size_limit = zcache.zone_max_size;
 
 	if (update->new_cont->size > size_limit) {
 		discard_adds_tree(update);
 		return KNOT_EZONESIZE;
 	}
 
-	val = conf_zone_get(conf, C_DNSSEC_VALIDATION, update->zone->name);
+	conf_val_t val = conf_zone_get(conf, C_DNSSEC_VALIDATION, update->zone->name);
 	if (conf_bool(&val)) {
 		bool incr_valid = update->flags & UPDATE_INCREMENTAL;
 		const char *msg_valid = incr_valid ? "incremental " : "";
@@ -888,8 +891,7 @@ int zone_update_commit(conf_t *conf, zone_update_t *update)
 
 	/* Check if the zone was re-signed upon zone load to ensure proper flush
 	 * even if the SOA serial wasn't incremented by re-signing. */
-	val = conf_zone_get(conf, C_DNSSEC_SIGNING, update->zone->name);
-	bool dnssec = conf_bool(&val);
+	bool dnssec = zcache.dnssec_signing;
 
 	if (dnssec) {
 		update->zone->zonefile.resigned = true;
@@ -939,8 +941,7 @@ int zone_update_commit(conf_t *conf, zone_update_t *update)
 	}
 
 	/* Sync zonefile immediately if configured. */
-	val = conf_zone_get(conf, C_ZONEFILE_SYNC, update->zone->name);
-	if (conf_int(&val) == 0) {
+	if (zcache.zonefile_sync == 0) {
 		zone_events_schedule_now(update->zone, ZONE_EVENT_FLUSH);
 	}
 
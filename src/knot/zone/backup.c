@@ -33,6 +33,7 @@
 #include "libdnssec/error.h"
 #include "contrib/files.h"
 #include "contrib/string.h"
+#include "contrib/time.h"
 
 static void _backup_swap(zone_backup_ctx_t *ctx, void **local, void **remote)
 {
@@ -67,6 +68,9 @@ int zone_backup_init(bool restore_mode, const char *backup_dir,
 	ctx->restore_mode = restore_mode;
 	ctx->backup_global = false;
 	ctx->readers = 1;
+	ctx->zones_done = 0;
+	ctx->zones_failed = 0;
+	ctx->init_time = time_now();
 	ctx->backup_dir = (char *)(ctx + 1);
 	memcpy(ctx->backup_dir, backup_dir, backup_dir_len);
 
@@ -93,23 +97,53 @@ int zone_backup_init(bool restore_mode, const char *backup_dir,
 		}
 	}
 
+	// Zones are backed up in parallel, each in its own transactions. Avoid
+	// syncing the backup DBs on every commit, they are synced once when done.
+	unsigned flags = restore_mode ? 0 : MDB_NOSYNC;
+
 	char db_dir[backup_dir_len + 16];
 	(void)snprintf(db_dir, sizeof(db_dir), "%s/keys", backup_dir);
-	knot_lmdb_init(&ctx->bck_kasp_db, db_dir, kasp_db_size, 0, "keys_db");
+	knot_lmdb_init(&ctx->bck_kasp_db, db_dir, kasp_db_size, flags, "keys_db");
 
 	(void)snprintf(db_dir, sizeof(db_dir), "%s/timers", backup_dir);
-	knot_lmdb_init(&ctx->bck_timer_db, db_dir, timer_db_size, 0, NULL);
+	knot_lmdb_init(&ctx->bck_timer_db, db_dir, timer_db_size, flags, NULL);
 
 	(void)snprintf(db_dir, sizeof(db_dir), "%s/journal", backup_dir);
-	knot_lmdb_init(&ctx->bck_journal, db_dir, journal_db_size, 0, NULL);
+	knot_lmdb_init(&ctx->bck_journal, db_dir, journal_db_size, flags, NULL);
 
 	(void)snprintf(db_dir, sizeof(db_dir), "%s/catalog", backup_dir);
-	knot_lmdb_init(&ctx->bck_catalog, db_dir, catalog_db_size, 0, NULL);
+	knot_lmdb_init(&ctx->bck_catalog, db_dir, catalog_db_size, flags, NULL);
 
 	*out_ctx = ctx;
 	return KNOT_EOK;
 }
 
+static void backup_finish(zone_backup_ctx_t *ctx)
+{
+	int ret = KNOT_EOK;
+	if (!ctx->restore_mode) {
+		knot_lmdb_db_t *dbs[] = { &ctx->bck_kasp_db, &ctx->bck_timer_db,
+		                          &ctx->bck_journal, &ctx->bck_catalog };
+		for (size_t i = 0; i < sizeof(dbs) / sizeof(*dbs) && ret == KNOT_EOK; i++) {
+			ret = knot_lmdb_sync(dbs[i]);
+		}
+	}
+
+	struct timespec now = time_now();
+	double seconds = time_diff_ms(&ctx->init_time, &now) / 1000.0;
+	const char *what = ctx->restore_mode ? "restore from" : "backup to";
+
+	if (ret != KNOT_EOK) {
+		log_error("%s '%s' failed to sync databases (%s)",
+		          what, ctx->backup_dir, knot_strerror(ret));
+	} else if (ctx->zones_done > 0) {
+		log_info("%s '%s' finished, zones %zu, failed %zu, "
+		         "time %.2f seconds, %.0f zones/s",
+		         what, ctx->backup_dir, ctx->zones_done, ctx->zones_failed,
+		         seconds, seconds > 0 ? ctx->zones_done / seconds : 0);
+	}
+}
+
 void zone_backup_deinit(zone_backup_ctx_t *ctx)
 {
 	if (ctx == NULL) {
@@ -122,6 +156,8 @@ void zone_backup_deinit(zone_backup_ctx_t *ctx)
 	pthread_mutex_unlock(&ctx->readers_mutex);
 
 	if (left == 1) {
+		backup_finish(ctx);
+
 		knot_lmdb_deinit(&ctx->bck_catalog);
 		knot_lmdb_deinit(&ctx->bck_journal);
 		knot_lmdb_deinit(&ctx->bck_timer_db);
@@ -316,6 +352,13 @@ int zone_backup(conf_t *conf, zone_t *zone)
 	}
 
 done:
+	pthread_mutex_lock(&ctx->readers_mutex);
+	ctx->zones_done++;
+	if (ret != KNOT_EOK) {
+		ctx->zones_failed++;
+	}
+	pthread_mutex_unlock(&ctx->readers_mutex);
+
 	zone_backup_deinit(ctx);
 	zone->backup_ctx = NULL;
 	return ret;
@@ -18,6 +18,7 @@
 
 #include <pthread.h>
 #include <stdint.h>
+#include <time.h>
 
 #include "knot/dnssec/kasp/kasp_db.h"
 #include "knot/zone/zone.h"
@@ -28,7 +29,10 @@ typedef struct zone_backup_ctx {
 	bool backup_zonefile;               // if true, also backup zone contents to a zonefile (default on)
 	bool backup_global;                 // perform global backup for all zones
 	ssize_t readers;                    // when decremented to 0, all zones done, free this context
-	pthread_mutex_t readers_mutex;      // mutex covering readers counter
+	pthread_mutex_t readers_mutex;      // mutex covering readers and zones counters
+	size_t zones_done;                  // number of processed zones
+	size_t zones_failed;                // number of zones whose backup/restore failed
+	struct timespec init_time;          // start of the backup/restore
 	char *backup_dir;                   // path of directory to backup to / restore from
 	knot_lmdb_db_t bck_kasp_db;         // backup KASP db
 	knot_lmdb_db_t bck_timer_db;        // backup timer DB
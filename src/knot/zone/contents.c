@@ -23,8 +23,43 @@
 #include "knot/common/log.h"
 #include "knot/dnssec/zone-nsec.h"
 #include "libknot/libknot.h"
+#include "contrib/atomic.h"
+#include "contrib/mempattern.h"
 #include "contrib/qp-trie/trie.h"
 #include "contrib/macros.h"
+#include "contrib/ucw/mempool.h"
+
+#define ARENA_CHUNK_SIZE (64 * 1024)
+
+struct zone_arena {
+	knot_mm_t mm;
+	knot_refcnt_t refs;
+	bool closed; // no more allocations, the nodes may be shared
+};
+
+static struct zone_arena *arena_ref(struct zone_arena *arena)
+{
+	if (arena != NULL) {
+		arena->closed = true;
+		knot_refcnt_inc(&arena->refs);
+	}
+	return arena;
+}
+
+static void arena_unref(struct zone_arena *arena)
+{
+	if (arena != NULL && knot_refcnt_dec(&arena->refs)) {
+		knot_refcnt_deinit(&arena->refs);
+		mp_delete(arena->mm.ctx);
+		free(arena);
+	}
+}
+
+static knot_mm_t *arena_mm(const zone_contents_t *contents)
+{
+	struct zone_arena *arena = contents->arena;
+	return (arena != NULL && !arena->closed) ? &arena->mm : NULL;
+}
 
 /*!
  * \brief Destroys all RRSets in a node.
@@ -89,7 +124,16 @@ static bool find_in_tree(zone_tree_t *tree, const knot_dname_t *name,
 static zone_node_t *node_new_for_contents(const knot_dname_t *owner, const zone_contents_t *contents)
 {
 	assert(contents->nsec3_nodes == NULL || contents->nsec3_nodes->flags == contents->nodes->flags);
-	return node_new_for_tree(owner, contents->nodes, NULL);
+	knot_mm_t *mm = arena_mm(contents);
+	zone_node_t *node = node_new_for_tree(owner, contents->nodes, mm);
+	if (node != NULL && mm != NULL) {
+		node->flags |= NODE_FLAGS_ARENA;
+		zone_node_t *counter = binode_counterpart(node);
+		if (counter != NULL) {
+			counter->flags |= NODE_FLAGS_ARENA;
+		}
+	}
+	return node;
 }
 
 static zone_node_t *get_node(const zone_contents_t *zone, const knot_dname_t *name)
@@ -218,6 +262,28 @@ cleanup:
 	return NULL;
 }
 
+int zone_contents_arena_init(zone_contents_t *contents)
+{
+	if (contents == NULL || contents->arena != NULL) {
+		return KNOT_EINVAL;
+	}
+
+	struct zone_arena *arena = calloc(1, sizeof(*arena));
+	if (arena == NULL) {
+		return KNOT_ENOMEM;
+	}
+
+	mm_ctx_mempool(&arena->mm, ARENA_CHUNK_SIZE);
+	if (arena->mm.ctx == NULL) {
+		free(arena);
+		return KNOT_ENOMEM;
+	}
+	knot_refcnt_init(&arena->refs, 1);
+
+	contents->arena = arena;
+	return KNOT_EOK;
+}
+
 zone_tree_t *zone_contents_tree_for_rr(zone_contents_t *contents, const knot_rrset_t *rr)
 {
 	bool nsec3rel = knot_rrset_is_nsec3rel(rr);
@@ -463,6 +529,31 @@ int zone_contents_nsec3_apply(zone_contents_t *contents,
 	return zone_tree_apply(contents->nsec3_nodes, function, data);
 }
 
+static int compact_node(zone_node_t *node, void *data)
+{
+	knot_mm_t *mm = (node->flags & NODE_FLAGS_ARENA) ? data : NULL;
+	return node_compact(node, mm, NULL);
+}
+
+int zone_contents_compact(zone_contents_t *contents)
+{
+	if (contents == NULL) {
+		return KNOT_EINVAL;
+	}
+
+	knot_mm_t *mm = (contents->arena != NULL) ? &contents->arena->mm : NULL;
+
+	int ret = zone_tree_apply(contents->nodes, compact_node, mm);
+	if (ret == KNOT_EOK) {
+		ret = zone_tree_apply(contents->nsec3_nodes, compact_node, mm);
+	}
+
+	if (contents->arena != NULL) {
+		contents->arena->closed = true;
+	}
+	return ret;
+}
+
 int zone_contents_shallow_copy(const zone_contents_t *from, zone_contents_t **to)
 {
 	if (from == NULL || to == NULL) {
@@ -498,6 +589,7 @@ int zone_contents_shallow_copy(const zone_contents_t *from, zone_contents_t **to
 		contents->nsec3_nodes = NULL;
 	}
 	contents->adds_tree = from->adds_tree;
+	contents->arena = arena_ref(from->arena);
 	contents->size = from->size;
 	contents->max_ttl = from->max_ttl;
 
@@ -517,6 +609,7 @@ void zone_contents_free(zone_contents_t *contents)
 
 	dnssec_nsec3_params_free(&contents->nsec3_params);
 	additionals_tree_free(contents->adds_tree);
+	arena_unref(contents->arena);
 
 	free(contents);
 }
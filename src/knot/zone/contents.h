@@ -33,6 +33,7 @@ typedef struct zone_contents {
 	zone_tree_t *nsec3_nodes;
 
 	trie_t *adds_tree; // "additionals tree" for reverse lookup of nodes affected by additionals
+	struct zone_arena *arena; // memory pool of nodes from a full load, shared among versions
 
 	dnssec_nsec3_params_t nsec3_params;
 	size_t size;
@@ -50,6 +51,19 @@ typedef struct zone_contents {
  */
 zone_contents_t *zone_contents_new(const knot_dname_t *apex_name, bool use_binodes);
 
+/*!
+ * \brief Creates a memory arena for nodes of the contents being built.
+ *
+ * Nodes added until the contents are compacted or copied are allocated from
+ * the arena. The arena is shared by derived contents versions and it's freed
+ * at once with the last of them.
+ *
+ * \param contents  Zone contents being built.
+ *
+ * \return KNOT_E*
+ */
+int zone_contents_arena_init(zone_contents_t *contents);
+
 /*!
  * \brief Returns zone tree for inserting given RR.
  */
@@ -232,6 +246,20 @@ int zone_contents_apply(zone_contents_t *contents,
 int zone_contents_nsec3_apply(zone_contents_t *contents,
                               zone_tree_apply_cb_t function, void *data);
 
+/*!
+ * \brief Compacts the data of each node into one contiguous block.
+ *
+ * The blocks of nodes from the arena are allocated in the arena, which is
+ * closed for further allocations then.
+ *
+ * \see node_compact()
+ *
+ * \param contents Zone contents to be compacted.
+ *
+ * \return KNOT_E*
+ */
+int zone_contents_compact(zone_contents_t *contents);
+
 /*!
  * \brief Creates a shallow copy of the zone (no stored data are copied).
  *
@@ -42,13 +42,47 @@ bool additional_equal(additional_t *a, additional_t *b)
 	return true;
 }
 
+/*! \brief Header of the contiguous storage of node RRSet data. */
+struct node_block {
+	size_t size; /*!< Block size including this header. */
+	/* RR data array follows, then the rdata of each RRSet. */
+};
+
+/*! \brief Checks if the data is stored in the node's compact block. */
+static bool in_block(const zone_node_t *node, const void *data)
+{
+	const uint8_t *begin = (const uint8_t *)node->block;
+	const uint8_t *ptr = data;
+
+	return begin != NULL && ptr >= begin && ptr < begin + node->block->size;
+}
+
 /*! \brief Clears allocated data in RRSet entry. */
-static void rr_data_clear(struct rr_data *data, knot_mm_t *mm)
+static void rr_data_clear(const zone_node_t *node, struct rr_data *data, knot_mm_t *mm)
 {
-	knot_rdataset_clear(&data->rrs, mm);
+	if (!in_block(node, data->rrs.rdata)) {
+		knot_rdataset_clear(&data->rrs, mm);
+	}
 	memset(data, 0, sizeof(*data));
 }
 
+/*! \brief Moves RRSet data out of the compact block before modification. */
+static int rdata_detach(const zone_node_t *node, knot_rdataset_t *rrs, knot_mm_t *mm)
+{
+	if (!in_block(node, rrs->rdata)) {
+		return KNOT_EOK;
+	}
+
+	knot_rdataset_t copy;
+	int ret = knot_rdataset_copy(&copy, rrs, mm);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+	*rrs = copy;
+
+	return KNOT_EOK;
+}
+
 /*! \brief Clears allocated data in RRSet entry. */
 static int rr_data_from(const knot_rrset_t *rrset, struct rr_data *data, knot_mm_t *mm)
 {
@@ -73,7 +107,15 @@ static int add_rrset_no_merge(zone_node_t *node, const knot_rrset_t *rrset,
 
 	const size_t prev_nlen = node->rrset_count * sizeof(struct rr_data);
 	const size_t nlen = (node->rrset_count + 1) * sizeof(struct rr_data);
-	void *p = mm_realloc(mm, node->rrs, nlen, prev_nlen);
+	void *p = NULL;
+	if (in_block(node, node->rrs)) {
+		p = mm_alloc(mm, nlen);
+		if (p != NULL) {
+			memcpy(p, node->rrs, prev_nlen);
+		}
+	} else {
+		p = mm_realloc(mm, node->rrs, nlen, prev_nlen);
+	}
 	if (p == NULL) {
 		return KNOT_ENOMEM;
 	}
@@ -157,10 +199,12 @@ void binode_unify(zone_node_t *node, bool free_deleted, knot_mm_t *mm)
 					additional_clear(counter->rrs[i].additional);
 				}
 				if (!binode_rdata_shared(node, counter->rrs[i].type)) {
-					rr_data_clear(&counter->rrs[i], mm);
+					rr_data_clear(counter, &counter->rrs[i], mm);
 				}
 			}
-			mm_free(mm, counter->rrs);
+			if (!in_block(counter, counter->rrs)) {
+				mm_free(mm, counter->rrs);
+			}
 		}
 		if (counter->nsec3_wildcard_name != node->nsec3_wildcard_name) {
 			free(counter->nsec3_wildcard_name);
@@ -265,10 +309,12 @@ void node_free_rrsets(zone_node_t *node, knot_mm_t *mm)
 
 	for (uint16_t i = 0; i < node->rrset_count; ++i) {
 		additional_clear(node->rrs[i].additional);
-		rr_data_clear(&node->rrs[i], mm);
+		rr_data_clear(node, &node->rrs[i], mm);
 	}
 
-	mm_free(mm, node->rrs);
+	if (!in_block(node, node->rrs)) {
+		mm_free(mm, node->rrs);
+	}
 	node->rrs = NULL;
 	node->rrset_count = 0;
 }
@@ -279,7 +325,10 @@ void node_free(zone_node_t *node, knot_mm_t *mm)
 		return;
 	}
 
-	knot_dname_free(node->owner, mm);
+	const bool arena = (node->flags & NODE_FLAGS_ARENA);
+	if (!arena) {
+		knot_dname_free(node->owner, mm);
+	}
 
 	assert((node->flags & NODE_FLAGS_BINODE) || !(node->flags & NODE_FLAGS_SECOND));
 	assert(binode_counterpart(node) == NULL ||
@@ -290,11 +339,63 @@ void node_free(zone_node_t *node, knot_mm_t *mm)
 		free(node->nsec3_hash);
 	}
 
-	if (node->rrs != NULL) {
+	if (node->rrs != NULL && !in_block(node, node->rrs)) {
 		mm_free(mm, node->rrs);
 	}
 
-	mm_free(mm, binode_node(node, false));
+	if (!arena) {
+		mm_free(mm, node->block);
+		mm_free(mm, binode_node(node, false));
+	}
+}
+
+int node_compact(zone_node_t *node, knot_mm_t *block_mm, knot_mm_t *mm)
+{
+	if (node == NULL || node->rrset_count == 0 || node->block != NULL) {
+		return KNOT_EOK;
+	}
+
+	// The counterpart must share the data or be still empty.
+	zone_node_t *counter = binode_counterpart(node);
+	if (counter != NULL && counter->rrs != node->rrs && counter->rrs != NULL) {
+		return KNOT_EOK;
+	}
+
+	const size_t rrs_len = node->rrset_count * sizeof(struct rr_data);
+	size_t size = sizeof(struct node_block) + rrs_len;
+	for (uint16_t i = 0; i < node->rrset_count; ++i) {
+		size += node->rrs[i].rrs.size;
+	}
+
+	struct node_block *block = mm_alloc(block_mm, size);
+	if (block == NULL) {
+		return KNOT_ENOMEM;
+	}
+	block->size = size;
+
+	struct rr_data *rrs = (struct rr_data *)(block + 1);
+	memcpy(rrs, node->rrs, rrs_len);
+
+	uint8_t *pos = (uint8_t *)(rrs + node->rrset_count);
+	for (uint16_t i = 0; i < node->rrset_count; ++i) {
+		knot_rdataset_t *rdataset = &rrs[i].rrs;
+		if (rdataset->size > 0) {
+			memcpy(pos, rdataset->rdata, rdataset->size);
+			rdataset->rdata = (knot_rdata_t *)pos;
+			pos += rdataset->size;
+		}
+		mm_free(mm, node->rrs[i].rrs.rdata);
+	}
+	mm_free(mm, node->rrs);
+
+	if (counter != NULL) {
+		counter->rrs = (counter->rrs != NULL) ? rrs : NULL;
+		counter->block = block;
+	}
+	node->rrs = rrs;
+	node->block = block;
+
+	return KNOT_EOK;
 }
 
 int node_add_rrset(zone_node_t *node, const knot_rrset_t *rrset, knot_mm_t *mm)
@@ -313,8 +414,12 @@ int node_add_rrset(zone_node_t *node, const knot_rrset_t *rrset, knot_mm_t *mm)
 				node_data->ttl = rrset->ttl;
 			}
 
-			int ret = knot_rdataset_merge(&node_data->rrs,
-			                              &rrset->rrs, mm);
+			int ret = rdata_detach(node, &node_data->rrs, mm);
+			if (ret != KNOT_EOK) {
+				return ret;
+			}
+
+			ret = knot_rdataset_merge(&node_data->rrs, &rrset->rrs, mm);
 			if (ret != KNOT_EOK) {
 				return ret;
 			} else {
@@ -341,7 +446,7 @@ void node_remove_rdataset(zone_node_t *node, uint16_t type)
 				additional_clear(node->rrs[i].additional);
 			}
 			if (!binode_rdata_shared(node, type)) {
-				rr_data_clear(&node->rrs[i], NULL);
+				rr_data_clear(node, &node->rrs[i], NULL);
 			}
 			memmove(node->rrs + i, node->rrs + i + 1,
 			        (node->rrset_count - i - 1) * sizeof(struct rr_data));
@@ -364,7 +469,12 @@ int node_remove_rrset(zone_node_t *node, const knot_rrset_t *rrset, knot_mm_t *m
 
 	node->flags &= ~NODE_FLAGS_RRSIGS_VALID;
 
-	int ret = knot_rdataset_subtract(node_rrs, &rrset->rrs, mm);
+	int ret = rdata_detach(node, node_rrs, mm);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
+	ret = knot_rdataset_subtract(node_rrs, &rrset->rrs, mm);
 	if (ret != KNOT_EOK) {
 		return ret;
 	}
@@ -24,6 +24,7 @@
 #include "libknot/rdataset.h"
 
 struct rr_data;
+struct node_block;
 
 /*!
  * \brief Structure representing one node in a domain name tree, i.e. one domain
@@ -35,6 +36,8 @@ typedef struct zone_node {
 
 	/*! \brief Array with data of RRSets belonging to this node. */
 	struct rr_data *rrs;
+	/*! \brief Contiguous storage of RRSet data (see node_compact()). */
+	struct node_block *block;
 
 	/*!
 	 * \brief Previous node in canonical order. Only authoritative
@@ -100,6 +103,8 @@ enum node_flags {
 	NODE_FLAGS_SECOND =          1 << 9, // this value shall be fixed
 	/*! \brief The node shall be deleted. It's just not because it's a bi-node and the counterpart still exists. */
 	NODE_FLAGS_DELETED =         1 << 10,
+	/*! \brief The node, its owner and data block are owned by the zone contents arena. */
+	NODE_FLAGS_ARENA =           1 << 11,
 };
 
 typedef void (*node_addrem_cb)(zone_node_t *, void *);
@@ -214,6 +219,23 @@ void node_free_rrsets(zone_node_t *node, knot_mm_t *mm);
  */
 void node_free(zone_node_t *node, knot_mm_t *mm);
 
+/*!
+ * \brief Moves RRSet data and all rdata of the node into one contiguous block.
+ *
+ * The block is owned by the (bi-)node and freed with it, unless the node
+ * is marked with NODE_FLAGS_ARENA. Any later change of the RRSet rdata is
+ * made on a separate copy.
+ *
+ * \note Bi-nodes with differing counterparts are left untouched.
+ *
+ * \param node      Node to be compacted.
+ * \param block_mm  Memory context to allocate the block from.
+ * \param mm        Memory context of the original node data.
+ *
+ * \return KNOT_E*
+ */
+int node_compact(zone_node_t *node, knot_mm_t *block_mm, knot_mm_t *mm);
+
 /*!
  * \brief Adds an RRSet to the node. All data are copied. Owner and class are
  *        not used at all.
@@ -14,6 +14,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <pthread.h>
 #include <stdio.h>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -22,6 +23,8 @@
 
 #include "libdnssec/error.h"
 #include "contrib/base32hex.h"
+#include "contrib/dynarray.h"
+#include "contrib/macros.h"
 #include "contrib/string.h"
 #include "libknot/libknot.h"
 #include "knot/zone/semantic-check.h"
@@ -149,12 +152,15 @@ typedef enum {
 	NSEC3 =     1 << 3,
 } check_level_t;
 
+struct sem_partition;
+
 typedef struct {
 	zone_contents_t *zone;
 	sem_handler_t *handler;
 	const zone_node_t *next_nsec;
 	check_level_t level;
 	time_t time;
+	struct sem_partition *partition; // Not NULL if checking in parallel.
 } semchecks_data_t;
 
 static int check_cname(const zone_node_t *node, semchecks_data_t *data);
@@ -194,6 +200,58 @@ static const struct check_function CHECK_FUNCTIONS[] = {
 static const int CHECK_FUNCTIONS_LEN = sizeof(CHECK_FUNCTIONS)
                                      / sizeof(struct check_function);
 
+/*!
+ * \brief Semantic error recorded by a check thread.
+ */
+typedef struct {
+	const zone_node_t *node;
+	sem_error_t error;
+	bool fatal;       // The handler error flag was set.
+	bool nsec_chain;  // Placeholder for the deferred NSEC chain link check.
+	char *data;
+} sem_report_t;
+
+dynarray_declare(report, sem_report_t, DYNARRAY_VISIBILITY_STATIC, 16)
+dynarray_define(report, sem_report_t, DYNARRAY_VISIBILITY_STATIC)
+
+/*!
+ * \brief Contiguous part of the zone tree checked by one thread.
+ */
+typedef struct sem_partition {
+	sem_handler_t handler;   // Recording handler, must be the first member.
+	semchecks_data_t data;
+	zone_node_t **nodes;
+	size_t count;
+	report_dynarray_t reports;
+	bool nsec_seen;          // The NSEC chain state is known.
+	pthread_t thread;
+	int thread_init_errcode;
+	int errcode;
+} sem_partition_t;
+
+static void partition_defer_nsec(sem_partition_t *partition, const zone_node_t *node)
+{
+	sem_report_t report = { .node = node, .nsec_chain = true };
+	report_dynarray_add(&partition->reports, &report);
+	partition->nsec_seen = true;
+}
+
+static void partition_record(sem_handler_t *handler, const zone_contents_t *zone,
+                             const zone_node_t *node, sem_error_t error, const char *data)
+{
+	sem_partition_t *partition = (sem_partition_t *)handler;
+
+	sem_report_t report = {
+		.node = node,
+		.error = error,
+		.fatal = handler->error,
+		.data = (data != NULL) ? strdup(data) : NULL,
+	};
+	report_dynarray_add(&partition->reports, &report);
+
+	handler->error = false;
+}
+
 static int check_signature(const knot_rdata_t *rrsig, const dnssec_key_t *key,
                            const knot_rrset_t *covered)
 {
@@ -812,7 +870,10 @@ static int check_nsec(const zone_node_t *node, semchecks_data_t *data)
 		                  SEM_ERR_NSEC_RDATA_MULTIPLE, NULL);
 	}
 
-	if (data->next_nsec != node) {
+	if (data->partition != NULL && !data->partition->nsec_seen) {
+		// The link from the previous partition is checked when merging.
+		partition_defer_nsec(data->partition, node);
+	} else if (data->next_nsec != node) {
 		data->handler->cb(data->handler, data->zone, node,
 		                  SEM_ERR_NSEC_RDATA_CHAIN, NULL);
 	}
@@ -1202,8 +1263,111 @@ static void check_dnskey(zone_contents_t *zone, sem_handler_t *handler)
 	}
 }
 
+static void *check_partition_thread(void *arg)
+{
+	sem_partition_t *partition = arg;
+
+	for (size_t i = 0; i < partition->count && partition->errcode == KNOT_EOK; i++) {
+		partition->errcode = do_checks_in_tree(partition->nodes[i], &partition->data);
+	}
+	if (partition->reports.size < 0) {
+		partition->errcode = KNOT_ENOMEM;
+	}
+
+	return NULL;
+}
+
+/*!
+ * \brief Report the recorded errors in the tree order as if checked sequentially.
+ */
+static int merge_partitions(sem_partition_t *partitions, size_t count,
+                            semchecks_data_t *data)
+{
+	int ret = KNOT_EOK;
+
+	for (size_t i = 0; i < count && ret == KNOT_EOK; i++) {
+		sem_partition_t *partition = &partitions[i];
+		if (partition->thread_init_errcode != 0) {
+			return knot_map_errno_code(partition->thread_init_errcode);
+		}
+		if (partition->reports.size < 0) {
+			return KNOT_ENOMEM;
+		}
+
+		dynarray_foreach(report, sem_report_t, report, partition->reports) {
+			if (report->nsec_chain) {
+				if (data->next_nsec != report->node) {
+					data->handler->cb(data->handler, data->zone, report->node,
+					                  SEM_ERR_NSEC_RDATA_CHAIN, NULL);
+				}
+				continue;
+			}
+			data->handler->error |= report->fatal;
+			data->handler->cb(data->handler, data->zone, report->node,
+			                  report->error, report->data);
+		}
+
+		if (partition->nsec_seen) {
+			data->next_nsec = partition->data.next_nsec;
+		}
+		ret = partition->errcode;
+	}
+
+	return ret;
+}
+
+static int checks_in_tree_parallel(semchecks_data_t *data, size_t threads)
+{
+	zone_tree_delsafe_it_t it = { 0 };
+	int ret = zone_tree_delsafe_it_begin(data->zone->nodes, &it, false);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
+	threads = MIN(threads, it.total);
+	if (threads <= 1) {
+		zone_tree_delsafe_it_free(&it);
+		return zone_contents_apply(data->zone, do_checks_in_tree, data);
+	}
+
+	sem_partition_t partitions[threads];
+	memset(partitions, 0, sizeof(partitions));
+
+	for (size_t i = 0; i < threads; i++) {
+		size_t from = it.total * i / threads;
+		size_t to = it.total * (i + 1) / threads;
+
+		partitions[i].handler.cb = partition_record;
+		partitions[i].data = *data;
+		partitions[i].data.handler = &partitions[i].handler;
+		partitions[i].data.partition = &partitions[i];
+		partitions[i].nodes = it.nodes + from;
+		partitions[i].count = to - from;
+		partitions[i].thread_init_errcode =
+			pthread_create(&partitions[i].thread, NULL,
+			               check_partition_thread, &partitions[i]);
+	}
+	for (size_t i = 0; i < threads; i++) {
+		if (partitions[i].thread_init_errcode == 0) {
+			partitions[i].thread_init_errcode = pthread_join(partitions[i].thread, NULL);
+		}
+	}
+
+	ret = merge_partitions(partitions, threads, data);
+
+	for (size_t i = 0; i < threads; i++) {
+		dynarray_foreach(report, sem_report_t, report, partitions[i].reports) {
+			free(report->data);
+		}
+		report_dynarray_free(&partitions[i].reports);
+	}
+	zone_tree_delsafe_it_free(&it);
+
+	return ret;
+}
+
 int sem_checks_process(zone_contents_t *zone, semcheck_optional_t optional, sem_handler_t *handler,
-                       time_t time)
+                       time_t time, size_t threads)
 {
 	if (zone == NULL || handler == NULL) {
 		return KNOT_EINVAL;
@@ -1233,7 +1397,7 @@ int sem_checks_process(zone_contents_t *zone, semcheck_optional_t optional, sem_
 		}
 	}
 
-	int ret = zone_contents_apply(zone, do_checks_in_tree, &data);
+	int ret = checks_in_tree_parallel(&data, threads);
 	if (ret != KNOT_EOK) {
 		return ret;
 	}
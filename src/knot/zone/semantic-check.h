@@ -119,16 +119,17 @@ struct sem_handler {
 /*!
  * \brief Check zone for semantic errors.
  *
- * Errors are logged in error handler.
+ * Errors are logged in error handler, in the same order for any number of threads.
  *
  * \param zone      Zone to be searched / checked.
  * \param optional  To do also optional check.
  * \param handler   Semantic error handler.
  * \param time      Check zone at given time (rrsig expiration).
+ * \param threads   Number of threads checking the nodes in parallel.
  *
  * \retval KNOT_EOK no error found
  * \retval KNOT_ESEMCHECK found semantic error
  * \retval KNOT_EINVAL or other error
  */
 int sem_checks_process(zone_contents_t *zone, semcheck_optional_t optional, sem_handler_t *handler,
-                       time_t time);
+                       time_t time, size_t threads);
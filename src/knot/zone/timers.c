@@ -56,6 +56,9 @@ enum timer_id {
 	TIMER_LAST_RESALT,
 	TIMER_NEXT_DS_CHECK,
 	TIMER_NEXT_DS_PUSH,
+	TIMER_ZONEFILE_SIZE,
+	TIMER_ZONEFILE_HASH,
+	TIMER_ZONEFILE_SERIAL,
 };
 
 #define TIMER_SIZE (sizeof(uint8_t) + sizeof(uint64_t))
@@ -86,6 +89,9 @@ static int deserialize_timers(zone_timers_t *timers_ptr,
 		case TIMER_LAST_RESALT:   timers.last_resalt = value; break;
 		case TIMER_NEXT_DS_CHECK: timers.next_ds_check = value; break;
 		case TIMER_NEXT_DS_PUSH:  timers.next_ds_push = value; break;
+		case TIMER_ZONEFILE_SIZE: timers.zonefile_size = value; break;
+		case TIMER_ZONEFILE_HASH: timers.zonefile_hash = value; break;
+		case TIMER_ZONEFILE_SERIAL: timers.zonefile_serial = value; break;
 		default:                 break; // ignore
 		}
 	}
@@ -104,14 +110,17 @@ static void txn_write_timers(knot_lmdb_txn_t *txn, const knot_dname_t *zone,
                              const zone_timers_t *timers)
 {
 	MDB_val k = { knot_dname_size(zone), (void *)zone };
-	MDB_val v = knot_lmdb_make_key("BLBLBLBLBLBLBL",
+	MDB_val v = knot_lmdb_make_key("BLBLBLBLBLBLBLBLBLBL",
 		TIMER_SOA_EXPIRE,    (uint64_t)timers->soa_expire,
 		TIMER_LAST_FLUSH,    (uint64_t)timers->last_flush,
 		TIMER_LAST_REFRESH,  (uint64_t)timers->last_refresh,
 		TIMER_NEXT_REFRESH,  (uint64_t)timers->next_refresh,
 		TIMER_LAST_RESALT,   (uint64_t)timers->last_resalt,
 		TIMER_NEXT_DS_CHECK, (uint64_t)timers->next_ds_check,
-		TIMER_NEXT_DS_PUSH,  (uint64_t)timers->next_ds_push);
+		TIMER_NEXT_DS_PUSH,  (uint64_t)timers->next_ds_push,
+		TIMER_ZONEFILE_SIZE, (uint64_t)timers->zonefile_size,
+		TIMER_ZONEFILE_HASH, (uint64_t)timers->zonefile_hash,
+		TIMER_ZONEFILE_SERIAL, (uint64_t)timers->zonefile_serial);
 	knot_lmdb_insert(txn, &k, &v);
 	free(v.mv_data);
 }
@@ -169,22 +178,77 @@ int zone_timers_write(knot_lmdb_db_t *db, const knot_dname_t *zone,
 	return txn.ret;
 }
 
-static void txn_zone_write(zone_t *z, knot_lmdb_txn_t *txn)
+static bool timers_equal(const zone_timers_t *a, const zone_timers_t *b)
 {
-	txn_write_timers(txn, z->name, &z->timers);
+	return a->soa_expire == b->soa_expire &&
+	       a->last_flush == b->last_flush &&
+	       a->last_refresh == b->last_refresh &&
+	       a->next_refresh == b->next_refresh &&
+	       a->last_resalt == b->last_resalt &&
+	       a->next_ds_check == b->next_ds_check &&
+	       a->next_ds_push == b->next_ds_push &&
+	       a->zonefile_size == b->zonefile_size &&
+	       a->zonefile_hash == b->zonefile_hash &&
+	       a->zonefile_serial == b->zonefile_serial;
 }
 
-int zone_timers_write_all(knot_lmdb_db_t *db, knot_zonedb_t *zonedb)
+typedef struct {
+	knot_lmdb_txn_t txn;
+	bool changed_only;
+	size_t written;
+} write_ctx_t;
+
+static void txn_zone_write(zone_t *z, write_ctx_t *ctx)
+{
+	// Work on a copy, the timers may be updated concurrently.
+	zone_timers_t timers = z->timers;
+	if (ctx->changed_only && timers_equal(&timers, &z->timers_db)) {
+		return;
+	}
+
+	txn_write_timers(&ctx->txn, z->name, &timers);
+	z->timers_db = timers;
+	ctx->written++;
+}
+
+static void zone_invalidate_db(zone_t *z)
+{
+	// Force rewrite of unchanged timers too.
+	memset(&z->timers_db, 0, sizeof(z->timers_db));
+	z->timers_db.last_flush = -1;
+}
+
+static int write_zones(knot_lmdb_db_t *db, knot_zonedb_t *zonedb,
+                       bool changed_only, size_t *written)
 {
 	int ret = knot_lmdb_open(db);
 	if (ret != KNOT_EOK) {
 		return ret;
 	}
-	knot_lmdb_txn_t txn = { 0 };
-	knot_lmdb_begin(db, &txn, true);
-	knot_zonedb_foreach(zonedb, txn_zone_write, &txn);
-	knot_lmdb_commit(&txn);
-	return txn.ret;
+	write_ctx_t ctx = { .changed_only = changed_only };
+	knot_lmdb_begin(db, &ctx.txn, true);
+	knot_zonedb_foreach(zonedb, txn_zone_write, &ctx);
+	knot_lmdb_commit(&ctx.txn);
+	if (ctx.txn.ret != KNOT_EOK) {
+		// Nothing written, the remembered values are not in the DB.
+		knot_zonedb_foreach(zonedb, zone_invalidate_db);
+		ctx.written = 0;
+	}
+	if (written != NULL) {
+		*written = ctx.written;
+	}
+	return ctx.txn.ret;
+}
+
+int zone_timers_write_all(knot_lmdb_db_t *db, knot_zonedb_t *zonedb)
+{
+	return write_zones(db, zonedb, false, NULL);
+}
+
+int zone_timers_write_changed(knot_lmdb_db_t *db, knot_zonedb_t *zonedb,
+                              size_t *written)
+{
+	return write_zones(db, zonedb, true, written);
 }
 
 int zone_timers_sweep(knot_lmdb_db_t *db, sweep_cb keep_zone, void *cb_data)
@@ -33,6 +33,9 @@ struct zone_timers {
 	time_t last_resalt;      //!< Last NSEC3 resalt.
 	time_t next_ds_check;    //!< Next parent DS check.
 	time_t next_ds_push;     //!< Next DDNS to parent zone with updated DS record.
+	uint64_t zonefile_size;  //!< Size of the last loaded or written zone file.
+	uint64_t zonefile_hash;  //!< Its contents hash (0 if not usable).
+	uint32_t zonefile_serial;//!< Its SOA serial.
 };
 
 typedef struct zone_timers zone_timers_t;
@@ -77,6 +80,21 @@ int zone_timers_write(knot_lmdb_db_t *db, const knot_dname_t *zone,
  */
 int zone_timers_write_all(knot_lmdb_db_t *db, knot_zonedb_t *zonedb);
 
+/*!
+ * \brief Write timers of zones changed since their last write.
+ *
+ * All changed zones are written in one transaction, so either all or none
+ * of them are persisted. The written values are remembered in each zone.
+ *
+ * \param db       Timer database.
+ * \param zonedb   Zones database.
+ * \param written  Optional output number of written zones.
+ *
+ * \return KNOT_E*
+ */
+int zone_timers_write_changed(knot_lmdb_db_t *db, knot_zonedb_t *zonedb,
+                              size_t *written);
+
 /*!
  * \brief Selectively delete zones from the database.
  *
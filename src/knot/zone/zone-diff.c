@@ -23,7 +23,6 @@
 #include "knot/zone/serial.h"
 
 struct zone_diff_param {
-	zone_tree_t *nodes;
 	changeset_t *changeset;
 	bool ignore_dnssec;
 };
@@ -207,29 +206,40 @@ static int diff_rrsets(const knot_rrset_t *rrset1, const knot_rrset_t *rrset2,
 	return KNOT_EOK;
 }
 
-/*!< \todo this could be generic function for adding / removing. */
-static int knot_zone_diff_node(zone_node_t *node, void *data)
+/*!
+ * \brief Checks if the nodes have the same RRSets, regardless of their order.
+ */
+static bool nodes_equal(const zone_node_t *node1, const zone_node_t *node2)
 {
-	if (node == NULL || data == NULL) {
-		return KNOT_EINVAL;
+	if (node1->rrset_count != node2->rrset_count) {
+		return false;
 	}
-
-	struct zone_diff_param *param = (struct zone_diff_param *)data;
-	if (param->changeset == NULL) {
-		return KNOT_EINVAL;
+	if (node1->rrs == node2->rrs) {
+		return true;
 	}
 
-	/*
-	 * First, we have to search the second tree to see if there's according
-	 * node, if not, the whole node has been removed.
-	 */
-	zone_node_t *node_in_second_tree = zone_tree_get(param->nodes, node->owner);
-	if (node_in_second_tree == NULL) {
-		return remove_node(node, param->changeset, param->ignore_dnssec);
+	for (unsigned i = 0; i < node1->rrset_count; i++) {
+		knot_rrset_t rrset1 = node_rrset_at(node1, i);
+		knot_rrset_t rrset2 = node_rrset(node2, rrset1.type);
+		if (knot_rrset_empty(&rrset2) || rrset1.ttl != rrset2.ttl ||
+		    !knot_rdataset_eq(&rrset1.rrs, &rrset2.rrs)) {
+			return false;
+		}
 	}
 
+	return true;
+}
+
+static int diff_nodes(const zone_node_t *node, const zone_node_t *node_in_second_tree,
+                      struct zone_diff_param *param)
+{
 	assert(node_in_second_tree != node);
 
+	/* Most of the nodes are usually unchanged. */
+	if (nodes_equal(node, node_in_second_tree)) {
+		return KNOT_EOK;
+	}
+
 	/* The nodes are in both trees, we have to diff each RRSet. */
 	if (node->rrset_count == 0) {
 		/*
@@ -298,30 +308,12 @@ static int knot_zone_diff_node(zone_node_t *node, void *data)
 	return KNOT_EOK;
 }
 
-/*!< \todo possibly not needed! */
-static int add_new_nodes(zone_node_t *node, void *data)
+static int tree_it_begin(zone_tree_t *tree, zone_tree_it_t *it)
 {
-	if (node == NULL || data == NULL) {
-		return KNOT_EINVAL;
-	}
-
-	struct zone_diff_param *param = (struct zone_diff_param *)data;
-	if (param->changeset == NULL) {
-		return KNOT_EINVAL;
-	}
-
-	/*
-	* If a node is not present in the second zone, it is a new node
-	* and has to be added to changeset. Differencies on the RRSet level are
-	* already handled.
-	*/
-	zone_node_t *new_node = zone_tree_get(param->nodes, node->owner);
-	if (new_node == NULL) {
-		assert(node);
-		return add_node(node, param->changeset, param->ignore_dnssec);
+	if (zone_tree_is_empty(tree)) {
+		return KNOT_EOK; // Zeroed iterator is finished.
 	}
-
-	return KNOT_EOK;
+	return zone_tree_it_begin(tree, it);
 }
 
 static int load_trees(zone_tree_t *nodes1, zone_tree_t *nodes2,
@@ -334,16 +326,44 @@ static int load_trees(zone_tree_t *nodes1, zone_tree_t *nodes2,
 		.ignore_dnssec = ignore_dnssec,
 	};
 
-	// Traverse one tree, compare every node, each RRSet with its rdata.
-	param.nodes = nodes2;
-	int ret = zone_tree_apply(nodes1, knot_zone_diff_node, &param);
-	if (ret != KNOT_EOK) {
-		return ret;
+	zone_tree_it_t it1 = { 0 }, it2 = { 0 };
+	int ret = tree_it_begin(nodes1, &it1);
+	if (ret == KNOT_EOK) {
+		ret = tree_it_begin(nodes2, &it2);
+	}
+
+	// Walk both trees at once in the canonical order.
+	while (ret == KNOT_EOK) {
+		bool finished1 = zone_tree_it_finished(&it1);
+		bool finished2 = zone_tree_it_finished(&it2);
+		if (finished1 && finished2) {
+			break;
+		}
+
+		zone_node_t *node1 = finished1 ? NULL : zone_tree_it_val(&it1);
+		zone_node_t *node2 = finished2 ? NULL : zone_tree_it_val(&it2);
+		int cmp = finished1 ? 1 : (finished2 ? -1 :
+		          knot_dname_cmp(node1->owner, node2->owner));
+
+		if (cmp < 0) {
+			// The node has been removed.
+			ret = remove_node(node1, param.changeset, param.ignore_dnssec);
+			zone_tree_it_next(&it1);
+		} else if (cmp > 0) {
+			// The node has been added.
+			ret = add_node(node2, param.changeset, param.ignore_dnssec);
+			zone_tree_it_next(&it2);
+		} else {
+			ret = diff_nodes(node1, node2, &param);
+			zone_tree_it_next(&it1);
+			zone_tree_it_next(&it2);
+		}
 	}
 
-	// Some nodes may have been added. Add missing nodes to changeset.
-	param.nodes = nodes1;
-	return zone_tree_apply(nodes2, add_new_nodes, &param);
+	zone_tree_it_free(&it1);
+	zone_tree_it_free(&it2);
+
+	return ret;
 }
 
 int zone_contents_diff(const zone_contents_t *zone1, const zone_contents_t *zone2,
@@ -15,14 +15,23 @@
  */
 
 #include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
 
 #include "knot/dnssec/zone-nsec.h"
 #include "knot/zone/zone-dump.h"
 #include "libknot/libknot.h"
+#include "contrib/macros.h"
 
 /*! \brief Size of auxiliary buffer. */
 #define DUMP_BUF_LEN (70 * 1024)
 
+/*! \brief Number of nodes rendered at once by one thread. */
+#define DUMP_CHUNK_NODES 4096
+
+/*! \brief Number of chunks per thread rendered before writing them out. */
+#define DUMP_WINDOW_CHUNKS 4
+
 /*! \brief Dump parameters. */
 typedef struct {
 	FILE     *file;
@@ -136,7 +145,174 @@ static int node_dump_text(zone_node_t *node, void *data)
 	return KNOT_EOK;
 }
 
-int zone_dump_text(zone_contents_t *zone, FILE *file, bool comments)
+/*! \brief Part of a tree rendered into memory by one thread. */
+typedef struct {
+	dump_params_t params;
+	zone_node_t **nodes;
+	size_t count;
+	char *text;
+	size_t text_len;
+	int ret;
+} dump_chunk_t;
+
+typedef struct {
+	dump_chunk_t *chunks;
+	size_t count;
+	size_t num_threads;
+	size_t thread_index;
+	pthread_t thread;
+	int thread_init_errcode;
+} dump_thread_t;
+
+static int chunk_dump_text(dump_chunk_t *chunk)
+{
+	chunk->params.file = open_memstream(&chunk->text, &chunk->text_len);
+	if (chunk->params.file == NULL) {
+		return knot_map_errno();
+	}
+
+	chunk->params.buf = malloc(DUMP_BUF_LEN);
+	chunk->params.buflen = DUMP_BUF_LEN;
+	int ret = (chunk->params.buf != NULL) ? KNOT_EOK : KNOT_ENOMEM;
+
+	for (size_t i = 0; i < chunk->count && ret == KNOT_EOK; i++) {
+		ret = node_dump_text(chunk->nodes[i], &chunk->params);
+	}
+
+	free(chunk->params.buf);
+	if (fclose(chunk->params.file) != 0 && ret == KNOT_EOK) {
+		ret = knot_map_errno();
+	}
+
+	return ret;
+}
+
+static void *dump_thread(void *arg)
+{
+	dump_thread_t *args = arg;
+
+	for (size_t i = args->thread_index; i < args->count; i += args->num_threads) {
+		args->chunks[i].ret = chunk_dump_text(&args->chunks[i]);
+	}
+
+	return NULL;
+}
+
+static int dump_chunks_parallel(dump_chunk_t *chunks, size_t count, size_t num_threads)
+{
+	dump_thread_t args[num_threads];
+	memset(args, 0, sizeof(args));
+
+	for (size_t i = 0; i < num_threads; i++) {
+		args[i].chunks = chunks;
+		args[i].count = count;
+		args[i].num_threads = num_threads;
+		args[i].thread_index = i;
+		args[i].thread_init_errcode = -1;
+	}
+
+	if (num_threads == 1) {
+		args[0].thread_init_errcode = 0;
+		dump_thread(&args[0]);
+	} else {
+		for (size_t i = 0; i < num_threads; i++) {
+			args[i].thread_init_errcode =
+				pthread_create(&args[i].thread, NULL, dump_thread, &args[i]);
+		}
+		for (size_t i = 0; i < num_threads; i++) {
+			if (args[i].thread_init_errcode == 0) {
+				args[i].thread_init_errcode = pthread_join(args[i].thread, NULL);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < num_threads; i++) {
+		if (args[i].thread_init_errcode != 0) {
+			return knot_map_errno_code(args[i].thread_init_errcode);
+		}
+	}
+
+	return KNOT_EOK;
+}
+
+/*!
+ * \brief Dumps the tree by rendering windows of node chunks in parallel and
+ *        writing them in order.
+ */
+static int tree_dump_text_parallel(zone_tree_t *tree, dump_params_t *params,
+                                   size_t num_threads)
+{
+	if (zone_tree_is_empty(tree)) {
+		return KNOT_EOK;
+	}
+
+	zone_tree_delsafe_it_t it = { 0 };
+	int ret = zone_tree_delsafe_it_begin(tree, &it, false);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
+	size_t window = num_threads * DUMP_WINDOW_CHUNKS;
+	dump_chunk_t *chunks = calloc(window, sizeof(*chunks));
+	if (chunks == NULL) {
+		zone_tree_delsafe_it_free(&it);
+		return KNOT_ENOMEM;
+	}
+
+	size_t pos = 0;
+	while (pos < it.total && ret == KNOT_EOK) {
+		size_t count = 0;
+		for (; count < window && pos < it.total; count++) {
+			dump_chunk_t *chunk = &chunks[count];
+			memset(chunk, 0, sizeof(*chunk));
+			chunk->params = *params;
+			chunk->params.rr_count = 0;
+			chunk->params.first_comment = NULL;
+			chunk->nodes = it.nodes + pos;
+			chunk->count = MIN(DUMP_CHUNK_NODES, it.total - pos);
+			pos += chunk->count;
+		}
+
+		ret = dump_chunks_parallel(chunks, count, MIN(num_threads, count));
+
+		for (size_t i = 0; i < count; i++) {
+			dump_chunk_t *chunk = &chunks[i];
+			if (ret == KNOT_EOK) {
+				ret = chunk->ret;
+			}
+			if (ret == KNOT_EOK && chunk->text_len > 0) {
+				// Dump block comment before the first record.
+				if (params->first_comment != NULL) {
+					fprintf(params->file, "%s", params->first_comment);
+					params->first_comment = NULL;
+				}
+				fwrite(chunk->text, 1, chunk->text_len, params->file);
+				params->rr_count += chunk->params.rr_count;
+			}
+			free(chunk->text);
+		}
+	}
+
+	free(chunks);
+	zone_tree_delsafe_it_free(&it);
+
+	return ret;
+}
+
+static int tree_dump_text(zone_contents_t *zone, bool nsec3, dump_params_t *params,
+                          size_t threads)
+{
+	zone_tree_t *tree = nsec3 ? zone->nsec3_nodes : zone->nodes;
+	if (threads > 1 && zone_tree_count(tree) > DUMP_CHUNK_NODES) {
+		return tree_dump_text_parallel(tree, params, threads);
+	} else if (nsec3) {
+		return zone_contents_nsec3_apply(zone, node_dump_text, params);
+	} else {
+		return zone_contents_apply(zone, node_dump_text, params);
+	}
+}
+
+int zone_dump_text(zone_contents_t *zone, FILE *file, bool comments, size_t threads)
 {
 	if (zone == NULL || file == NULL) {
 		return KNOT_EINVAL;
@@ -166,7 +342,7 @@ int zone_dump_text(zone_contents_t *zone, FILE *file, bool comments)
 	};
 
 	// Dump standard zone records without RRSIGS.
-	int ret = zone_contents_apply(zone, node_dump_text, &params);
+	int ret = tree_dump_text(zone, false, &params, threads);
 	if (ret != KNOT_EOK) {
 		return ret;
 	}
@@ -175,7 +351,7 @@ int zone_dump_text(zone_contents_t *zone, FILE *file, bool comments)
 	params.dump_rrsig = true;
 	params.dump_nsec = false;
 	params.first_comment = comments ? ";; DNSSEC signatures\n" : NULL;
-	ret = zone_contents_apply(zone, node_dump_text, &params);
+	ret = tree_dump_text(zone, false, &params, threads);
 	if (ret != KNOT_EOK) {
 		return ret;
 	}
@@ -184,7 +360,7 @@ int zone_dump_text(zone_contents_t *zone, FILE *file, bool comments)
 	params.dump_rrsig = false;
 	params.dump_nsec = true;
 	params.first_comment = comments ? ";; DNSSEC NSEC chain\n" : NULL;
-	ret = zone_contents_apply(zone, node_dump_text, &params);
+	ret = tree_dump_text(zone, false, &params, threads);
 	if (ret != KNOT_EOK) {
 		return ret;
 	}
@@ -193,7 +369,7 @@ int zone_dump_text(zone_contents_t *zone, FILE *file, bool comments)
 	params.dump_rrsig = false;
 	params.dump_nsec = true;
 	params.first_comment = comments ? ";; DNSSEC NSEC3 chain\n" : NULL;
-	ret = zone_contents_nsec3_apply(zone, node_dump_text, &params);
+	ret = tree_dump_text(zone, true, &params, threads);
 	if (ret != KNOT_EOK) {
 		return ret;
 	}
@@ -201,7 +377,7 @@ int zone_dump_text(zone_contents_t *zone, FILE *file, bool comments)
 	params.dump_rrsig = true;
 	params.dump_nsec = false;
 	params.first_comment = comments ? ";; DNSSEC NSEC3 signatures\n" : NULL;
-	ret = zone_contents_nsec3_apply(zone, node_dump_text, &params);
+	ret = tree_dump_text(zone, true, &params, threads);
 	if (ret != KNOT_EOK) {
 		return ret;
 	}
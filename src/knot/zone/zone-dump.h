@@ -24,8 +24,9 @@
  * \param zone      Zone to be saved.
  * \param file      File to write to.
  * \param comments  Add separating comments indicator.
+ * \param threads   Number of threads rendering the records in parallel.
  *
  * \retval KNOT_EOK on success.
  * \retval < 0 if error.
  */
-int zone_dump_text(zone_contents_t *zone, FILE *file, bool comments);
+int zone_dump_text(zone_contents_t *zone, FILE *file, bool comments, size_t threads);
@@ -42,6 +42,19 @@ int zone_load_contents(conf_t *conf, const knot_dname_t *zone_name,
 		return ret;
 	}
 
+	val = conf_zone_get(conf, C_COMPACT_NODES, zone_name);
+	if (conf_bool(&val)) {
+		ret = zone_contents_arena_init(zl.creator->z);
+		if (ret != KNOT_EOK) {
+			zone_contents_deep_free(zl.creator->z);
+			zonefile_close(&zl);
+			return ret;
+		}
+	}
+
+	val = conf_zone_get(conf, C_ADJUST_THR, zone_name);
+	zl.threads = conf_int(&val);
+
 	sem_handler_t handler = {
 		.cb = err_handler_logger
 	};
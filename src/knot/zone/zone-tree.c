@@ -325,6 +325,32 @@ int zone_tree_it_sub_begin(zone_tree_t *tree, const knot_dname_t *sub_root,
 	return KNOT_EOK;
 }
 
+int zone_tree_it_from_begin(zone_tree_t *tree, const knot_dname_t *from,
+                            bool excl_from, zone_tree_it_t *it)
+{
+	if (tree == NULL || from == NULL) {
+		return KNOT_EINVAL;
+	}
+	int ret = zone_tree_it_begin(tree, it);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+	knot_dname_storage_t lf_storage;
+	uint8_t *lf = knot_dname_lf(from, lf_storage);
+	ret = trie_it_get_leq(it->it, lf + 1, *lf);
+	if (ret == 1 || (ret == KNOT_EOK && excl_from)) {
+		trie_it_next(it->it);
+	} else if (ret == KNOT_ENOENT) {
+		// All nodes follow the name, start from the beginning.
+		zone_tree_it_free(it);
+		return zone_tree_it_begin(tree, it);
+	} else if (ret != KNOT_EOK) {
+		zone_tree_it_free(it);
+		return ret;
+	}
+	return KNOT_EOK;
+}
+
 int zone_tree_it_double_begin(zone_tree_t *first, zone_tree_t *second, zone_tree_it_t *it)
 {
 	if (it->tree == NULL) {
@@ -248,6 +248,19 @@ int zone_tree_it_begin(zone_tree_t *tree, zone_tree_it_t *it);
 int zone_tree_it_sub_begin(zone_tree_t *tree, const knot_dname_t *sub_root,
                            zone_tree_it_t *it);
 
+/*!
+ * \brief Start iteration at a given name or at the following one.
+ *
+ * \param tree        Zone tree to iterate in.
+ * \param from        Name to start the iteration at.
+ * \param excl_from   Skip the node of the given name if present.
+ * \param it          Out: iteration context, shall be zeroed before.
+ *
+ * \return KNOT_E*
+ */
+int zone_tree_it_from_begin(zone_tree_t *tree, const knot_dname_t *from,
+                            bool excl_from, zone_tree_it_t *it);
+
 /*!
  * \brief Start iteration of two zone trees.
  *
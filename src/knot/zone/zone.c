@@ -22,6 +22,7 @@
 #include "knot/common/log.h"
 #include "knot/conf/module.h"
 #include "knot/dnssec/kasp/kasp_db.h"
+#include "knot/dnssec/nsec3-chain.h"
 #include "knot/events/replan.h"
 #include "knot/journal/journal_read.h"
 #include "knot/journal/journal_write.h"
@@ -33,6 +34,7 @@
 #include "knot/zone/zone.h"
 #include "knot/zone/zonefile.h"
 #include "libknot/libknot.h"
+#include "contrib/atomic.h"
 #include "contrib/sockaddr.h"
 #include "contrib/mempattern.h"
 #include "contrib/ucw/lists.h"
@@ -67,8 +69,8 @@ static int flush_journal(conf_t *conf, zone_t *zone, bool allow_empty_zone, bool
 
 	bool force = zone_get_flag(zone, ZONE_FORCE_FLUSH, true);
 
-	conf_val_t val = conf_zone_get(conf, C_ZONEFILE_SYNC, zone->name);
-	int64_t sync_timeout = conf_int(&val);
+	conf_zone_cache_t zcache = conf_zone_cache(conf, zone->name);
+	int64_t sync_timeout = zcache.zonefile_sync;
 
 	if (zone_contents_is_empty(zone->contents)) {
 		if (allow_empty_zone && journal_is_existing(j)) {
@@ -100,7 +102,7 @@ static int flush_journal(conf_t *conf, zone_t *zone, bool allow_empty_zone, bool
 	char *zonefile = conf_zonefile(conf, zone->name);
 
 	/* Synchronize journal. */
-	ret = zonefile_write(zonefile, contents);
+	ret = zonefile_write(zonefile, contents, zcache.adjust_threads);
 	if (ret != KNOT_EOK) {
 		log_zone_warning(zone->name, "failed to update zone file (%s)",
 		                 knot_strerror(ret));
@@ -126,6 +128,13 @@ static int flush_journal(conf_t *conf, zone_t *zone, bool allow_empty_zone, bool
 		goto flush_journal_replan;
 	}
 
+	/* Remember the written zone file for change detection. */
+	if (zonefile_fingerprint(zonefile, &zone->timers.zonefile_size,
+	                         &zone->timers.zonefile_hash) != KNOT_EOK) {
+		zone->timers.zonefile_hash = 0;
+	}
+	zone->timers.zonefile_serial = serial_to;
+
 	free(zonefile);
 
 	/* Update zone file attributes. */
@@ -225,6 +234,7 @@ void zone_free(zone_t **zone_ptr)
 
 	/* Free zone contents. */
 	zone_contents_deep_free(zone->contents);
+	knot_nsec3_shadow_free(zone->nsec3_shadow);
 
 	conf_deactivate_modules(&zone->query_modules, &zone->query_plan);
 
@@ -409,6 +419,38 @@ bool zone_expired(const zone_t *zone)
 	       timers->last_refresh + timers->soa_expire <= time(NULL);
 }
 
+bool zone_lazy_applies(conf_t *conf, const zone_t *zone)
+{
+	if (conf == NULL || zone == NULL) {
+		return false;
+	}
+
+	conf_val_t val = conf_zone_get(conf, C_LAZY_LOAD, zone->name);
+	if (!conf_bool(&val) || zone_is_slave(conf, zone)) {
+		return false;
+	}
+
+	// Signed and catalog zones require their contents for the periodic events.
+	val = conf_zone_get(conf, C_DNSSEC_SIGNING, zone->name);
+	if (conf_bool(&val)) {
+		return false;
+	}
+	val = conf_zone_get(conf, C_CATALOG_ROLE, zone->name);
+	return conf_opt(&val) == CATALOG_ROLE_NONE;
+}
+
+void zone_lazy_touch(zone_t *zone)
+{
+	time_t now = time(NULL);
+	if (ATOMIC_GET(zone->lazy.last_query) != now) {
+		ATOMIC_SET(zone->lazy.last_query, now);
+	}
+
+	if (zone->contents == NULL && !ATOMIC_XCHG(zone->lazy.pending, true)) {
+		zone_events_schedule_now(zone, ZONE_EVENT_LOAD);
+	}
+}
+
 /*!
  * \brief Get preferred zone master while checking its existence.
  */
@@ -545,7 +587,8 @@ int zone_dump_to_dir(conf_t *conf, zone_t *zone, const char *dir)
 	}
 	free(zonefile);
 
-	return zonefile_write(target, zone->contents);
+	return zonefile_write(target, zone->contents,
+	                      conf_zone_cache(conf, zone->name).adjust_threads);
 }
 
 int zone_set_master_serial(zone_t *zone, uint32_t serial)
@@ -573,8 +616,7 @@ int slave_zone_serial(zone_t *zone, conf_t *conf, uint32_t *serial)
 	int ret = KNOT_EOK;
 	*serial = zone_contents_serial(zone->contents);
 
-	conf_val_t val = conf_zone_get(conf, C_DNSSEC_SIGNING, zone->name);
-	if (conf_bool(&val)) {
+	if (conf_zone_cache(conf, zone->name).dnssec_signing) {
 		ret = zone_get_master_serial(zone, serial);
 	}
 
@@ -30,6 +30,7 @@
 
 struct zone_update;
 struct zone_backup_ctx;
+struct knot_nsec3_shadow;
 
 /*!
  * \brief Zone flags.
@@ -68,12 +69,16 @@ typedef struct zone
 
 	/*! \brief Zone events. */
 	zone_timers_t timers;      //!< Persistent zone timers.
+	zone_timers_t timers_db;   //!< Timers as last written to the timer DB.
 	zone_events_t events;      //!< Zone events timers.
 
 	/*! \brief DDNS queue and lock. */
 	pthread_mutex_t ddns_lock;
 	size_t ddns_queue_size;
 	list_t ddns_queue;
+	size_t ddns_batch;         //!< Adaptive limit of updates processed at once.
+	uint64_t ddns_processed;   //!< Number of answered updates (under ddns_lock).
+	uint64_t ddns_latency;     //!< Their total latency in milliseconds (under ddns_lock).
 
 	/*! \brief Control update context. */
 	struct zone_update *control_update;
@@ -90,6 +95,9 @@ typedef struct zone
 	/*! \brief Zone backup context (NULL unless backup pending). */
 	struct zone_backup_ctx *backup_ctx;
 
+	/*! \brief NSEC3 chain being signed in advance for the pending resalt. */
+	struct knot_nsec3_shadow *nsec3_shadow;
+
 	/*! \brief Ptr to catalog and ist changeset changes (in struct server) */
 	catalog_t *catalog;
 	catalog_update_t *catalog_upd;
@@ -102,6 +110,13 @@ typedef struct zone
 	/*! \brief Query modules. */
 	list_t query_modules;
 	struct query_plan *query_plan;
+
+	/*! \brief Loading of zone contents on demand. */
+	struct {
+		bool enabled;        //!< Contents loaded on the first query, can be unloaded.
+		bool pending;        //!< Load has been requested by a query (atomic).
+		time_t last_query;   //!< Time of the last query to the zone (atomic).
+	} lazy;
 } zone_t;
 
 /*!
@@ -178,6 +193,16 @@ const knot_rdataset_t *zone_soa(const zone_t *zone);
 /*! \brief Check if zone is expired according to timers. */
 bool zone_expired(const zone_t *zone);
 
+/*! \brief Checks if the zone contents can be loaded on demand. */
+bool zone_lazy_applies(conf_t *conf, const zone_t *zone);
+
+/*!
+ * \brief Notes a query to the zone with lazily loaded contents.
+ *
+ * Requests the zone load if the contents aren't loaded yet.
+ */
+void zone_lazy_touch(zone_t *zone);
+
 typedef int (*zone_master_cb)(conf_t *conf, zone_t *zone, const conf_remote_t *remote,
                               void *data);
 
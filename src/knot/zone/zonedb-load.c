@@ -130,11 +130,18 @@ static zone_t *create_zone_reload(conf_t *conf, const knot_dname_t *name,
 	zone_set_flag(zone, zone_get_flag(old_zone, ZONE_IS_CATALOG | ZONE_IS_CAT_MEMBER, false));
 
 	zone->timers = old_zone->timers;
+	zone->timers_db = old_zone->timers_db;
 	timers_sanitize(conf, zone);
 
+	zone->lazy.enabled = zone_lazy_applies(conf, zone);
+	zone->lazy.last_query = old_zone->lazy.last_query;
+
 	bool conf_updated = (old_zone->change_type & CONF_IO_TRELOAD);
 
-	if ((zone_file_updated(conf, old_zone, name) || conf_updated) && !zone_expired(zone)) {
+	if (zone->lazy.enabled && zone->contents == NULL) {
+		// Not loaded yet or unloaded, the first query loads the zone.
+		zone->zonefile = old_zone->zonefile;
+	} else if ((zone_file_updated(conf, old_zone, name) || conf_updated) && !zone_expired(zone)) {
 		replan_load_updated(zone, old_zone);
 	} else {
 		zone->zonefile = old_zone->zonefile;
@@ -164,14 +171,19 @@ static zone_t *create_zone_new(conf_t *conf, const knot_dname_t *name,
 		zone_free(&zone);
 		return NULL;
 	}
+	zone->timers_db = zone->timers;
 
 	timers_sanitize(conf, zone);
 
+	zone->lazy.enabled = zone_lazy_applies(conf, zone);
+
 	if (zone_expired(zone)) {
 		// expired => force bootstrap, no load attempt
 		log_zone_info(zone->name, "zone will be bootstrapped");
 		assert(zone_is_slave(conf, zone));
 		replan_load_bootstrap(conf, zone);
+	} else if (zone->lazy.enabled) {
+		log_zone_info(zone->name, "zone will be loaded on demand");
 	} else {
 		log_zone_info(zone->name, "zone will be loaded");
 		replan_load_new(zone); // if load fails, fallback to bootstrap
@@ -374,6 +386,10 @@ static knot_zonedb_t *create_zonedb(conf_t *conf, server_t *server, list_t *expi
 
 		zone_t *old_zone = knot_zonedb_find(db_old, name);
 		if (old_zone != NULL && !full) {
+			/* Reload zone depending on a changed template, policy, etc. */
+			if (conf_io_zone_refs_changed(conf, name)) {
+				old_zone->change_type |= CONF_IO_TRELOAD;
+			}
 			/* Reuse unchanged zone. */
 			if (!(old_zone->change_type & CONF_IO_TRELOAD)) {
 				knot_zonedb_insert(db_new, old_zone);
@@ -565,6 +581,289 @@ void zonedb_reload(conf_t *conf, server_t *server)
 	remove_old_zonedb(conf, db_old, server);
 }
 
+static void freeze_catalog_zones(catalog_update_t *u, knot_zonedb_t *db, list_t *frozen)
+{
+	pthread_mutex_lock(&u->mutex);
+	for (int remove = 0; remove < 2; remove++) {
+		catalog_it_t *it = catalog_it_begin(u, remove);
+		for (; !catalog_it_finished(it); catalog_it_next(it)) {
+			zone_t *catz = knot_zonedb_find(db, catalog_it_val(it)->catzone);
+			bool found = (catz == NULL);
+			ptrnode_t *n;
+			WALK_LIST(n, *frozen) {
+				found = found || (n->d == catz);
+			}
+			if (!found) {
+				ptrlist_add(frozen, catz, NULL);
+			}
+		}
+		catalog_it_free(it);
+	}
+	pthread_mutex_unlock(&u->mutex);
+
+	ptrnode_t *n;
+	WALK_LIST(n, *frozen) {
+		zone_events_freeze_blocking(n->d);
+	}
+}
+
+int zonedb_update_catalog(conf_t *conf, server_t *server)
+{
+	if (conf == NULL || server == NULL || server->zone_db == NULL) {
+		return KNOT_EINVAL;
+	}
+
+	catalog_update_t batch;
+	int ret = catalog_update_init(&batch);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
+	knot_zonedb_t *db_old = server->zone_db;
+	knot_zonedb_t *db_new = knot_zonedb_cow(db_old);
+	if (db_new == NULL) {
+		catalog_update_deinit(&batch);
+		return KNOT_ENOMEM;
+	}
+
+	/* Keep the catalog zones from changing the membership meanwhile. */
+	list_t catalogs;
+	init_list(&catalogs);
+	freeze_catalog_zones(&server->catalog_upd, db_old, &catalogs);
+
+	/* Take over the pending changes. Later ones are processed next time. */
+	pthread_mutex_lock(&server->catalog_upd.mutex);
+	trie_t *tmp = batch.add;
+	batch.add = server->catalog_upd.add;
+	server->catalog_upd.add = tmp;
+	tmp = batch.rem;
+	batch.rem = server->catalog_upd.rem;
+	server->catalog_upd.rem = tmp;
+	pthread_mutex_unlock(&server->catalog_upd.mutex);
+
+	catalog_commit_cleanup(&server->catalog);
+
+	/* Store the new and re-owned members so that their configuration is available. */
+	catalog_it_t *it = catalog_it_begin(&batch, false);
+	int catret = 1;
+	if (!catalog_it_finished(it)) {
+		catret = catalog_begin(&server->catalog);
+	}
+	while (!catalog_it_finished(it) && catret == KNOT_EOK) {
+		catalog_upd_val_t *val = catalog_it_val(it);
+		if (val->just_reconf || knot_zonedb_find(db_old, val->member) == NULL) {
+			catret = catalog_add2(&server->catalog, val);
+		}
+		catalog_it_next(it);
+	}
+	catalog_it_free(it);
+	if (catret == KNOT_EOK) {
+		catret = catalog_commit(&server->catalog);
+	}
+
+	list_t expired_contents, old_zones, removed_zones, new_zones;
+	init_list(&expired_contents);
+	init_list(&old_zones);
+	init_list(&removed_zones);
+	init_list(&new_zones);
+
+	/* Re-create the re-owned members and unlink the removed ones. */
+	it = catalog_it_begin(&batch, true);
+	while (!catalog_it_finished(it)) {
+		catalog_upd_val_t *upd = catalog_it_val(it);
+		catalog_it_next(it);
+
+		zone_t *zone = knot_zonedb_find(db_old, upd->member);
+		if (zone == NULL || !zone_get_flag(zone, ZONE_IS_CAT_MEMBER, false)) {
+			continue;
+		}
+		ptrnode_t *n, *nxt;
+		WALK_LIST_DELSAFE(n, nxt, catalogs) {
+			if (n->d == zone) { // nested catalog, handled as a member
+				ptrlist_rem(n, NULL);
+			}
+		}
+		zone_events_freeze_blocking(zone);
+
+		if (!upd->just_reconf) {
+			(void)knot_zonedb_del(db_new, zone->name);
+			ptrlist_add(&removed_zones, zone, NULL);
+			continue;
+		}
+
+		zone_purge(conf, zone, server);
+		knot_sem_wait(&zone->cow_lock);
+		ptrlist_add(&expired_contents, zone_expire(zone), NULL);
+		knot_sem_post(&zone->cow_lock);
+
+		zone_t *newzone = create_zone(conf, zone->name, server, zone);
+		if (newzone == NULL) {
+			log_zone_error(zone->name, "zone cannot be created");
+			(void)knot_zonedb_del(db_new, zone->name);
+			ptrlist_add(&removed_zones, zone, NULL);
+			continue;
+		}
+		zone_events_freeze(newzone);
+		conf_activate_modules(conf, server, newzone->name, &newzone->query_modules,
+		                      &newzone->query_plan);
+		ret = knot_zonedb_insert(db_new, newzone);
+		if (ret != KNOT_EOK) {
+			log_zone_error(zone->name, "zone cannot be created (%s)", knot_strerror(ret));
+			(void)knot_zonedb_del(db_new, zone->name);
+			ptrlist_add(&removed_zones, zone, NULL);
+			zone_free(&newzone);
+			continue;
+		}
+		ptrlist_add(&old_zones, zone, NULL);
+		ptrlist_add(&new_zones, newzone, NULL);
+	}
+	catalog_it_free(it);
+
+	/* Create the new members. */
+	it = catalog_it_begin(&batch, false);
+	while (!catalog_it_finished(it) && catret == KNOT_EOK) {
+		zone_t *zone = add_member_zone(catalog_it_val(it), db_new, server, conf);
+		catalog_it_next(it);
+		if (zone == NULL) {
+			continue;
+		}
+		zone_events_freeze(zone);
+		ret = knot_zonedb_insert(db_new, zone);
+		if (ret != KNOT_EOK) {
+			log_zone_error(zone->name, "zone cannot be created (%s)", knot_strerror(ret));
+			zone_free(&zone);
+			continue;
+		}
+		ptrlist_add(&new_zones, zone, NULL);
+	}
+	catalog_it_free(it);
+
+	/* Switch the databases and wait for readers of the old one. */
+	knot_zonedb_t *db_prev = rcu_xchg_pointer(&server->zone_db, db_new);
+	assert(db_prev == db_old);
+	synchronize_rcu();
+
+	ptrlist_free_custom(&expired_contents, NULL, (ptrlist_free_cb)zone_contents_deep_free);
+	knot_zonedb_cow_commit(db_new, &db_prev);
+
+	catalog_commit_cleanup(&server->catalog);
+
+	/* Remove deleted members from the catalog and purge them. */
+	it = catalog_it_begin(&batch, true);
+	int delret = 1;
+	if (!catalog_it_finished(it)) {
+		delret = catalog_begin(&server->catalog);
+	}
+	while (!catalog_it_finished(it) && delret == KNOT_EOK) {
+		catalog_upd_val_t *upd = catalog_it_val(it);
+		if (!upd->just_reconf) {
+			catalog_del(&server->catalog, upd->member);
+		}
+		catalog_it_next(it);
+	}
+	catalog_it_free(it);
+	ptrnode_t *n;
+	WALK_LIST(n, removed_zones) {
+		zone_purge(conf, n->d, server);
+	}
+	if (delret == KNOT_EOK) {
+		delret = catalog_commit(&server->catalog);
+	}
+	if (catret == KNOT_EOK && delret < 0) {
+		catret = delret;
+	}
+	if (catret < 0) {
+		log_error("failed to process zone catalog (%s)", knot_strerror(catret));
+	}
+
+	WALK_LIST(n, removed_zones) {
+		zone_t *zone = n->d;
+		zone_free(&zone);
+	}
+	WALK_LIST(n, old_zones) {
+		zone_t *zone = n->d;
+		zone->contents = NULL; // contents have been re-used by the new zone
+		zone_free(&zone);
+	}
+	ptrlist_free(&removed_zones, NULL);
+	ptrlist_free(&old_zones, NULL);
+
+	/* Resume processing events. */
+	WALK_LIST(n, new_zones) {
+		zone_events_start(n->d);
+	}
+	WALK_LIST(n, catalogs) {
+		zone_events_start(n->d);
+	}
+	ptrlist_free(&new_zones, NULL);
+	ptrlist_free(&catalogs, NULL);
+
+	catalog_update_clear(&batch);
+	catalog_update_deinit(&batch);
+
+	return KNOT_EOK;
+}
+
+typedef struct {
+	zone_t *zone;
+	time_t last_query;
+	size_t size;
+} lazy_zone_t;
+
+static int lazy_zone_cmp(const void *a, const void *b)
+{
+	time_t ta = ((const lazy_zone_t *)a)->last_query;
+	time_t tb = ((const lazy_zone_t *)b)->last_query;
+	return (ta > tb) - (ta < tb);
+}
+
+size_t zonedb_lazy_unload(knot_zonedb_t *db, size_t limit)
+{
+	size_t count = knot_zonedb_size(db);
+	if (count == 0) {
+		return 0;
+	}
+
+	lazy_zone_t *loaded = malloc(count * sizeof(*loaded));
+	if (loaded == NULL) {
+		return 0;
+	}
+
+	size_t nloaded = 0, total = 0;
+	knot_zonedb_iter_t *it = knot_zonedb_iter_begin(db);
+	for (; !knot_zonedb_iter_finished(it); knot_zonedb_iter_next(it)) {
+		zone_t *zone = knot_zonedb_iter_val(it);
+		zone_contents_t *contents = rcu_dereference(zone->contents);
+		if (!zone->lazy.enabled || contents == NULL ||
+		    zone_events_get_time(zone, ZONE_EVENT_UNLOAD) > 0) {
+			continue;
+		}
+		assert(nloaded < count);
+		loaded[nloaded++] = (lazy_zone_t) {
+			.zone = zone,
+			.last_query = zone->lazy.last_query,
+			.size = contents->size,
+		};
+		total += contents->size;
+	}
+	knot_zonedb_iter_free(it);
+
+	size_t unloaded = 0;
+	if (total > limit) {
+		// Least recently queried zones first.
+		qsort(loaded, nloaded, sizeof(*loaded), lazy_zone_cmp);
+		for (size_t i = 0; i < nloaded && total > limit; i++) {
+			zone_events_schedule_now(loaded[i].zone, ZONE_EVENT_UNLOAD);
+			total -= loaded[i].size;
+			unloaded++;
+		}
+	}
+
+	free(loaded);
+
+	return unloaded;
+}
+
 int zone_reload_modules(conf_t *conf, server_t *server, const knot_dname_t *zone_name)
 {
 	zone_t **zone = knot_zonedb_find_ptr(server->zone_db, zone_name);
@@ -27,6 +27,31 @@
  */
 void zonedb_reload(conf_t *conf, server_t *server);
 
+/*!
+ * \brief Apply pending catalog member changes to the zone database.
+ *
+ * Only the added, removed, or re-owned member zones are processed, the rest
+ * of the zone database is shared with the previous version.
+ *
+ * \param[in] conf Configuration.
+ * \param[in] server Server instance.
+ *
+ * \return KNOT_E*
+ */
+int zonedb_update_catalog(conf_t *conf, server_t *server);
+
+/*!
+ * \brief Plan unloading of the least recently queried lazily loaded zones.
+ *
+ * \note Must be called under RCU read lock.
+ *
+ * \param db     Zone database.
+ * \param limit  Maximum total size of the lazily loaded zones to be kept.
+ *
+ * \return Number of zones planned to be unloaded.
+ */
+size_t zonedb_lazy_unload(knot_zonedb_t *db, size_t limit);
+
 /*!
  * \brief Re-create zone_t struct in zoneDB so that the zone is reloaded incl modules.
  *
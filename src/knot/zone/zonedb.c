@@ -20,8 +20,6 @@
 #include "knot/journal/journal_metadata.h"
 #include "knot/zone/zonedb.h"
 #include "libknot/packet/wire.h"
-#include "contrib/mempattern.h"
-#include "contrib/ucw/mempool.h"
 
 /*! \brief Discard zone in zone database. */
 static void discard_zone(zone_t *zone, bool abort_txn)
@@ -55,11 +53,8 @@ knot_zonedb_t *knot_zonedb_new(void)
 		return NULL;
 	}
 
-	mm_ctx_mempool(&db->mm, MM_DEFAULT_BLKSIZE);
-
-	db->trie = trie_create(&db->mm);
+	db->trie = trie_create(NULL);
 	if (db->trie == NULL) {
-		mp_delete(db->mm.ctx);
 		free(db);
 		return NULL;
 	}
@@ -67,6 +62,43 @@ knot_zonedb_t *knot_zonedb_new(void)
 	return db;
 }
 
+knot_zonedb_t *knot_zonedb_cow(knot_zonedb_t *db)
+{
+	if (db == NULL || db->cow != NULL) {
+		return NULL;
+	}
+
+	knot_zonedb_t *copy = calloc(1, sizeof(knot_zonedb_t));
+	if (copy == NULL) {
+		return NULL;
+	}
+
+	db->cow = trie_cow(db->trie, NULL, NULL);
+	if (db->cow == NULL) {
+		free(copy);
+		return NULL;
+	}
+
+	copy->cow = db->cow;
+	copy->trie = trie_cow_new(copy->cow);
+
+	return copy;
+}
+
+void knot_zonedb_cow_commit(knot_zonedb_t *db_new, knot_zonedb_t **db_old)
+{
+	if (db_new == NULL || db_old == NULL || *db_old == NULL) {
+		return;
+	}
+	assert(db_new->cow != NULL && db_new->cow == (*db_old)->cow);
+
+	db_new->trie = trie_cow_commit(db_new->cow, NULL, NULL);
+	db_new->cow = NULL;
+
+	free(*db_old);
+	*db_old = NULL;
+}
+
 int knot_zonedb_insert(knot_zonedb_t *db, zone_t *zone)
 {
 	if (db == NULL || zone == NULL) {
@@ -78,7 +110,12 @@ int knot_zonedb_insert(knot_zonedb_t *db, zone_t *zone)
 	uint8_t *lf = knot_dname_lf(zone->name, lf_storage);
 	assert(lf);
 
-	*trie_get_ins(db->trie, lf + 1, *lf) = zone;
+	trie_val_t *val = (db->cow != NULL) ? trie_get_cow(db->cow, lf + 1, *lf)
+	                                    : trie_get_ins(db->trie, lf + 1, *lf);
+	if (val == NULL) {
+		return KNOT_ENOMEM;
+	}
+	*val = zone;
 
 	return KNOT_EOK;
 }
@@ -98,6 +135,9 @@ int knot_zonedb_del(knot_zonedb_t *db, const knot_dname_t *zone_name)
 		return KNOT_ENOENT;
 	}
 
+	if (db->cow != NULL) {
+		return trie_del_cow(db->cow, lf + 1, *lf, NULL);
+	}
 	return trie_del(db->trie, lf + 1, *lf, NULL);
 }
 
@@ -159,6 +199,37 @@ zone_t *knot_zonedb_find_suffix(knot_zonedb_t *db, const knot_dname_t *zone_name
 	}
 }
 
+knot_zonedb_iter_t *knot_zonedb_iter_begin_after(knot_zonedb_t *db,
+                                                 const knot_dname_t *name)
+{
+	if (db == NULL || name == NULL) {
+		return NULL;
+	}
+
+	knot_dname_storage_t lf_storage;
+	uint8_t *lf = knot_dname_lf(name, lf_storage);
+	assert(lf);
+
+	knot_zonedb_iter_t *it = knot_zonedb_iter_begin(db);
+	if (it == NULL) {
+		return NULL;
+	}
+
+	int ret = trie_it_get_leq(it, lf + 1, *lf);
+	if (ret == KNOT_EOK || ret == 1) {
+		trie_it_next(it);
+	} else if (ret == KNOT_ENOENT) {
+		// All zones follow the name, start from the beginning.
+		trie_it_free(it);
+		it = knot_zonedb_iter_begin(db);
+	} else {
+		trie_it_free(it);
+		it = NULL;
+	}
+
+	return it;
+}
+
 size_t knot_zonedb_size(const knot_zonedb_t *db)
 {
 	if (db == NULL) {
@@ -174,7 +245,7 @@ void knot_zonedb_free(knot_zonedb_t **db)
 		return;
 	}
 
-	mp_delete((*db)->mm.ctx);
+	trie_free((*db)->trie);
 	free(*db);
 	*db = NULL;
 }
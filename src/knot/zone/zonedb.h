@@ -28,7 +28,7 @@
 
 struct knot_zonedb {
 	trie_t *trie;
-	knot_mm_t mm;
+	trie_cow_t *cow; //!< Shared COW context if being modified as a copy.
 };
 
 /*
@@ -41,6 +41,17 @@ typedef trie_it_t knot_zonedb_iter_t;
 #define knot_zonedb_iter_free(it) trie_it_free(it)
 #define knot_zonedb_iter_val(it) *trie_it_val(it)
 
+/*!
+ * \brief Starts iteration over the zones following the given zone name.
+ *
+ * \param db    Zone database.
+ * \param name  Zone name to start after.
+ *
+ * \return Iterator or NULL if failed.
+ */
+knot_zonedb_iter_t *knot_zonedb_iter_begin_after(knot_zonedb_t *db,
+                                                 const knot_dname_t *name);
+
 /*
  * Simple foreach() access with callback and variable number of callback params.
  */
@@ -62,6 +73,32 @@ typedef trie_it_t knot_zonedb_iter_t;
  */
 knot_zonedb_t *knot_zonedb_new(void);
 
+/*!
+ * \brief Creates a copy-on-write clone of the zone database.
+ *
+ * The clone shares the zones and unchanged parts of the lookup structure with
+ * the original database, which remains readable until the changes are
+ * committed by knot_zonedb_cow_commit(). Only one clone may exist at a time.
+ *
+ * \param db  Zone database to be cloned.
+ *
+ * \return Pointer to the cloned database or NULL if an error occurred.
+ */
+knot_zonedb_t *knot_zonedb_cow(knot_zonedb_t *db);
+
+/*!
+ * \brief Finishes the copy-on-write modification of the zone database.
+ *
+ * Releases the parts of the lookup structure no longer used by the clone
+ * and the original database structure (but not the zones within).
+ *
+ * \note Must be called after all readers of the original database finished.
+ *
+ * \param db_new  Modified clone of the zone database.
+ * \param db_old  Original zone database to be destroyed.
+ */
+void knot_zonedb_cow_commit(knot_zonedb_t *db_new, knot_zonedb_t **db_old);
+
 /*!
  * \brief Adds new zone to the database.
  *
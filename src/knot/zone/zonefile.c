@@ -19,6 +19,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <strings.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <time.h>
@@ -27,6 +29,8 @@
 
 #include "libknot/libknot.h"
 #include "contrib/files.h"
+#include "contrib/macros.h"
+#include "contrib/openbsd/siphash.h"
 #include "knot/common/log.h"
 #include "knot/dnssec/zone-nsec.h"
 #include "knot/zone/semantic-check.h"
@@ -186,6 +190,7 @@ int zonefile_open(zloader_t *loader, const char *source,
 	loader->creator = zc;
 	loader->semantic_checks = semantic_checks;
 	loader->time = time;
+	loader->threads = 1;
 
 	return KNOT_EOK;
 }
@@ -235,7 +240,7 @@ zone_contents_t *zonefile_load(zloader_t *loader)
 	}
 
 	ret = sem_checks_process(zc->z, loader->semantic_checks,
-	                         loader->err_handler, loader->time);
+	                         loader->err_handler, loader->time, loader->threads);
 
 	if (ret != KNOT_EOK) {
 		ERROR(zname, "failed to load zone, file '%s' (%s)",
@@ -278,7 +283,82 @@ int zonefile_exists(const char *path, struct timespec *mtime)
 	return KNOT_EOK;
 }
 
-int zonefile_write(const char *path, zone_contents_t *zone)
+#define FINGERPRINT_BLOCK	(64 * 1024)
+#define INCLUDE_DIRECTIVE	"$INCLUDE"
+#define INCLUDE_LEN		(sizeof(INCLUDE_DIRECTIVE) - 1)
+
+static bool has_include(const char *data, size_t len)
+{
+	for (size_t i = 0; i + INCLUDE_LEN <= len; i++) {
+		if (data[i] == '$' &&
+		    strncasecmp(data + i, INCLUDE_DIRECTIVE, INCLUDE_LEN) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int zonefile_fingerprint(const char *path, uint64_t *size, uint64_t *hash)
+{
+	if (path == NULL || size == NULL || hash == NULL) {
+		return KNOT_EINVAL;
+	}
+
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return knot_map_errno();
+	}
+
+	// The buffer is prefixed with the end of the previous block so that
+	// a directive split between two blocks is found too.
+	char *buf = malloc(INCLUDE_LEN + FINGERPRINT_BLOCK);
+	if (buf == NULL) {
+		close(fd);
+		return KNOT_ENOMEM;
+	}
+
+	// Just a change detection, the key doesn't need to be secret.
+	const SIPHASH_KEY key = { 0 };
+	SIPHASH_CTX ctx;
+	SipHash24_Init(&ctx, &key);
+
+	int ret = KNOT_EOK;
+	uint64_t total = 0;
+	bool include = false;
+	size_t carry = 0;
+	while (true) {
+		ssize_t len = read(fd, buf + carry, FINGERPRINT_BLOCK);
+		if (len < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			ret = knot_map_errno();
+			break;
+		} else if (len == 0) {
+			break;
+		}
+
+		SipHash24_Update(&ctx, buf + carry, len);
+		total += len;
+
+		size_t avail = carry + len;
+		include = include || has_include(buf, avail);
+		carry = MIN(avail, INCLUDE_LEN - 1);
+		memmove(buf, buf + avail - carry, carry);
+	}
+
+	free(buf);
+	close(fd);
+
+	if (ret == KNOT_EOK) {
+		*size = total;
+		*hash = include ? 0 : SipHash24_End(&ctx);
+	}
+
+	return ret;
+}
+
+int zonefile_write(const char *path, zone_contents_t *zone, size_t threads)
 {
 	if (!zone || !path) {
 		return KNOT_EINVAL;
@@ -296,7 +376,7 @@ int zonefile_write(const char *path, zone_contents_t *zone)
 		return ret;
 	}
 
-	ret = zone_dump_text(zone, file, true);
+	ret = zone_dump_text(zone, file, true, threads);
 	fclose(file);
 	if (ret != KNOT_EOK) {
 		unlink(tmp_name);
@@ -41,6 +41,7 @@ typedef struct {
 	zcreator_t *creator;         /*!< Loader context. */
 	zs_scanner_t scanner;        /*!< Zone scanner. */
 	time_t time;                 /*!< time for zone check. */
+	size_t threads;              /*!< Number of zone check threads. */
 } zloader_t;
 
 void err_handler_logger(sem_handler_t *handler, const zone_contents_t *zone,
@@ -82,9 +83,23 @@ zone_contents_t *zonefile_load(zloader_t *loader);
 int zonefile_exists(const char *path, struct timespec *mtime);
 
 /*!
- * \brief Write zone contents to zone file.
+ * \brief Computes zonefile size and contents hash for change detection.
+ *
+ * \note The hash is 0 if the zonefile contains an $INCLUDE directive, as
+ *       changes in the included files can't be detected.
+ *
+ * \param path  Zonefile path.
+ * \param size  Output zonefile size.
+ * \param hash  Output zonefile contents hash.
+ *
+ * \return KNOT_E*
+ */
+int zonefile_fingerprint(const char *path, uint64_t *size, uint64_t *hash);
+
+/*!
+ * \brief Write zone contents to zone file, rendered by given number of threads.
  */
-int zonefile_write(const char *path, zone_contents_t *zone);
+int zonefile_write(const char *path, zone_contents_t *zone, size_t threads);
 
 /*!
  * \brief Close zone file loader.
@@ -58,6 +58,10 @@ struct knot_ctl {
 
 	/*! The latter read data. */
 	knot_ctl_data_t data;
+	/*! The latter read bulk data. */
+	uint8_t *bulk;
+	/*! The latter read bulk data length. */
+	size_t bulk_len;
 
 	/*! Write wire context. */
 	wire_ctx_t wire_out;
@@ -77,6 +81,7 @@ static int type_to_code(knot_ctl_type_t type)
 	case KNOT_CTL_TYPE_DATA:  return  1;
 	case KNOT_CTL_TYPE_EXTRA: return  2;
 	case KNOT_CTL_TYPE_BLOCK: return  3;
+	case KNOT_CTL_TYPE_BULK:  return  4;
 	default:                  return -1;
 	}
 }
@@ -88,6 +93,7 @@ static int code_to_type(uint8_t code)
 	case 1:  return KNOT_CTL_TYPE_DATA;
 	case 2:  return KNOT_CTL_TYPE_EXTRA;
 	case 3:  return KNOT_CTL_TYPE_BLOCK;
+	case 4:  return KNOT_CTL_TYPE_BULK;
 	default: return -1;
 	}
 }
@@ -132,6 +138,8 @@ static void clean_data(knot_ctl_t *ctx)
 {
 	mp_flush(ctx->mm.ctx);
 	memzero(ctx->data, sizeof(ctx->data));
+	ctx->bulk = NULL;
+	ctx->bulk_len = 0;
 }
 
 static void close_sock(int *sock)
@@ -268,6 +276,25 @@ int knot_ctl_accept(knot_ctl_t *ctx)
 	return KNOT_EOK;
 }
 
+_public_
+knot_ctl_t* knot_ctl_clone(knot_ctl_t *ctx)
+{
+	if (ctx == NULL || ctx->sock < 0) {
+		return NULL;
+	}
+
+	knot_ctl_t *res = knot_ctl_alloc();
+	if (res == NULL) {
+		return NULL;
+	}
+
+	res->timeout = ctx->timeout;
+	res->sock = ctx->sock;
+	ctx->sock = -1;
+
+	return res;
+}
+
 _public_
 int knot_ctl_connect(knot_ctl_t *ctx, const char *path)
 {
@@ -391,7 +418,7 @@ int knot_ctl_send(knot_ctl_t *ctx, knot_ctl_type_t type, knot_ctl_data_t *data)
 
 	// Get the type code.
 	int code = type_to_code(type);
-	if (code == -1) {
+	if (code == -1 || type == KNOT_CTL_TYPE_BULK) {
 		return KNOT_EINVAL;
 	}
 
@@ -420,6 +447,36 @@ int knot_ctl_send(knot_ctl_t *ctx, knot_ctl_type_t type, knot_ctl_data_t *data)
 	return KNOT_EOK;
 }
 
+_public_
+int knot_ctl_send_bulk(knot_ctl_t *ctx, const uint8_t *bulk, size_t len)
+{
+	if (ctx == NULL || (bulk == NULL && len > 0) || len > KNOT_CTL_BULK_MAX) {
+		return KNOT_EINVAL;
+	}
+
+	wire_ctx_t *w = &ctx->wire_out;
+
+	// Write the unit type and the bulk length.
+	int ret = ensure_output(ctx, sizeof(uint8_t) + sizeof(uint16_t));
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+	wire_ctx_write_u8(w, type_to_code(KNOT_CTL_TYPE_BULK));
+	wire_ctx_write_u16(w, len);
+	if (w->error != KNOT_EOK) {
+		return w->error;
+	}
+
+	// Write the bulk data.
+	ret = ensure_output(ctx, len);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+	wire_ctx_write(w, bulk, len);
+
+	return w->error;
+}
+
 static int ensure_input(knot_ctl_t *ctx, uint16_t len)
 {
 	wire_ctx_t *w = &ctx->wire_in;
@@ -467,7 +524,7 @@ static int receive_item_code(knot_ctl_t *ctx, uint8_t *code)
 	return KNOT_EOK;
 }
 
-static int receive_item_value(knot_ctl_t *ctx, char **value)
+static int receive_item_value(knot_ctl_t *ctx, char **value, size_t *len)
 {
 	wire_ctx_t *w = &ctx->wire_in;
 
@@ -496,6 +553,10 @@ static int receive_item_value(knot_ctl_t *ctx, char **value)
 	}
 	(*value)[data_len] = '\0';
 
+	if (len != NULL) {
+		*len = data_len;
+	}
+
 	return KNOT_EOK;
 }
 
@@ -534,7 +595,14 @@ int knot_ctl_receive(knot_ctl_t *ctx, knot_ctl_type_t *type, knot_ctl_data_t *da
 			// Set the unit type.
 			*type = current_type;
 
-			if (is_data_type(current_type)) {
+			if (current_type == KNOT_CTL_TYPE_BULK) {
+				ret = receive_item_value(ctx, (char **)&ctx->bulk,
+				                         &ctx->bulk_len);
+				if (ret != KNOT_EOK) {
+					return ret;
+				}
+				break;
+			} else if (is_data_type(current_type)) {
 				have_type = true;
 				continue;
 			} else {
@@ -549,7 +617,7 @@ int knot_ctl_receive(knot_ctl_t *ctx, knot_ctl_type_t *type, knot_ctl_data_t *da
 		}
 
 		// Store the item data value.
-		ret = receive_item_value(ctx, (char **)&ctx->data[idx]);
+		ret = receive_item_value(ctx, (char **)&ctx->data[idx], NULL);
 		if (ret != KNOT_EOK) {
 			return ret;
 		}
@@ -562,3 +630,15 @@ int knot_ctl_receive(knot_ctl_t *ctx, knot_ctl_type_t *type, knot_ctl_data_t *da
 
 	return KNOT_EOK;
 }
+
+_public_
+const uint8_t *knot_ctl_bulk(knot_ctl_t *ctx, size_t *len)
+{
+	if (ctx == NULL || len == NULL || ctx->bulk == NULL) {
+		return NULL;
+	}
+
+	*len = ctx->bulk_len;
+
+	return ctx->bulk;
+}
@@ -25,6 +25,9 @@
 
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 /*! Control data item indexes. */
 typedef enum {
 	KNOT_CTL_IDX_CMD = 0, /*!< Control command name. */
@@ -48,8 +51,12 @@ typedef enum {
 	KNOT_CTL_TYPE_DATA,  /*!< Data unit, cached. */
 	KNOT_CTL_TYPE_EXTRA, /*!< Extra value data unit, cached. */
 	KNOT_CTL_TYPE_BLOCK, /*!< End of data block, cache flushed. */
+	KNOT_CTL_TYPE_BULK,  /*!< Binary bulk data unit, cached. */
 } knot_ctl_type_t;
 
+/*! Maximum length of the bulk unit payload. */
+#define KNOT_CTL_BULK_MAX	UINT16_MAX
+
 /*! Control input/output string data. */
 typedef const char* knot_ctl_data_t[KNOT_CTL_IDX__COUNT];
 
@@ -125,6 +132,20 @@ int knot_ctl_connect(knot_ctl_t *ctx, const char *path);
  */
 int knot_ctl_accept(knot_ctl_t *ctx);
 
+/*!
+ * Moves the accepted connection to a new control context.
+ *
+ * The original context stays bound and can accept another connection, while
+ * the new one is used for the communication with the accepted client.
+ *
+ * \note Server operation.
+ *
+ * \param[in] ctx  Control context with an accepted connection.
+ *
+ * \return New control context or NULL if failed.
+ */
+knot_ctl_t* knot_ctl_clone(knot_ctl_t *ctx);
+
 /*!
  * Closes the remote connections.
  *
@@ -156,4 +177,27 @@ int knot_ctl_send(knot_ctl_t *ctx, knot_ctl_type_t type, knot_ctl_data_t *data);
  */
 int knot_ctl_receive(knot_ctl_t *ctx, knot_ctl_type_t *type, knot_ctl_data_t *data);
 
+/*!
+ * Sends one binary bulk unit.
+ *
+ * \param[in] ctx   Control context.
+ * \param[in] bulk  Bulk data to send.
+ * \param[in] len   Bulk data length (at most KNOT_CTL_BULK_MAX).
+ *
+ * \return Error code, KNOT_EOK if successful.
+ */
+int knot_ctl_send_bulk(knot_ctl_t *ctx, const uint8_t *bulk, size_t len);
+
+/*!
+ * Returns the payload of the latter received bulk unit.
+ *
+ * \note The payload is valid until the next receive operation.
+ *
+ * \param[in] ctx   Control context.
+ * \param[out] len  Bulk data length.
+ *
+ * \return Bulk data or NULL if the latter received unit is not a bulk one.
+ */
+const uint8_t *knot_ctl_bulk(knot_ctl_t *ctx, size_t *len);
+
 /*! @} */
@@ -227,9 +227,11 @@ char *knot_dname_to_str(char *dst, const knot_dname_t *name, size_t maxlen)
 
 	size_t dname_size = knot_dname_size(name);
 
-	/* Check the size for len(dname) + 1 char termination. */
+	/* Check the size for the shortest string with termination. Label lengths
+	   turn into dots, the root dname is a single dot. */
+	size_t min_size = (dname_size == 1) ? 2 : dname_size;
 	size_t alloc_size = (dst == NULL) ? dname_size + 1 : maxlen;
-	if (alloc_size < dname_size + 1) {
+	if (alloc_size < min_size) {
 		return NULL;
 	}
 
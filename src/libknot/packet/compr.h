@@ -27,6 +27,7 @@
 
 #include <stdint.h>
 
+#include "libknot/mm_ctx.h"
 #include "libknot/packet/wire.h"
 
 /*! \brief Compression hint type. */
@@ -63,6 +64,28 @@ typedef struct {
 	uint16_t compress_ptr[KNOT_COMPR_HINT_COUNT]; /* Array of compr. ptr hints. */
 } knot_rrinfo_t;
 
+/*! \brief Written name suffix stored in the compression table. */
+typedef struct {
+	uint32_t hash; /* Case-insensitive hash of the suffix. */
+	uint16_t pos;  /* Position of the suffix in the packet. */
+} knot_compr_item_t;
+
+/*!
+ * \brief Compression table of written name suffixes.
+ *
+ * Each suffix of each compressible name written to the packet is stored,
+ * so that the longest matching suffix can be found in O(labels) instead of
+ * comparing with the recently written names only. The items are kept in the
+ * insertion order, which allows discarding items of an RRSet that didn't fit.
+ */
+typedef struct {
+	knot_mm_t *mm;             /* Memory context for the arrays. */
+	knot_compr_item_t *items;  /* Stored suffixes in the insertion order. */
+	uint16_t *index;           /* Hash index, item position + 1 (0 = empty). */
+	uint16_t count;            /* Number of stored items. */
+	uint16_t capacity;         /* Capacity of items, index is twice as big. */
+} knot_compr_table_t;
+
 /*!
  * \brief Name compression context.
  */
@@ -73,6 +96,7 @@ typedef struct knot_compr {
 		uint16_t pos;   /* Position of current suffix. */
 		uint8_t labels; /* Label count of the suffix. */
 	} suffix;
+	knot_compr_table_t *table; /* Written suffixes (optional). */
 } knot_compr_t;
 
 /*!
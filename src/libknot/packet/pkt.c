@@ -176,6 +176,23 @@ static void compr_clear(knot_compr_t *compr)
 	compr->rrinfo = NULL;
 	compr->suffix.pos = 0;
 	compr->suffix.labels = 0;
+
+	knot_compr_table_t *table = compr->table;
+	if (table != NULL && table->count > 0) {
+		memset(table->index, 0, 2 * table->capacity * sizeof(*table->index));
+		table->count = 0;
+	}
+}
+
+static void compr_table_free(knot_compr_table_t *table)
+{
+	if (table == NULL) {
+		return;
+	}
+
+	mm_free(table->mm, table->items);
+	mm_free(table->mm, table->index);
+	mm_free(table->mm, table);
 }
 
 /*! \brief Clear the packet and switch wireformat pointers (possibly allocate new). */
@@ -392,6 +409,9 @@ void knot_pkt_free(knot_pkt_t *pkt)
 	mm_free(&pkt->mm, pkt->rr);
 	mm_free(&pkt->mm, pkt->rr_info);
 
+	/* Free compression table. */
+	compr_table_free(pkt->compr.table);
+
 	/* Free the space for wireformat. */
 	if (pkt->flags & KNOT_PF_FREE) {
 		mm_free(&pkt->mm, pkt->wire);
@@ -449,6 +469,31 @@ int knot_pkt_begin(knot_pkt_t *pkt, knot_section_t section_id)
 	return KNOT_EOK;
 }
 
+_public_
+int knot_pkt_init_compr_table(knot_pkt_t *pkt)
+{
+	if (pkt == NULL) {
+		return KNOT_EINVAL;
+	}
+
+	/* Already enabled. */
+	if (pkt->compr.table != NULL) {
+		return KNOT_EOK;
+	}
+
+	/* Arrays are allocated with the first stored suffix. */
+	knot_compr_table_t *table = mm_alloc(&pkt->mm, sizeof(*table));
+	if (table == NULL) {
+		return KNOT_ENOMEM;
+	}
+	memset(table, 0, sizeof(*table));
+	table->mm = &pkt->mm;
+
+	pkt->compr.table = table;
+
+	return KNOT_EOK;
+}
+
 _public_
 int knot_pkt_put_question(knot_pkt_t *pkt, const knot_dname_t *qname, uint16_t qclass, uint16_t qtype)
 {
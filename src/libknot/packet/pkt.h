@@ -220,6 +220,19 @@ static inline uint16_t knot_pkt_qclass(const knot_pkt_t *pkt)
  */
 int knot_pkt_begin(knot_pkt_t *pkt, knot_section_t section_id);
 
+/*!
+ * \brief Enable the compression table for the packet.
+ *
+ * The table stores all written name suffixes, so every name gets the best
+ * compression pointer available. It's intended for large responses (e.g.
+ * zone transfers), as it has some memory and setup overhead. The table
+ * is kept across packet clearing and freed along with the packet.
+ *
+ * \param pkt
+ * \return KNOT_EOK, KNOT_ENOMEM, KNOT_EINVAL
+ */
+int knot_pkt_init_compr_table(knot_pkt_t *pkt);
+
 /*!
  * \brief Put QUESTION in the packet.
  *
@@ -166,6 +166,222 @@ static int write_rdata_naptr_header(const uint8_t **src, size_t *src_avail,
 		written += (len); \
 	}
 
+#define COMPR_TABLE_MIN	256
+#define COMPR_TABLE_MAX	((KNOT_WIRE_PTR_MAX + 1) / 2)
+
+/*! \brief Extends the case-insensitive hash of a suffix with a preceding label. */
+static uint32_t compr_label_hash(uint32_t hash, const uint8_t *label)
+{
+	uint8_t len = *label;
+	hash = (hash ^ len) * 16777619U;
+	for (uint8_t i = 1; i <= len; i++) {
+		hash = (hash ^ knot_tolower(label[i])) * 16777619U;
+	}
+
+	return hash;
+}
+
+static uint16_t compr_table_slot(const knot_compr_table_t *table, uint32_t hash)
+{
+	return (hash ^ (hash >> 16)) & (2 * table->capacity - 1);
+}
+
+static void compr_table_index(knot_compr_table_t *table, uint16_t id)
+{
+	uint16_t mask = 2 * table->capacity - 1;
+	uint16_t slot = compr_table_slot(table, table->items[id].hash);
+	while (table->index[slot] != 0) {
+		slot = (slot + 1) & mask;
+	}
+	table->index[slot] = id + 1;
+}
+
+static bool compr_table_grow(knot_compr_table_t *table)
+{
+	if (table->capacity >= COMPR_TABLE_MAX) {
+		return false;
+	}
+
+	uint16_t capacity = MAX(COMPR_TABLE_MIN, 2 * table->capacity);
+	knot_compr_item_t *items = mm_alloc(table->mm, capacity * sizeof(*items));
+	uint16_t *index = mm_alloc(table->mm, 2 * capacity * sizeof(*index));
+	if (items == NULL || index == NULL) {
+		mm_free(table->mm, items);
+		mm_free(table->mm, index);
+		return false;
+	}
+
+	if (table->count > 0) {
+		memcpy(items, table->items, table->count * sizeof(*items));
+	}
+	memset(index, 0, 2 * capacity * sizeof(*index));
+
+	mm_free(table->mm, table->items);
+	mm_free(table->mm, table->index);
+	table->items = items;
+	table->index = index;
+	table->capacity = capacity;
+
+	// Re-index in the insertion order to keep rollback possible.
+	for (uint16_t id = 0; id < table->count; id++) {
+		compr_table_index(table, id);
+	}
+
+	return true;
+}
+
+static void compr_table_add(knot_compr_table_t *table, uint32_t hash, uint16_t pos)
+{
+	if (pos >= KNOT_WIRE_PTR_MAX) {
+		return;
+	}
+	if (table->count == table->capacity && !compr_table_grow(table)) {
+		return;
+	}
+
+	table->items[table->count].hash = hash;
+	table->items[table->count].pos = pos;
+	compr_table_index(table, table->count);
+	table->count++;
+}
+
+/*!
+ * \brief Removes the items stored after the table had given number of items.
+ *
+ * \note Removing in the reverse insertion order keeps the probe sequences
+ *       of the remaining items intact.
+ */
+static void compr_table_rollback(knot_compr_table_t *table, uint16_t count)
+{
+	uint16_t mask = 2 * table->capacity - 1;
+	while (table->count > count) {
+		uint16_t id = --table->count;
+		uint16_t slot = compr_table_slot(table, table->items[id].hash);
+		while (table->index[slot] != id + 1) {
+			slot = (slot + 1) & mask;
+		}
+		table->index[slot] = 0;
+	}
+}
+
+/*! \brief Finds position of a written suffix equal to the given one (or 0). */
+static uint16_t compr_table_find(const knot_compr_table_t *table, const uint8_t *wire,
+                                 const knot_dname_t *suffix, uint32_t hash)
+{
+	if (table->count == 0) {
+		return 0;
+	}
+
+	uint16_t mask = 2 * table->capacity - 1;
+	for (uint16_t slot = compr_table_slot(table, hash); table->index[slot] != 0;
+	     slot = (slot + 1) & mask) {
+		const knot_compr_item_t *item = &table->items[table->index[slot] - 1];
+		if (item->hash == hash && dname_equal_wire(suffix, wire + item->pos, wire)) {
+			return item->pos;
+		}
+	}
+
+	return 0;
+}
+
+/*!
+ * \brief Stores all suffixes of a name written in the wire (possibly compressed).
+ */
+static void compr_table_add_wire(knot_compr_table_t *table, const uint8_t *wire,
+                                 uint16_t pos)
+{
+	uint16_t positions[KNOT_DNAME_MAXLABELS];
+	size_t count = 0;
+	const uint8_t *label = knot_wire_seek_label(wire + pos, wire);
+	while (*label != '\0' && count < KNOT_DNAME_MAXLABELS) {
+		positions[count++] = label - wire;
+		label = knot_wire_next_label(label, wire);
+	}
+
+	uint32_t hash = 0;
+	while (count-- > 0) {
+		hash = compr_label_hash(hash, wire + positions[count]);
+		if (compr_table_find(table, wire, wire + positions[count], hash) == 0) {
+			compr_table_add(table, hash, positions[count]);
+		}
+	}
+}
+
+/*!
+ * \brief Write domain name using the longest suffix found in the compression table.
+ *
+ * \param dname  Name to be written.
+ * \param dst    Destination wire.
+ * \param max    Maximum number of bytes available.
+ * \param compr  Compression context with a table.
+ * \return Number of written bytes or an error.
+ */
+static int compr_table_put_dname(const knot_dname_t *dname, uint8_t *dst,
+                                 uint16_t max, knot_compr_t *compr)
+{
+	knot_compr_table_t *table = compr->table;
+
+	// Names in the question are always available for compression.
+	if (table->count == 0) {
+		compr_table_add_wire(table, compr->wire, KNOT_WIRE_HEADER_SIZE);
+	}
+
+	// Compute hashes of all name suffixes, starting from the shortest one.
+	const knot_dname_t *labels[KNOT_DNAME_MAXLABELS];
+	uint32_t hashes[KNOT_DNAME_MAXLABELS];
+	size_t name_labels = 0;
+	for (const knot_dname_t *it = dname; *it != '\0';
+	     it = knot_wire_next_label(it, NULL)) {
+		labels[name_labels++] = it;
+	}
+	uint32_t hash = 0;
+	for (size_t i = name_labels; i-- > 0; ) {
+		hash = compr_label_hash(hash, labels[i]);
+		hashes[i] = hash;
+	}
+
+	// Find the longest suffix already written.
+	size_t match = name_labels;
+	uint16_t match_pos = 0;
+	for (size_t i = 0; i < name_labels; i++) {
+		match_pos = compr_table_find(table, compr->wire, labels[i], hashes[i]);
+		if (match_pos != 0) {
+			match = i;
+			break;
+		}
+	}
+
+	// Write the unmatched labels and either the pointer or the root label.
+	uint16_t written = 0;
+	if (match_pos != 0) {
+		WRITE_LABEL(dst, written, dname, max, labels[match] - dname);
+		if (written + sizeof(uint16_t) > max) {
+			return KNOT_ESPACE;
+		}
+		knot_wire_put_pointer(dst + written, match_pos);
+		written += sizeof(uint16_t);
+	} else {
+		WRITE_LABEL(dst, written, dname, max, knot_dname_size(dname));
+	}
+
+	assert(dst >= compr->wire);
+	size_t wire_pos = dst - compr->wire;
+	assert(wire_pos < KNOT_WIRE_MAX_PKTSIZE);
+
+	// Store the newly written suffixes.
+	for (size_t i = 0; i < match; i++) {
+		compr_table_add(table, hashes[i], wire_pos + (labels[i] - dname));
+	}
+
+	// Keep the heuristics of the owner coincidence check working.
+	if (written > sizeof(uint16_t) && wire_pos + written < KNOT_WIRE_PTR_MAX) {
+		compr->suffix.pos = wire_pos;
+		compr->suffix.labels = name_labels;
+	}
+
+	return written;
+}
+
 /*!
  * \brief Write compressed domain name to the destination wire.
  *
@@ -185,6 +401,10 @@ static int compr_put_dname(const knot_dname_t *dname, uint8_t *dst, uint16_t max
 		return knot_dname_to_wire(dst, dname, max);
 	}
 
+	if (compr->table != NULL) {
+		return compr_table_put_dname(dname, dst, max, compr);
+	}
+
 	// Get number of labels (should not be a zero label dname).
 	size_t name_labels = knot_dname_labels(dname, NULL);
 	assert(name_labels > 0);
@@ -501,11 +721,26 @@ int knot_rrset_to_wire_extra(const knot_rrset_t *rrset, uint8_t *wire,
 	uint8_t *write = wire;
 	size_t capacity = max_size;
 
+	// Names of a partially written RRSet must not be used for compression.
+	uint16_t table_count = 0;
+	if (compr != NULL && compr->table != NULL) {
+		table_count = compr->table->count;
+	}
+	uint16_t suffix_pos = (compr != NULL) ? compr->suffix.pos : 0;
+	uint8_t suffix_labels = (compr != NULL) ? compr->suffix.labels : 0;
+
 	uint16_t count = rrset->rrs.count;
 	for (uint16_t i = rotate; i < count + rotate; i++) {
 		uint16_t pos = (i < count) ? i : (i - count);
 		int ret = write_rr(rrset, pos, &write, &capacity, compr, flags);
 		if (ret != KNOT_EOK) {
+			if (compr != NULL) {
+				compr->suffix.pos = suffix_pos;
+				compr->suffix.labels = suffix_labels;
+			}
+			if (compr != NULL && compr->table != NULL) {
+				compr_table_rollback(compr->table, table_count);
+			}
 			return ret;
 		}
 	}
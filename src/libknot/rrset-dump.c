@@ -110,6 +110,35 @@ static void dump_string(rrset_dump_params_t *p, const char *str)
 	p->total += in_len;
 }
 
+/*!
+ * \brief Writes decimal representation of the number including termination.
+ *
+ * This is a snprintf-free equivalent of "%"PRIu64 for the hot paths.
+ *
+ * \retval Number of written characters (without termination).
+ * \retval -1 if the output buffer is too small.
+ */
+static int num_to_str(char *out, size_t out_max, uint64_t num)
+{
+	char buf[20]; // Max uint64_t length.
+	char *pos = buf + sizeof(buf);
+
+	do {
+		*--pos = '0' + (num % 10);
+		num /= 10;
+	} while (num > 0);
+
+	size_t len = buf + sizeof(buf) - pos;
+	if (len >= out_max) {
+		return -1;
+	}
+
+	memcpy(out, pos, len);
+	out[len] = '\0';
+
+	return len;
+}
+
 static void wire_num8_to_str(rrset_dump_params_t *p)
 {
 	CHECK_PRET
@@ -121,8 +150,8 @@ static void wire_num8_to_str(rrset_dump_params_t *p)
 	CHECK_INMAX(in_len)
 
 	// Write number.
-	int ret = snprintf(p->out, p->out_max, "%u", data);
-	CHECK_RET_OUTMAX_SNPRINTF
+	int ret = num_to_str(p->out, p->out_max, data);
+	CHECK_RET_POSITIVE
 	out_len = ret;
 
 	// Fill in output.
@@ -147,8 +176,8 @@ static void wire_num16_to_str(rrset_dump_params_t *p)
 	data = knot_wire_read_u16(p->in);
 
 	// Write number.
-	int ret = snprintf(p->out, p->out_max, "%u", data);
-	CHECK_RET_OUTMAX_SNPRINTF
+	int ret = num_to_str(p->out, p->out_max, data);
+	CHECK_RET_POSITIVE
 	out_len = ret;
 
 	// Fill in output.
@@ -173,8 +202,8 @@ static void wire_num32_to_str(rrset_dump_params_t *p)
 	data = knot_wire_read_u32(p->in);
 
 	// Write number.
-	int ret = snprintf(p->out, p->out_max, "%u", data);
-	CHECK_RET_OUTMAX_SNPRINTF
+	int ret = num_to_str(p->out, p->out_max, data);
+	CHECK_RET_POSITIVE
 	out_len = ret;
 
 	// Fill in output.
@@ -199,8 +228,8 @@ static void wire_num48_to_str(rrset_dump_params_t *p)
 	data = knot_wire_read_u48(p->in);
 
 	// Write number.
-	int ret = snprintf(p->out, p->out_max, "%"PRIu64"", data);
-	CHECK_RET_OUTMAX_SNPRINTF
+	int ret = num_to_str(p->out, p->out_max, data);
+	CHECK_RET_POSITIVE
 	out_len = ret;
 
 	// Fill in output.
@@ -215,20 +244,24 @@ static void wire_ipv4_to_str(rrset_dump_params_t *p)
 {
 	CHECK_PRET
 
-	struct in_addr addr4;
-	size_t in_len = sizeof(addr4.s_addr);
+	size_t in_len = sizeof(struct in_addr);
 	size_t out_len = 0;
 
 	CHECK_INMAX(in_len)
 
-	FILL_IN_INPUT(addr4.s_addr)
-
-	// Write address.
-	if (inet_ntop(AF_INET, &addr4, p->out, p->out_max) == NULL) {
-		p->ret = -1;
-		return;
+	// Write address (dotted quad, same as inet_ntop but without its overhead).
+	for (size_t i = 0; i < in_len; i++) {
+		if (i > 0) {
+			if (out_len + 1 >= p->out_max) {
+				p->ret = -1;
+				return;
+			}
+			p->out[out_len++] = '.';
+		}
+		int ret = num_to_str(p->out + out_len, p->out_max - out_len, p->in[i]);
+		CHECK_RET_POSITIVE
+		out_len += ret;
 	}
-	out_len = strlen(p->out);
 
 	// Fill in output.
 	p->in += in_len;
@@ -283,9 +316,12 @@ static void wire_type_to_str(rrset_dump_params_t *p)
 	CHECK_RET_POSITIVE
 
 	// Write string.
-	ret = snprintf(p->out, p->out_max, "%s", type);
-	CHECK_RET_OUTMAX_SNPRINTF
 	out_len = ret;
+	if (out_len >= p->out_max) {
+		p->ret = -1;
+		return;
+	}
+	memcpy(p->out, type, out_len + 1);
 
 	// Fill in output.
 	p->in += in_len;
@@ -681,8 +717,8 @@ static void wire_timestamp_to_str(rrset_dump_params_t *p)
 		CHECK_RET_POSITIVE
 	} else {
 		// Write timestamp only.
-		ret = snprintf(p->out, p->out_max, "%u", ntohl(data));
-		CHECK_RET_OUTMAX_SNPRINTF
+		ret = num_to_str(p->out, p->out_max, ntohl(data));
+		CHECK_RET_POSITIVE
 	}
 	out_len = ret;
 
@@ -743,8 +779,8 @@ static void wire_ttl_to_str(rrset_dump_params_t *p)
 		CHECK_RET_POSITIVE
 	} else {
 		// Write timestamp only.
-		ret = snprintf(p->out, p->out_max, "%u", ntohl(data));
-		CHECK_RET_OUTMAX_SNPRINTF
+		ret = num_to_str(p->out, p->out_max, ntohl(data));
+		CHECK_RET_POSITIVE
 	}
 	out_len = ret;
 
@@ -1965,14 +2001,23 @@ int knot_rrset_txt_dump_header(const knot_rrset_t      *rrset,
 	char   buf[32];
 	int    ret;
 
-	// Dump rrset owner.
-	char *name = knot_dname_to_str_alloc(rrset->owner);
-	if (style->ascii_to_idn != NULL) {
+	// Dump rrset owner (avoid the allocation if no IDN conversion).
+	knot_dname_txt_storage_t name_buf;
+	char *name;
+	if (style->ascii_to_idn == NULL) {
+		name = knot_dname_to_str(name_buf, rrset->owner, sizeof(name_buf));
+	} else {
+		name = knot_dname_to_str_alloc(rrset->owner);
 		style->ascii_to_idn(&name);
 	}
+	if (name == NULL) {
+		return KNOT_EINVAL;
+	}
 	char sep = strlen(name) < 4 * TAB_WIDTH ? '\t' : ' ';
 	ret = snprintf(dst + len, maxlen - len, "%-20s%c", name, sep);
-	free(name);
+	if (name != name_buf) {
+		free(name);
+	}
 	SNPRINTF_CHECK(ret, maxlen - len);
 	len += ret;
 
@@ -1991,7 +2036,12 @@ int knot_rrset_txt_dump_header(const knot_rrset_t      *rrset,
 			ret = snprintf(dst + len, maxlen - len, "%s%c",
 			               buf, sep);
 		} else {
-			ret = snprintf(dst + len, maxlen - len, "%u%c", ttl, sep);
+			ret = num_to_str(dst + len, maxlen - len, ttl);
+			if (ret < 0 || ret + 1 >= maxlen - len) {
+				return KNOT_ESPACE;
+			}
+			dst[len + ret++] = sep;
+			dst[len + ret] = '\0';
 		}
 		SNPRINTF_CHECK(ret, maxlen - len);
 		len += ret;
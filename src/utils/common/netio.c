@@ -565,7 +565,9 @@ int net_receive(const net_t *net, uint8_t *buf, const size_t buf_len)
 	// Receive data over TLS.
 	} else if (net->tls.params != NULL) {
 		int ret = tls_ctx_receive((tls_ctx_t *)&net->tls, buf, buf_len);
-		if (ret < 0) {
+		if (ret == KNOT_NET_ETIMEOUT) {
+			return ret;
+		} else if (ret < 0) {
 			WARN("can't receive reply from %s\n", net->remote_str);
 			return KNOT_NET_ERECV;
 		}
@@ -581,7 +583,8 @@ int net_receive(const net_t *net, uint8_t *buf, const size_t buf_len)
 			if (poll(&pfd, 1, 1000 * net->wait) != 1) {
 				WARN("response timeout for %s\n",
 				     net->remote_str);
-				return KNOT_NET_ETIMEOUT;
+				// The stream is out of sync after a partial read.
+				return (total > 0) ? KNOT_NET_ERECV : KNOT_NET_ETIMEOUT;
 			}
 
 			// Receive piece of message.
@@ -608,7 +611,8 @@ int net_receive(const net_t *net, uint8_t *buf, const size_t buf_len)
 			if (poll(&pfd, 1, 1000 * net->wait) != 1) {
 				WARN("response timeout for %s\n",
 				     net->remote_str);
-				return KNOT_NET_ETIMEOUT;
+				// The stream is out of sync after a partial read.
+				return KNOT_NET_ERECV;
 			}
 
 			// Receive piece of message.
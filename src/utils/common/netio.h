@@ -206,6 +206,9 @@ int net_send(const net_t *net, const uint8_t *buf, const size_t buf_len);
  * \param buf		Buffer for incoming data.
  * \param buf_len	Length of the buffer.
  *
+ * \note A timeout in the middle of a TCP or TLS message is reported as
+ *       KNOT_NET_ERECV, as the connection can't be used any more.
+ *
  * \retval >=0		length of successfully received data.
  * \retval errcode	if error.
  */
@@ -614,7 +614,8 @@ int tls_ctx_receive(tls_ctx_t *ctx, uint8_t *buf, const size_t buf_len)
 			return KNOT_NET_ERECV;
 		} else if (poll(&pfd, 1, 1000 * ctx->wait) != 1) {
 			WARN("TLS, peer took too long to respond\n");
-			return KNOT_NET_ETIMEOUT;
+			// The stream is out of sync after a partial read.
+			return (total > 0) ? KNOT_NET_ERECV : KNOT_NET_ETIMEOUT;
 		}
 	}
 
@@ -641,7 +642,8 @@ int tls_ctx_receive(tls_ctx_t *ctx, uint8_t *buf, const size_t buf_len)
 			return KNOT_NET_ERECV;
 		} else if (poll(&pfd, 1, 1000 * ctx->wait) != 1) {
 			WARN("TLS, peer took too long to respond\n");
-			return KNOT_NET_ETIMEOUT;
+			// The stream is out of sync after a partial read.
+			return KNOT_NET_ERECV;
 		}
 	}
 
@@ -14,8 +14,12 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <signal.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/time.h>
 
@@ -24,8 +28,12 @@
 #include "utils/common/msg.h"
 #include "utils/common/netio.h"
 #include "utils/common/sign.h"
+#include "libdnssec/random.h"
 #include "libknot/libknot.h"
+#include "contrib/getline.h"
+#include "contrib/macros.h"
 #include "contrib/sockaddr.h"
+#include "contrib/strtonum.h"
 #include "contrib/time.h"
 #include "contrib/ucw/lists.h"
 
@@ -1158,6 +1166,496 @@ static int process_xfr(const query_t *query)
 	return ret;
 }
 
+/*! \brief Number of extended (12-bit) RCODE values. */
+#define BATCH_RCODES	(1 << 12)
+
+/*! \brief Outstanding query in the batch mode. */
+typedef struct {
+	knot_pkt_t	*pkt;
+	sign_context_t	sign_ctx;
+	struct timespec	sent;
+	size_t		line;
+	int		exp_rcode;
+	uint32_t	retries;
+} batch_slot_t;
+
+/*! \brief Batch mode context and statistics. */
+typedef struct {
+	const query_t	*query;
+	net_t		*net;
+	FILE		*file;
+	size_t		line;
+	bool		eof;
+
+	batch_slot_t	*slots;
+	uint16_t	*id_slots; // Slot index for each message ID.
+	uint16_t	window;
+	uint16_t	active;
+
+	size_t		queries;
+	size_t		replies;
+	size_t		lost;
+	size_t		retries;
+	size_t		truncated;
+	size_t		mismatches;
+	size_t		unexpected;
+	size_t		invalid;
+	size_t		rcodes[BATCH_RCODES];
+
+	float		*times;
+	size_t		times_max;
+} batch_t;
+
+static const char *batch_slot_str(const batch_slot_t *slot, char *buf, size_t len)
+{
+	char name[KNOT_DNAME_TXT_MAXLEN + 1] = "";
+	(void)knot_dname_to_str(name, knot_pkt_qname(slot->pkt), sizeof(name));
+
+	char type[32] = "";
+	(void)knot_rrtype_to_string(knot_pkt_qtype(slot->pkt), type, sizeof(type));
+
+	(void)snprintf(buf, len, "line %zu, %s %s", slot->line, name, type);
+	return buf;
+}
+
+static void batch_slot_free(batch_t *batch, batch_slot_t *slot)
+{
+	knot_pkt_free(slot->pkt);
+	slot->pkt = NULL;
+	sign_context_deinit(&slot->sign_ctx);
+	batch->active--;
+}
+
+static int batch_parse_line(char *line, query_t *ctx, int *exp_rcode)
+{
+	char *saveptr = NULL;
+	char *token = strtok_r(line, " \t\r\n", &saveptr);
+	if (token == NULL || token[0] == ';' || token[0] == '#') {
+		return KNOT_ENOENT;
+	}
+	ctx->owner = token;
+
+	while ((token = strtok_r(NULL, " \t\r\n", &saveptr)) != NULL) {
+		uint16_t num;
+		if (token[0] == '=') {
+			const knot_lookup_t *rcode = knot_lookup_by_name(knot_rcode_names,
+			                                                 token + 1);
+			if (rcode != NULL) {
+				*exp_rcode = rcode->id;
+			} else if (str_to_u16(token + 1, &num) == KNOT_EOK &&
+			           num < BATCH_RCODES) {
+				*exp_rcode = num;
+			} else {
+				return KNOT_EINVAL;
+			}
+		} else if (knot_rrtype_from_string(token, &num) == 0) {
+			ctx->type_num = num;
+		} else if (knot_rrclass_from_string(token, &num) == 0) {
+			ctx->class_num = num;
+		} else {
+			return KNOT_EINVAL;
+		}
+	}
+
+	return KNOT_EOK;
+}
+
+static batch_slot_t *batch_slot_by_id(batch_t *batch, uint16_t id)
+{
+	batch_slot_t *slot = &batch->slots[batch->id_slots[id]];
+	if (slot->pkt == NULL || knot_wire_get_id(slot->pkt->wire) != id) {
+		return NULL;
+	}
+
+	return slot;
+}
+
+static int batch_send(batch_t *batch, batch_slot_t *slot)
+{
+	int ret = net_send(batch->net, slot->pkt->wire, slot->pkt->size);
+	slot->sent = time_now();
+	return ret;
+}
+
+static int batch_next(batch_t *batch)
+{
+	char *line = NULL;
+	size_t line_len = 0;
+
+	while (!batch->eof) {
+		if (knot_getline(&line, &line_len, batch->file) == -1) {
+			batch->eof = true;
+			break;
+		}
+		batch->line++;
+
+		query_t ctx = *batch->query;
+		int exp_rcode = KNOT_RCODE_NOERROR;
+		int ret = batch_parse_line(line, &ctx, &exp_rcode);
+		if (ret == KNOT_ENOENT) {
+			continue;
+		} else if (ret != KNOT_EOK) {
+			WARN("invalid batch line %zu\n", batch->line);
+			batch->invalid++;
+			continue;
+		}
+
+		// Find a free slot.
+		uint16_t idx = 0;
+		while (batch->slots[idx].pkt != NULL) {
+			idx++;
+		}
+		batch_slot_t *slot = &batch->slots[idx];
+
+		slot->pkt = create_query_packet(&ctx);
+		if (slot->pkt == NULL) {
+			batch->invalid++;
+			continue;
+		}
+
+		// Keep the random message ID unique among the outstanding queries.
+		uint16_t id = knot_wire_get_id(slot->pkt->wire);
+		batch_slot_t *other;
+		while ((other = batch_slot_by_id(batch, id)) != NULL && other != slot) {
+			id = dnssec_random_uint16_t();
+			knot_wire_set_id(slot->pkt->wire, id);
+		}
+		batch->id_slots[id] = idx;
+		slot->line = batch->line;
+		slot->exp_rcode = exp_rcode;
+		slot->retries = 0;
+		batch->active++;
+
+		ret = sign_query(slot->pkt, batch->query, &slot->sign_ctx);
+		if (ret != KNOT_EOK) {
+			ERR("can't sign the packet (%s)\n", knot_strerror(ret));
+			batch_slot_free(batch, slot);
+			free(line);
+			return ret;
+		}
+
+		batch->queries++;
+		ret = batch_send(batch, slot);
+		free(line);
+		return ret;
+	}
+
+	free(line);
+	return KNOT_ENOENT;
+}
+
+static int batch_resend(batch_t *batch)
+{
+	for (unsigned i = 0; i < batch->window; i++) {
+		batch_slot_t *slot = &batch->slots[i];
+		if (slot->pkt != NULL) {
+			batch->retries++;
+			int ret = batch_send(batch, slot);
+			if (ret != KNOT_EOK) {
+				return ret;
+			}
+		}
+	}
+
+	return KNOT_EOK;
+}
+
+static void batch_expire(batch_t *batch, const struct timespec *now, bool all)
+{
+	for (unsigned i = 0; i < batch->window; i++) {
+		batch_slot_t *slot = &batch->slots[i];
+		if (slot->pkt == NULL ||
+		    (!all && time_diff_ms(&slot->sent, now) < 1000 * batch->net->wait)) {
+			continue;
+		}
+
+		// Retry over UDP.
+		if (!all && slot->retries < batch->query->retries) {
+			slot->retries++;
+			batch->retries++;
+			if (batch_send(batch, slot) == KNOT_EOK) {
+				continue;
+			}
+		}
+
+		char buf[KNOT_DNAME_TXT_MAXLEN + 64];
+		WARN("no reply for %s\n", batch_slot_str(slot, buf, sizeof(buf)));
+		batch->lost++;
+		batch_slot_free(batch, slot);
+	}
+}
+
+static void batch_reply(batch_t *batch, uint8_t *wire, size_t len,
+                        const struct timespec *now)
+{
+	knot_pkt_t *reply = knot_pkt_new(wire, len, NULL);
+	if (reply == NULL || knot_pkt_parse(reply, KNOT_PF_NOCANON) != KNOT_EOK) {
+		WARN("malformed reply packet from %s\n", batch->net->remote_str);
+		batch->unexpected++;
+		knot_pkt_free(reply);
+		return;
+	}
+
+	// Match the reply with an outstanding query.
+	batch_slot_t *slot = batch_slot_by_id(batch, knot_wire_get_id(reply->wire));
+	if (slot == NULL || !knot_wire_get_qr(reply->wire) ||
+	    knot_wire_get_qdcount(reply->wire) < 1 ||
+	    !knot_dname_is_case_equal(knot_pkt_qname(reply), knot_pkt_qname(slot->pkt)) ||
+	    knot_pkt_qclass(reply) != knot_pkt_qclass(slot->pkt) ||
+	    knot_pkt_qtype(reply) != knot_pkt_qtype(slot->pkt)) {
+		batch->unexpected++;
+		knot_pkt_free(reply);
+		return;
+	}
+
+	batch->replies++;
+	if (batch->replies > batch->times_max) {
+		size_t max = MAX(1024, 2 * batch->times_max);
+		float *times = realloc(batch->times, max * sizeof(*times));
+		if (times != NULL) {
+			batch->times = times;
+			batch->times_max = max;
+		}
+	}
+	if (batch->replies <= batch->times_max) {
+		batch->times[batch->replies - 1] = time_diff_ms(&slot->sent, now);
+	}
+
+	if (knot_wire_get_tc(reply->wire)) {
+		batch->truncated++;
+	}
+
+	char buf[KNOT_DNAME_TXT_MAXLEN + 64];
+	bool mismatch = false;
+	uint16_t rcode = knot_pkt_ext_rcode(reply);
+	batch->rcodes[rcode]++;
+	if (rcode != slot->exp_rcode) {
+		const knot_lookup_t *item = knot_lookup_by_id(knot_rcode_names, rcode);
+		const knot_lookup_t *exp = knot_lookup_by_id(knot_rcode_names, slot->exp_rcode);
+		WARN("mismatch for %s, RCODE %s, expected %s\n",
+		     batch_slot_str(slot, buf, sizeof(buf)),
+		     (item != NULL) ? item->name : "?",
+		     (exp != NULL) ? exp->name : "?");
+		mismatch = true;
+	}
+
+	// Signed replies are verified regardless of the RCODE.
+	if (slot->sign_ctx.digest != NULL) {
+		int ret = verify_packet(reply, &slot->sign_ctx);
+		if (ret != KNOT_EOK) {
+			WARN("reply verification for %s (%s)\n",
+			     batch_slot_str(slot, buf, sizeof(buf)), knot_strerror(ret));
+			mismatch = true;
+		}
+	}
+
+	if (mismatch) {
+		batch->mismatches++;
+	}
+
+	knot_pkt_free(reply);
+	batch_slot_free(batch, slot);
+}
+
+static int cmp_time(const void *a, const void *b)
+{
+	float x = *(const float *)a, y = *(const float *)b;
+	return (x > y) - (x < y);
+}
+
+static void print_batch_stats(batch_t *batch, float elapsed)
+{
+	printf(";; Batch of %zu queries to %s in %.1f ms (%.0f queries/s)\n",
+	       batch->queries, batch->net->remote_str, elapsed,
+	       (elapsed > 0) ? 1000 * batch->queries / elapsed : 0);
+	printf(";; Replies: %zu, lost: %zu, retries: %zu, truncated: %zu\n",
+	       batch->replies, batch->lost, batch->retries, batch->truncated);
+	printf(";; Mismatches: %zu, unexpected replies: %zu, invalid lines: %zu\n",
+	       batch->mismatches, batch->unexpected, batch->invalid);
+
+	printf(";; RCODES:");
+	for (unsigned i = 0; i < BATCH_RCODES; i++) {
+		if (batch->rcodes[i] > 0) {
+			const knot_lookup_t *item = knot_lookup_by_id(knot_rcode_names, i);
+			if (item != NULL) {
+				printf(" %s %zu", item->name, batch->rcodes[i]);
+			} else {
+				printf(" RCODE%u %zu", i, batch->rcodes[i]);
+			}
+		}
+	}
+	printf("\n");
+
+	size_t count = MIN(batch->replies, batch->times_max);
+	if (count > 0) {
+		qsort(batch->times, count, sizeof(*batch->times), cmp_time);
+		double sum = 0;
+		for (size_t i = 0; i < count; i++) {
+			sum += batch->times[i];
+		}
+		printf(";; Reply time: min %.1f ms, avg %.1f ms, p50 %.1f ms, "
+		       "p99 %.1f ms, max %.1f ms\n",
+		       batch->times[0], sum / count, batch->times[count / 2],
+		       batch->times[count * 99 / 100], batch->times[count - 1]);
+	}
+}
+
+static int batch_connect(net_t *net)
+{
+	int ret = net_connect(net);
+	if (ret == KNOT_EOK && net->socktype == SOCK_STREAM) {
+		// Don't delay pipelined queries.
+		int on = 1;
+		(void)setsockopt(net->sockfd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+	}
+
+	return ret;
+}
+
+static int process_batch_loop(batch_t *batch)
+{
+	uint8_t in[MAX_PACKET_SIZE];
+	bool stream = (batch->net->socktype == SOCK_STREAM);
+	bool replied = true;
+
+	while (true) {
+		// Fill the window of outstanding queries.
+		while (batch->active < batch->window) {
+			int ret = batch_next(batch);
+			if (ret == KNOT_ENOENT) {
+				break;
+			} else if (ret != KNOT_EOK && !stream) {
+				return ret;
+			} else if (ret != KNOT_EOK) {
+				break; // Reconnect below.
+			}
+		}
+		if (batch->active == 0) {
+			return KNOT_EOK;
+		}
+
+		int in_len = net_receive(batch->net, in, sizeof(in));
+		struct timespec now = time_now();
+		if (in_len > 0) {
+			batch_reply(batch, in, in_len, &now);
+			replied = true;
+			if (!stream) {
+				batch_expire(batch, &now, false);
+			}
+		} else if (!stream || in_len == KNOT_NET_ETIMEOUT) {
+			// Only the queries waiting too long are given up. A timeout
+			// within a message is reported as a receive error, so the
+			// stream is still in sync here.
+			batch_expire(batch, &now, false);
+		} else if (!replied) {
+			// Reconnection didn't help.
+			batch_expire(batch, &now, true);
+			return KNOT_NET_ERECV;
+		} else {
+			// Possibly closed by the server, reconnect and repeat
+			// the outstanding queries.
+			DBG("reconnecting to %s\n", batch->net->remote_str);
+			net_close(batch->net);
+			replied = false;
+			int ret = batch_connect(batch->net);
+			if (ret == KNOT_EOK) {
+				ret = batch_resend(batch);
+			}
+			if (ret != KNOT_EOK) {
+				batch_expire(batch, &now, true);
+				return ret;
+			}
+		}
+	}
+}
+
+static int process_batch(const query_t *query)
+{
+	batch_t batch = {
+		.query = query,
+		.window = query->window,
+	};
+
+	batch.file = fopen(query->batch_file, "r");
+	if (batch.file == NULL) {
+		ERR("can't open batch file %s\n", query->batch_file);
+		return -1;
+	}
+
+	// HTTPS context doesn't support concurrent streams.
+	if (query->https.enable && batch.window > 1) {
+		WARN("HTTPS supports only one outstanding query in batch mode\n");
+		batch.window = 1;
+	}
+
+	// Writing to a connection closed by the server must not terminate kdig.
+	signal(SIGPIPE, SIG_IGN);
+
+	batch.slots = calloc(batch.window, sizeof(*batch.slots));
+	batch.id_slots = calloc(UINT16_MAX + 1, sizeof(*batch.id_slots));
+	if (batch.slots == NULL || batch.id_slots == NULL) {
+		free(batch.slots);
+		free(batch.id_slots);
+		fclose(batch.file);
+		return -1;
+	}
+
+	int iptype = get_iptype(query->ip);
+	int socktype = get_socktype(query->protocol, query->type_num);
+	int flags = query->fastopen ? NET_FLAGS_FASTOPEN : NET_FLAGS_NONE;
+
+	// Use the first available server.
+	net_t net;
+	int ret = KNOT_NET_EADDR;
+	node_t *server;
+	WALK_LIST(server, query->servers) {
+		ret = net_init(query->local, (srv_info_t *)server, iptype, socktype,
+		               query->wait, flags, &query->tls, &query->https, &net);
+		if (ret != KNOT_EOK) {
+			continue;
+		}
+		ret = batch_connect(&net);
+		if (ret == KNOT_EOK) {
+			break;
+		}
+		net_clean(&net);
+	}
+	if (ret != KNOT_EOK) {
+		ERR("failed to connect to any server\n");
+		free(batch.slots);
+		free(batch.id_slots);
+		fclose(batch.file);
+		return -1;
+	}
+	batch.net = &net;
+
+	struct timespec t_start = time_now();
+	ret = process_batch_loop(&batch);
+	struct timespec t_end = time_now();
+	if (ret != KNOT_EOK) {
+		ERR("batch processing terminated at line %zu (%s)\n",
+		    batch.line, knot_strerror(ret));
+	}
+
+	print_batch_stats(&batch, time_diff_ms(&t_start, &t_end));
+
+	for (unsigned i = 0; i < batch.window; i++) {
+		if (batch.slots[i].pkt != NULL) {
+			batch_slot_free(&batch, &batch.slots[i]);
+		}
+	}
+	net_close(&net);
+	net_clean(&net);
+	free(batch.times);
+	free(batch.slots);
+	free(batch.id_slots);
+	fclose(batch.file);
+
+	bool success = (ret == KNOT_EOK && batch.lost == 0 && batch.mismatches == 0 &&
+	                batch.invalid == 0);
+	return success ? 0 : -1;
+}
+
 int kdig_exec(const kdig_params_t *params)
 {
 	node_t *n;
@@ -1181,6 +1679,9 @@ int kdig_exec(const kdig_params_t *params)
 		case OPERATION_XFR:
 			ret = process_xfr(query);
 			break;
+		case OPERATION_BATCH:
+			ret = process_batch(query);
+			break;
 #if USE_DNSTAP
 		case OPERATION_LIST_DNSTAP:
 			ret = process_dnstap(query);
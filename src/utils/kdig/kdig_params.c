@@ -41,6 +41,7 @@
 #define DEFAULT_RETRIES_DIG		2
 #define DEFAULT_TIMEOUT_DIG		5
 #define DEFAULT_ALIGNMENT_SIZE		128
+#define DEFAULT_BATCH_WINDOW		32
 #define DEFAULT_TLS_OCSP_STAPLING	(7 * 24 * 3600)
 
 #define BADCOOKIE_RETRY_MAX		10
@@ -1213,6 +1214,27 @@ static int opt_noretry(const char *arg, void *query)
 	return KNOT_EOK;
 }
 
+static int opt_window(const char *arg, void *query)
+{
+	query_t *q = query;
+
+	if (str_to_u16(arg, &q->window) != KNOT_EOK || q->window == 0) {
+		ERR("invalid +window=%s\n", arg);
+		return KNOT_EINVAL;
+	}
+
+	return KNOT_EOK;
+}
+
+static int opt_nowindow(const char *arg, void *query)
+{
+	query_t *q = query;
+
+	q->window = DEFAULT_BATCH_WINDOW;
+
+	return KNOT_EOK;
+}
+
 static int parse_ednsopt(const char *arg, ednsopt_t **opt_ptr)
 {
 	errno = 0;
@@ -1433,6 +1455,9 @@ static const param_t kdig_opts2[] = {
 	{ "retry",          ARG_REQUIRED, opt_retry },
 	{ "noretry",        ARG_NONE,     opt_noretry },
 
+	{ "window",         ARG_REQUIRED, opt_window },
+	{ "nowindow",       ARG_NONE,     opt_nowindow },
+
 	{ "cookie",         ARG_OPTIONAL, opt_cookie },
 	{ "nocookie",       ARG_NONE,     opt_nocookie },
 
@@ -1489,6 +1514,8 @@ query_t *query_create(const char *owner, const query_t *conf)
 		//query->tsig_key
 		query->subnet.family = AF_UNSPEC;
 		ednsopt_list_init(&query->edns_opts);
+		query->batch_file = NULL;
+		query->window = DEFAULT_BATCH_WINDOW;
 #if USE_DNSTAP
 		query->dt_reader = NULL;
 		query->dt_writer = NULL;
@@ -1524,6 +1551,8 @@ query_t *query_create(const char *owner, const query_t *conf)
 			return NULL;
 		}
 
+		query->batch_file = NULL;
+
 #if USE_DNSTAP
 		query->dt_reader = conf->dt_reader;
 		query->dt_writer = conf->dt_writer;
@@ -1591,6 +1620,7 @@ void query_free(query_t *query)
 	}
 #endif // USE_DNSTAP
 
+	free(query->batch_file);
 	free(query->owner);
 	free(query->port);
 	free(query);
@@ -2055,8 +2085,9 @@ void complete_queries(list_t *queries, const query_t *conf)
 		}
 
 		// Set zone transfer if any.
-		if (q->type_num == KNOT_RRTYPE_AXFR ||
-		    q->type_num == KNOT_RRTYPE_IXFR) {
+		if (q->operation != OPERATION_BATCH &&
+		    (q->type_num == KNOT_RRTYPE_AXFR ||
+		     q->type_num == KNOT_RRTYPE_IXFR)) {
 			q->operation = OPERATION_XFR;
 		}
 
@@ -2075,6 +2106,7 @@ static void print_help(void)
 	printf("Usage: %s [-4] [-6] [-d] [-b address] [-c class] [-p port]\n"
 	       "            [-q name] [-t type] [-x address] [-k keyfile]\n"
 	       "            [-y [algo:]keyname:key] [-E tapfile] [-G tapfile]\n"
+	       "            [-f batchfile]\n"
 	       "            name [type] [class] [@server]\n"
 	       "\n"
 	       "       +[no]multiline             Wrap long records to more lines.\n"
@@ -2129,6 +2161,7 @@ static void print_help(void)
 	       "       +[no]edns[=N]              Use EDNS(=version).\n"
 	       "       +[no]timeout=T             Set wait for reply interval in seconds.\n"
 	       "       +[no]retry=N               Set number of retries.\n"
+	       "       +[no]window=N              Set number of outstanding queries in batch mode.\n"
 	       "       +[no]cookie=HEX            Attach EDNS(0) cookie to the query.\n"
 	       "       +[no]badcookie             Repeat a query with the correct cookie.\n"
 	       "       +[no]ednsopt=CODE[:HEX]    Set custom EDNS option.\n"
@@ -2309,6 +2342,28 @@ static int parse_opt1(const char *opt, const char *value, kdig_params_t *params,
 		return KNOT_EINVAL;
 #endif // USE_DNSTAP
 		break;
+	case 'f':
+		if (val == NULL) {
+			ERR("missing filename\n");
+			return KNOT_EINVAL;
+		}
+
+		query = query_create(NULL, params->config);
+		if (query == NULL) {
+			return KNOT_ENOMEM;
+		}
+
+		query->batch_file = strdup(val);
+		if (query->batch_file == NULL) {
+			query_free(query);
+			return KNOT_ENOMEM;
+		}
+
+		query->operation = OPERATION_BATCH;
+		add_tail(&params->queries, (node_t *)query);
+
+		*index += add;
+		break;
 	case 'G':
 #if USE_DNSTAP
 		if (val == NULL) {
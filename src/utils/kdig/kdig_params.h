@@ -38,6 +38,8 @@ typedef enum {
 	OPERATION_XFR,
 	/*!< Dump dnstap file. */
 	OPERATION_LIST_DNSTAP,
+	/*!< Concurrent queries from a file. */
+	OPERATION_BATCH,
 } operation_t;
 
 /*! \brief DNS header and EDNS flags. */
@@ -129,6 +131,10 @@ struct query {
 	knot_edns_client_subnet_t subnet;
 	/*!< Lits of custom EDNS options. */
 	list_t		edns_opts;
+	/*!< File with queries for the batch mode. */
+	char		*batch_file;
+	/*!< Maximum number of outstanding queries in the batch mode. */
+	uint16_t	window;
 #if USE_DNSTAP
 	/*!< Context for dnstap reader input. */
 	dt_reader_t	*dt_reader;
@@ -51,7 +51,7 @@
 /* Signal flags. */
 static volatile bool sig_req_stop = false;
 static volatile bool sig_req_reload = false;
-static volatile bool sig_req_zones_reload = false;
+static volatile bool sig_req_catalog_update = false;
 
 /* \brief Signal started state to the init system. */
 static void init_signal_started(void)
@@ -126,7 +126,7 @@ struct signal {
 /*! \brief Signals used by the server. */
 static const struct signal SIGNALS[] = {
 	{ SIGHUP,  true  },  /* Reload server. */
-	{ SIGUSR1, true  },  /* Reload zones. */
+	{ SIGUSR1, true  },  /* Apply catalog changes. */
 	{ SIGINT,  true  },  /* Terminate server. */
 	{ SIGTERM, true  },  /* Terminate server. */
 	{ SIGALRM, false },  /* Internal thread synchronization. */
@@ -142,7 +142,7 @@ static void handle_signal(int signum)
 		sig_req_reload = true;
 		break;
 	case SIGUSR1:
-		sig_req_zones_reload = true;
+		sig_req_catalog_update = true;
 		break;
 	case SIGINT:
 	case SIGTERM:
@@ -256,6 +256,17 @@ static void event_loop(server_t *server, const char *socket)
 	}
 	free(listen);
 
+	/* Start the control workers. */
+	conf_val_t workers_val = conf_get(conf(), C_CTL, C_WORKERS);
+	ctl_pool_t *pool = ctl_pool_create(conf_int(&workers_val), server);
+	if (pool == NULL) {
+		knot_ctl_unbind(ctl);
+		knot_ctl_free(ctl);
+		log_fatal("control, failed to start workers (%s)",
+		          knot_strerror(KNOT_ENOMEM));
+		return;
+	}
+
 	enable_signals();
 
 	/* Run event loop. */
@@ -266,11 +277,19 @@ static void event_loop(server_t *server, const char *socket)
 		}
 		if (sig_req_reload) {
 			sig_req_reload = false;
-			server_reload(server);
+			ret = ctl_pool_reload(pool, false);
+			if (ret != KNOT_EOK) {
+				log_error("failed to schedule reload (%s)",
+				          knot_strerror(ret));
+			}
 		}
-		if (sig_req_zones_reload) {
-			sig_req_zones_reload = false;
-			server_update_zones(conf(), server);
+		if (sig_req_catalog_update) {
+			sig_req_catalog_update = false;
+			ret = ctl_pool_reload(pool, true);
+			if (ret != KNOT_EOK) {
+				log_error("failed to schedule catalog update (%s)",
+				          knot_strerror(ret));
+			}
 		}
 
 		// Update control timeout.
@@ -281,16 +300,27 @@ static void event_loop(server_t *server, const char *socket)
 			continue;
 		}
 
-		ret = ctl_process(ctl, server);
-		knot_ctl_close(ctl);
-		if (ret == KNOT_CTL_ESTOP) {
-			break;
+		// Pass the connection to a control worker.
+		knot_ctl_t *client = knot_ctl_clone(ctl);
+		if (client == NULL) {
+			knot_ctl_close(ctl);
+			continue;
+		}
+		ret = ctl_pool_assign(pool, client);
+		if (ret != KNOT_EOK) {
+			log_warning("control, connection refused (%s)",
+			            knot_strerror(ret));
+			knot_ctl_close(client);
+			knot_ctl_free(client);
 		}
 	}
 
 	/* Unbind the control socket. */
 	knot_ctl_unbind(ctl);
 	knot_ctl_free(ctl);
+
+	/* Finish the pending control connections. */
+	ctl_pool_destroy(pool);
 }
 
 static void print_help(void)
@@ -20,13 +20,38 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <libknot/codes.h>
 #include <libknot/descriptor.h>
 #include <libknot/dname.h>
+#include <libknot/errcode.h>
+#include <libknot/lookup.h>
+#include <libknot/packet/wire.h>
+#include <libknot/wire.h>
 
 #include "load_queries.h"
 
+#if USE_DNSTAP
+# include "contrib/dnstap/reader.h"
+#endif
+
 #define ERR_PREFIX "failed loading queries "
 
+#define PCAP_MAGIC_USEC		0xa1b2c3d4
+#define PCAP_MAGIC_NSEC		0xa1b23c4d
+#define PCAP_MAGIC_USEC_SWAP	0xd4c3b2a1
+#define PCAP_MAGIC_NSEC_SWAP	0x4d3cb2a1
+#define PCAP_LINK_ETHERNET	1
+#define PCAP_LINK_RAW		101
+#define PCAP_LINK_LINUX_SLL	113
+#define PCAP_FRAME_MAX		65536
+
+#define ETH_TYPE_IPV4		0x0800
+#define ETH_TYPE_IPV6		0x86dd
+#define ETH_TYPE_VLAN		0x8100
+#define IP_PROTO_UDP		17
+
+#define REPLAY_MAX_LEN		1472 // Ethernet MTU without IPv4 and UDP headers
+
 uint16_t global_edns_size = 1232;
 
 enum qflags {
@@ -35,6 +60,7 @@ enum qflags {
 };
 
 struct pkt_payload *global_payloads = NULL;
+size_t global_payloads_count = 0;
 
 void free_global_payloads()
 {
@@ -44,6 +70,58 @@ void free_global_payloads()
 		g_payloads_p = tmp->next;
 		free(tmp);
 	}
+	global_payloads = NULL;
+	global_payloads_count = 0;
+}
+
+static void append_payload(struct pkt_payload *pkt, struct pkt_payload **top)
+{
+	if (*top == NULL) {
+		global_payloads = pkt;
+	} else {
+		(*top)->next = pkt;
+	}
+	*top = pkt;
+	global_payloads_count++;
+}
+
+static bool parse_expect(const char *str, struct pkt_payload *pkt)
+{
+	// Format: =RCODE[/ANCOUNT]
+	char rcode_txt[32];
+	const char *slash = strchr(str, '/');
+	size_t rcode_len = (slash != NULL) ? slash - str : strlen(str);
+	if (rcode_len == 0 || rcode_len >= sizeof(rcode_txt)) {
+		return false;
+	}
+	memcpy(rcode_txt, str, rcode_len);
+	rcode_txt[rcode_len] = '\0';
+
+	char *end;
+	const knot_lookup_t *rcode = knot_lookup_by_name(knot_rcode_names, rcode_txt);
+	if (rcode != NULL) {
+		pkt->exp_rcode = rcode->id;
+	} else {
+		long val = strtol(rcode_txt, &end, 10);
+		if (*end != '\0' || val < 0 || val > 0xf) {
+			return false;
+		}
+		pkt->exp_rcode = val;
+	}
+	// Only the header part of the RCODE is compared.
+	if (pkt->exp_rcode > 0xf) {
+		return false;
+	}
+
+	if (slash != NULL) {
+		long val = strtol(slash + 1, &end, 10);
+		if (slash[1] == '\0' || *end != '\0' || val < 0 || val > UINT16_MAX) {
+			return false;
+		}
+		pkt->exp_ancount = val;
+	}
+
+	return true;
 }
 
 bool load_queries(const char *filename)
@@ -60,7 +138,7 @@ bool load_queries(const char *filename)
 		char dname_txt[KNOT_DNAME_TXT_MAXLEN + 1];
 		uint8_t dname[KNOT_DNAME_MAXLEN];
 		char type_txt[128];
-		char flags_txt[128];
+		char opts_txt[2][128];
 	} *bufs;
 	bufs = malloc(sizeof(*bufs)); // avoiding too much stuff on stack
 	if (bufs == NULL) {
@@ -69,8 +147,10 @@ bool load_queries(const char *filename)
 	}
 
 	while (fgets(bufs->line, sizeof(bufs->line), f) != NULL) {
-		bufs->flags_txt[0] = '\0';
-		int ret = sscanf(bufs->line, "%s%s%s", bufs->dname_txt, bufs->type_txt, bufs->flags_txt);
+		bufs->opts_txt[0][0] = '\0';
+		bufs->opts_txt[1][0] = '\0';
+		int ret = sscanf(bufs->line, "%s%s%s%s", bufs->dname_txt, bufs->type_txt,
+		                 bufs->opts_txt[0], bufs->opts_txt[1]);
 		if (ret < 2) {
 			printf(ERR_PREFIX "(faulty line): '%.*s'\n",
 			       (int)strcspn(bufs->line, "\n"), bufs->line);
@@ -90,20 +170,31 @@ bool load_queries(const char *filename)
 		}
 
 		enum qflags flags = 0;
-		switch (bufs->flags_txt[0]) {
-		case '\0':
-			break;
-		case 'e':
-		case 'E':
-			flags |= QFLAG_EDNS;
-			break;
-		case 'd':
-		case 'D':
-			flags |= QFLAG_EDNS | QFLAG_DO;
-			break;
-		default:
-			printf(ERR_PREFIX "(faulty flag): '%s'\n", bufs->flags_txt);
-			goto fail;
+		const char *expect = NULL;
+		for (int i = 0; i < 2; i++) {
+			const char *opt = bufs->opts_txt[i];
+			switch (opt[0]) {
+			case '\0':
+				break;
+			case '=':
+				if (expect == NULL) {
+					expect = opt + 1;
+					break;
+				}
+				printf(ERR_PREFIX "(faulty expectation): '%s'\n", opt);
+				goto fail;
+			case 'e':
+			case 'E':
+				flags |= QFLAG_EDNS;
+				break;
+			case 'd':
+			case 'D':
+				flags |= QFLAG_EDNS | QFLAG_DO;
+				break;
+			default:
+				printf(ERR_PREFIX "(faulty flag): '%s'\n", opt);
+				goto fail;
+			}
 		}
 
 		size_t dname_len = knot_dname_size(bufs->dname);
@@ -112,11 +203,19 @@ bool load_queries(const char *filename)
 			pkt_len += 11;
 		}
 
-		struct pkt_payload *pkt = calloc(1, sizeof(void *) + sizeof(size_t) + pkt_len);
+		struct pkt_payload *pkt = calloc(1, sizeof(*pkt) + pkt_len);
 		if (pkt == NULL) {
 			printf(ERR_PREFIX "(out of memory)\n");
 			goto fail;
 		}
+		pkt->exp_rcode = EXPECT_NONE;
+		pkt->exp_ancount = EXPECT_NONE;
+		if (expect != NULL && !parse_expect(expect, pkt)) {
+			printf(ERR_PREFIX "(faulty expectation): '=%s'\n", expect);
+			free(pkt);
+			goto fail;
+		}
+		pkt->qlen = dname_len + 4;
 		pkt->len = pkt_len;
 		pkt->payload[2] = 0x01; // QR bit
 		pkt->payload[5] = 0x01; // 1 question
@@ -133,13 +232,7 @@ bool load_queries(const char *filename)
 		}
 
 		// add pkt to list global_payloads
-		if (g_payloads_top == NULL) {
-			global_payloads = pkt;
-			g_payloads_top = pkt;
-		} else {
-			g_payloads_top->next = pkt;
-			g_payloads_top = pkt;
-		}
+		append_payload(pkt, &g_payloads_top);
 	}
 
 	if (global_payloads == NULL) {
@@ -157,3 +250,274 @@ fail:
 	fclose(f);
 	return false;
 }
+
+bool reply_matches(const struct pkt_payload *payl, const uint8_t *wire, size_t len)
+{
+	// The question section is missing in some error replies.
+	if (payl->qlen > 0 && knot_wire_get_qdcount(wire) > 0 &&
+	    (len < KNOT_WIRE_HEADER_SIZE + payl->qlen ||
+	     memcmp(wire + KNOT_WIRE_HEADER_SIZE, payl->payload + KNOT_WIRE_HEADER_SIZE,
+	            payl->qlen) != 0)) {
+		return false;
+	}
+	if (payl->exp_rcode != EXPECT_NONE && knot_wire_get_rcode(wire) != payl->exp_rcode) {
+		return false;
+	}
+	if (payl->exp_ancount != EXPECT_NONE && knot_wire_get_ancount(wire) != payl->exp_ancount) {
+		return false;
+	}
+	return true;
+}
+
+static struct pkt_payload *replay_payload(const uint8_t *wire, size_t len, uint64_t ts)
+{
+	if (len < KNOT_WIRE_HEADER_SIZE || len > REPLAY_MAX_LEN ||
+	    knot_wire_get_qr(wire) || knot_wire_get_qdcount(wire) != 1) {
+		return NULL;
+	}
+
+	int qname_len = knot_dname_wire_check(wire + KNOT_WIRE_HEADER_SIZE, wire + len, NULL);
+	if (qname_len <= 0 || KNOT_WIRE_HEADER_SIZE + qname_len + 4 > len) {
+		return NULL;
+	}
+
+	struct pkt_payload *pkt = calloc(1, sizeof(*pkt) + len);
+	if (pkt == NULL) {
+		return NULL;
+	}
+	pkt->ts = ts;
+	pkt->exp_rcode = EXPECT_NONE;
+	pkt->exp_ancount = EXPECT_NONE;
+	pkt->qlen = qname_len + 4;
+	pkt->len = len;
+	memcpy(pkt->payload, wire, len);
+
+	return pkt;
+}
+
+static void replay_append(const uint8_t *wire, size_t len, uint64_t ts,
+                          uint64_t *first_ts, struct pkt_payload **top)
+{
+	if (*top == NULL) {
+		*first_ts = ts;
+	}
+	// Out-of-order timestamps are sent immediately.
+	struct pkt_payload *pkt = replay_payload(wire, len, ts > *first_ts ? ts - *first_ts : 0);
+	if (pkt != NULL) {
+		append_payload(pkt, top);
+	}
+}
+
+static uint32_t pcap_u32(const uint8_t *data, bool swap)
+{
+	uint32_t val;
+	memcpy(&val, data, sizeof(val));
+	return swap ? __builtin_bswap32(val) : val;
+}
+
+static bool pcap_magic(uint32_t magic, bool *swap, bool *nsec)
+{
+	*swap = (magic == PCAP_MAGIC_USEC_SWAP || magic == PCAP_MAGIC_NSEC_SWAP);
+	*nsec = (magic == PCAP_MAGIC_NSEC || magic == PCAP_MAGIC_NSEC_SWAP);
+	return *swap || *nsec || magic == PCAP_MAGIC_USEC;
+}
+
+static bool pcap_frame_dns(const uint8_t *frame, size_t len, uint32_t linktype,
+                           uint16_t port, const uint8_t **dns, size_t *dns_len)
+{
+	uint16_t eth_type;
+	switch (linktype) {
+	case PCAP_LINK_ETHERNET:
+		if (len < 14) {
+			return false;
+		}
+		eth_type = knot_wire_read_u16(frame + 12);
+		frame += 14;
+		len -= 14;
+		if (eth_type == ETH_TYPE_VLAN) {
+			if (len < 4) {
+				return false;
+			}
+			eth_type = knot_wire_read_u16(frame + 2);
+			frame += 4;
+			len -= 4;
+		}
+		break;
+	case PCAP_LINK_LINUX_SLL:
+		if (len < 16) {
+			return false;
+		}
+		eth_type = knot_wire_read_u16(frame + 14);
+		frame += 16;
+		len -= 16;
+		break;
+	case PCAP_LINK_RAW:
+		if (len < 1) {
+			return false;
+		}
+		eth_type = (frame[0] >> 4) == 6 ? ETH_TYPE_IPV6 : ETH_TYPE_IPV4;
+		break;
+	default:
+		return false;
+	}
+
+	size_t ip_len;
+	switch (eth_type) {
+	case ETH_TYPE_IPV4:
+		if (len < 20 || (frame[0] >> 4) != 4) {
+			return false;
+		}
+		ip_len = (frame[0] & 0x0f) * 4;
+		// Skip fragments, they can't be replayed as a whole.
+		if (ip_len < 20 || len < ip_len || frame[9] != IP_PROTO_UDP ||
+		    (knot_wire_read_u16(frame + 6) & 0x3fff) != 0) {
+			return false;
+		}
+		break;
+	case ETH_TYPE_IPV6:
+		ip_len = 40;
+		if (len < ip_len || (frame[0] >> 4) != 6 || frame[6] != IP_PROTO_UDP) {
+			return false;
+		}
+		break;
+	default:
+		return false;
+	}
+	frame += ip_len;
+	len -= ip_len;
+
+	if (len < 8 || knot_wire_read_u16(frame + 2) != port) {
+		return false;
+	}
+	size_t udp_len = knot_wire_read_u16(frame + 4);
+	if (udp_len < 8 || udp_len > len) {
+		return false; // Truncated by the snapshot length.
+	}
+
+	*dns = frame + 8;
+	*dns_len = udp_len - 8;
+	return true;
+}
+
+static bool load_pcap(FILE *f, uint16_t port, struct pkt_payload **top)
+{
+	uint8_t hdr[24];
+	uint32_t magic;
+	bool swap, nsec;
+	if (fread(hdr, sizeof(hdr), 1, f) != 1) {
+		printf(ERR_PREFIX "(malformed pcap header)\n");
+		return false;
+	}
+	memcpy(&magic, hdr, sizeof(magic));
+	if (!pcap_magic(magic, &swap, &nsec)) {
+		printf(ERR_PREFIX "(malformed pcap header)\n");
+		return false;
+	}
+	uint32_t linktype = pcap_u32(hdr + 20, swap) & 0xffff;
+	if (linktype != PCAP_LINK_ETHERNET && linktype != PCAP_LINK_RAW &&
+	    linktype != PCAP_LINK_LINUX_SLL) {
+		printf(ERR_PREFIX "(unsupported pcap link type %u)\n", linktype);
+		return false;
+	}
+
+	uint8_t *frame = malloc(PCAP_FRAME_MAX);
+	if (frame == NULL) {
+		printf(ERR_PREFIX "(out of memory)\n");
+		return false;
+	}
+
+	uint64_t first_ts = 0;
+	uint8_t rec[16];
+	while (fread(rec, sizeof(rec), 1, f) == 1) {
+		uint64_t ts_sec = pcap_u32(rec, swap);
+		uint64_t ts_frac = pcap_u32(rec + 4, swap);
+		uint32_t incl_len = pcap_u32(rec + 8, swap);
+		if (incl_len > PCAP_FRAME_MAX) {
+			if (fseek(f, incl_len, SEEK_CUR) != 0) {
+				break;
+			}
+			continue;
+		}
+		if (fread(frame, 1, incl_len, f) != incl_len) {
+			break; // Truncated capture, use what has been loaded.
+		}
+
+		const uint8_t *dns;
+		size_t dns_len;
+		if (pcap_frame_dns(frame, incl_len, linktype, port, &dns, &dns_len)) {
+			uint64_t ts = ts_sec * 1000000 + (nsec ? ts_frac / 1000 : ts_frac);
+			replay_append(dns, dns_len, ts, &first_ts, top);
+		}
+	}
+
+	free(frame);
+	return true;
+}
+
+#if USE_DNSTAP
+static bool load_dnstap(const char *filename, struct pkt_payload **top)
+{
+	dt_reader_t *reader = dt_reader_create(filename);
+	if (reader == NULL) {
+		printf(ERR_PREFIX "(not a pcap or dnstap file)\n");
+		return false;
+	}
+
+	uint64_t first_ts = 0;
+	int ret;
+	Dnstap__Dnstap *frame = NULL;
+	while ((ret = dt_reader_read(reader, &frame)) == KNOT_EOK) {
+		Dnstap__Message *msg = frame->message;
+		if (frame->type == DNSTAP__DNSTAP__TYPE__MESSAGE &&
+		    msg->has_query_message && !msg->has_response_message) {
+			uint64_t ts = msg->query_time_sec * 1000000 + msg->query_time_nsec / 1000;
+			replay_append(msg->query_message.data, msg->query_message.len,
+			              ts, &first_ts, top);
+		}
+		dt_reader_free_frame(reader, &frame);
+	}
+	dt_reader_free(reader);
+
+	if (ret != KNOT_EOF) {
+		printf(ERR_PREFIX "(malformed dnstap file)\n");
+		return false;
+	}
+	return true;
+}
+#endif // USE_DNSTAP
+
+bool load_replay(const char *filename, uint16_t port)
+{
+	FILE *f = fopen(filename, "r");
+	if (f == NULL) {
+		printf(ERR_PREFIX "file '%s' (%s)\n", filename, strerror(errno));
+		return false;
+	}
+	struct pkt_payload *g_payloads_top = NULL;
+
+	uint32_t magic = 0;
+	bool swap, nsec, ret;
+	if (fread(&magic, sizeof(magic), 1, f) == 1 && pcap_magic(magic, &swap, &nsec)) {
+		rewind(f);
+		ret = load_pcap(f, port, &g_payloads_top);
+		fclose(f);
+	} else {
+		fclose(f);
+#if USE_DNSTAP
+		ret = load_dnstap(filename, &g_payloads_top);
+#else
+		printf(ERR_PREFIX "(not a pcap file)\n");
+		ret = false;
+#endif
+	}
+
+	if (ret && global_payloads == NULL) {
+		printf(ERR_PREFIX "(no queries in file)\n");
+		ret = false;
+	}
+	if (!ret) {
+		free_global_payloads();
+	}
+
+	return ret;
+}
@@ -17,16 +17,37 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#define EXPECT_NONE	-1
+
 struct pkt_payload {
 	struct pkt_payload *next;
+	uint64_t ts;          // Replay time since the first query (usecs).
+	int32_t exp_rcode;    // Expected RCODE or EXPECT_NONE.
+	int32_t exp_ancount;  // Expected answer count or EXPECT_NONE.
+	uint16_t qlen;        // Question section length.
 	size_t len;
 	uint8_t payload[];
 };
 
 extern struct pkt_payload *global_payloads;
+extern size_t global_payloads_count;
 
 bool load_queries(const char *filename);
 
+/*!
+ * \brief Checks the reply question and the expected RCODE and answer count.
+ */
+bool reply_matches(const struct pkt_payload *payl, const uint8_t *wire, size_t len);
+
+/*!
+ * \brief Loads DNS queries with their timing from a pcap or dnstap file.
+ *
+ * \param filename  Capture file.
+ * \param port      Only UDP datagrams to this port are loaded from pcap.
+ */
+bool load_replay(const char *filename, uint16_t port);
+
 void free_global_payloads(void);
@@ -36,14 +36,18 @@
 #include <sys/resource.h>
 
 #include "libknot/libknot.h"
+#include "contrib/macros.h"
 #include "contrib/openbsd/strlcpy.h"
+#include "contrib/sockaddr.h"
 #include "utils/common/params.h"
 #include "utils/kxdpgun/load_queries.h"
 #include "utils/kxdpgun/popenve.h"
+#include "utils/kxdpgun/stats.h"
+#include "utils/kxdpgun/stream.h"
 
 #define PROGRAM_NAME "kxdpgun"
 
-uint16_t TRANSACTION_ID; // random constant to distinguish foreign replies
+#define ID_SLOTS (UINT16_MAX + 1)
 
 volatile bool xdp_trigger = false;
 
@@ -54,6 +58,15 @@ uint64_t global_size_recv = 0;
 unsigned global_cpu_aff_start = 0;
 unsigned global_cpu_aff_step = 1;
 
+// Outstanding queries indexed by the DNS message ID. The slot holds the send
+// time in usecs (upper 48 bits) and the local port (lower 16 bits), so that
+// replies can be matched and timed by any thread. The high bits of the ID
+// identify the sending thread, so each thread stores into its own part.
+uint64_t global_inflight[ID_SLOTS];
+const struct pkt_payload *global_inflight_payl[ID_SLOTS];
+
+lat_series_t global_series; // per-second statistics
+
 #define LOCAL_PORT_MIN  1024
 #define LOCAL_PORT_MAX 65535
 
@@ -71,6 +84,11 @@ typedef struct {
 	uint16_t	target_port;
 	uint32_t	listen_port; // KNOT_XDP_LISTEN_PORT_ALL, KNOT_XDP_LISTEN_PORT_DROP
 	unsigned	n_threads, thread_id;
+	uint32_t	id_seq;
+	bool		replay;
+	bool		print_seconds;
+	bool		use_stream;  // UDP, TCP, or TLS over kernel sockets instead of XDP
+	stream_ctx_t	stream;
 	uint64_t	rcode_counts[KNOWN_RCODE_MAX];
 } xdp_gun_ctx_t;
 
@@ -81,20 +99,18 @@ const static xdp_gun_ctx_t ctx_defaults = {
 	.at_once = 10,
 	.target_port = 53,
 	.listen_port = KNOT_XDP_LISTEN_PORT_ALL,
+	.stream = {
+		.connections = 10,
+		.conn_queries = 1,
+		.pipeline = 1,
+	},
 };
 
-inline static void timer_start(struct timespec *timesp)
-{
-	clock_gettime(CLOCK_MONOTONIC, timesp);
-}
-
-inline static uint64_t timer_end(struct timespec *timesp)
+inline static uint64_t timer_usec(void)
 {
-	struct timespec end;
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	uint64_t res = (end.tv_sec - timesp->tv_sec) * (uint64_t)1000000;
-	res += ((int64_t)end.tv_nsec - timesp->tv_nsec) / 1000;
-	return res;
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * (uint64_t)1000000 + now.tv_nsec / 1000;
 }
 
 static void set_sockaddr(void *sa_in, struct in_addr *addr, uint16_t port, uint64_t increment)
@@ -136,10 +152,34 @@ static void next_payload(struct pkt_payload **payload, int increment)
 	}
 }
 
+static unsigned replay_ready(struct pkt_payload *payl, uint64_t idx,
+                             uint64_t elapsed, xdp_gun_ctx_t *ctx)
+{
+	unsigned npkts = 0;
+	while (npkts < ctx->at_once && idx < global_payloads_count && payl->ts <= elapsed) {
+		npkts++;
+		idx += ctx->n_threads;
+		next_payload(&payl, ctx->n_threads);
+	}
+	return npkts;
+}
+
+static unsigned id_seq_bits(unsigned n_threads)
+{
+	unsigned thread_bits = 0;
+	while (thread_bits < 16 && (1U << thread_bits) < n_threads) {
+		thread_bits++;
+	}
+	return 16 - thread_bits;
+}
+
 static int alloc_pkts(knot_xdp_msg_t *pkts, int npkts, struct knot_xdp_socket *xsk,
-                      xdp_gun_ctx_t *ctx, uint64_t tick, struct pkt_payload **payl)
+                      xdp_gun_ctx_t *ctx, uint64_t tick, uint64_t now,
+                      struct pkt_payload **payl)
 {
 	uint64_t unique = (tick * ctx->n_threads + ctx->thread_id) * ctx->at_once;
+	unsigned seq_bits = id_seq_bits(ctx->n_threads);
+	uint32_t seq_mask = (1U << seq_bits) - 1;
 
 	for (int i = 0; i < npkts; i++) {
 		int ret = knot_xdp_send_alloc(xsk, ctx->ipv6, &pkts[i], NULL);
@@ -164,7 +204,13 @@ static int alloc_pkts(knot_xdp_msg_t *pkts, int npkts, struct knot_xdp_socket *x
 		memcpy(pkts[i].payload.iov_base, (*payl)->payload, (*payl)->len);
 		pkts[i].payload.iov_len = (*payl)->len;
 
-		*(uint16_t *)(pkts[i].payload.iov_base + 0) = TRANSACTION_ID;
+		uint16_t id = (ctx->thread_id << seq_bits) | (ctx->id_seq++ & seq_mask);
+		knot_wire_set_id(pkts[i].payload.iov_base, id);
+		if (ctx->listen_port != KNOT_XDP_LISTEN_PORT_DROP) {
+			__atomic_store_n(&global_inflight_payl[id], *payl, __ATOMIC_RELAXED);
+			__atomic_store_n(&global_inflight[id], (now << 16) | local_port,
+			                 __ATOMIC_RELEASE);
+		}
 
 		unique++;
 		next_payload(payl, ctx->n_threads);
@@ -172,21 +218,63 @@ static int alloc_pkts(knot_xdp_msg_t *pkts, int npkts, struct knot_xdp_socket *x
 	return KNOT_EOK;
 }
 
+static bool account_reply(const knot_xdp_msg_t *msg, uint64_t now, lat_hist_t *stats)
+{
+	const uint8_t *wire = msg->payload.iov_base;
+	size_t len = msg->payload.iov_len;
+	if (len < KNOT_WIRE_HEADER_SIZE || !knot_wire_get_qr(wire)) {
+		return false;
+	}
+
+	// Only replies to the local ports used by the gun are counted.
+	uint16_t port = be16toh(msg->ip_to.sin6_family == AF_INET6 ? msg->ip_to.sin6_port :
+	                        ((const struct sockaddr_in *)&msg->ip_to)->sin_port);
+	if (port < LOCAL_PORT_MIN) {
+		return false;
+	}
+
+	// Duplicates and replies to overwritten (too old) queries aren't timed.
+	uint16_t id = knot_wire_get_id(wire);
+	uint64_t slot = __atomic_load_n(&global_inflight[id], __ATOMIC_ACQUIRE);
+	if (slot == 0 || (slot & 0xffff) != port ||
+	    !__atomic_compare_exchange_n(&global_inflight[id], &slot, 0, false,
+	                                 __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+		return true;
+	}
+
+	uint64_t sent = slot >> 16;
+	lat_hist_add(stats, now > sent ? now - sent : 0);
+
+	const struct pkt_payload *payl = __atomic_load_n(&global_inflight_payl[id],
+	                                                 __ATOMIC_RELAXED);
+	if (!reply_matches(payl, wire, len)) {
+		stats->mismatch++;
+	}
+
+	return true;
+}
+
 void *xdp_gun_thread(void *_ctx)
 {
 	xdp_gun_ctx_t *ctx = _ctx;
 	struct knot_xdp_socket *xsk;
-	struct timespec timer;
 	knot_xdp_msg_t pkts[ctx->at_once];
 	uint64_t tot_sent = 0, tot_recv = 0, tot_size = 0, errors = 0;
 	uint64_t duration = 0;
 
+	lat_hist_t *stats = calloc(1, sizeof(*stats));
+	if (stats == NULL) {
+		printf("failed to initialize statistics of thread#%u\n", ctx->thread_id);
+		return NULL;
+	}
+
 	knot_xdp_load_bpf_t mode = (ctx->thread_id == 0 ?
 	                            KNOT_XDP_LOAD_BPF_ALWAYS : KNOT_XDP_LOAD_BPF_NEVER);
 	int ret = knot_xdp_init(&xsk, ctx->dev, ctx->thread_id, ctx->listen_port, mode);
 	if (ret != KNOT_EOK) {
 		printf("failed to initialize XDP socket#%u: %s\n",
 		       ctx->thread_id, knot_strerror(ret));
+		free(stats);
 		return NULL;
 	}
 
@@ -196,34 +284,42 @@ void *xdp_gun_thread(void *_ctx)
 		usleep(1000);
 	}
 
-	uint64_t tick = 0;
+	uint64_t tick = 0, stats_sec = 0;
+	uint64_t replay_idx = ctx->thread_id;
 	struct pkt_payload *payload_ptr = NULL;
 	next_payload(&payload_ptr, ctx->thread_id);
 
-	timer_start(&timer);
+	uint64_t start = timer_usec();
 
 	while (duration < ctx->duration + 1000000) {
 
 		// sending part
 		if (duration < ctx->duration) {
-			while (1) {
+			uint64_t now = timer_usec();
+			unsigned npkts = ctx->at_once;
+			if (ctx->replay) {
+				npkts = replay_ready(payload_ptr, replay_idx, now - start, ctx);
+			}
+			while (npkts > 0) {
 				knot_xdp_send_prepare(xsk);
-				ret = alloc_pkts(pkts, ctx->at_once, xsk, ctx,
-				                 tick, &payload_ptr);
+				ret = alloc_pkts(pkts, npkts, xsk, ctx,
+				                 tick, now, &payload_ptr);
 				if (ret != KNOT_EOK) {
 					errors++;
 					break;
 				}
 
 				uint32_t really_sent = 0;
-				ret = knot_xdp_send(xsk, pkts, ctx->at_once,
+				ret = knot_xdp_send(xsk, pkts, npkts,
 				                    &really_sent);
 				if (ret != KNOT_EOK) {
 					errors++;
 					break;
 				}
-				assert(really_sent == ctx->at_once);
+				assert(really_sent == npkts);
 				tot_sent += really_sent;
+				stats->sent += really_sent;
+				replay_idx += really_sent * ctx->n_threads;
 
 				ret = knot_xdp_send_finish(xsk);
 				if (ret != KNOT_EOK) {
@@ -253,25 +349,39 @@ void *xdp_gun_thread(void *_ctx)
 					errors++;
 					break;
 				}
+				uint64_t now = timer_usec();
 				for (int i = 0; i < recvd; i++) {
-					if (pkts[i].payload.iov_len < KNOT_WIRE_HEADER_SIZE ||
-					    *(uint16_t *)(pkts[i].payload.iov_base + 0) != TRANSACTION_ID) {
+					if (!account_reply(&pkts[i], now, stats)) {
 						continue;
 					}
 					ctx->rcode_counts[((uint8_t *)pkts[i].payload.iov_base)[3] & 0xf]++;
 					tot_size += pkts[i].payload.iov_len;
 					tot_recv++;
+					stats->recv++;
 				}
 				knot_xdp_recv_finish(xsk, pkts, recvd);
 				pfd.revents = 0;
 			}
 		}
 
+		// statistics part
+		duration = timer_usec() - start;
+		if (duration / 1000000 != stats_sec) {
+			lat_series_flush(&global_series, stats, stats_sec);
+			stats_sec = duration / 1000000;
+		}
+
 		// speed part
-		uint64_t dura_exp = (tot_sent * 1000000) / ctx->qps;
-		duration = timer_end(&timer);
-		if (dura_exp > duration) {
-			usleep(dura_exp - duration);
+		if (ctx->replay) {
+			// Keep receiving while waiting for the next captured query.
+			if (replay_idx < global_payloads_count && payload_ptr->ts > duration) {
+				usleep(MIN(payload_ptr->ts - duration, 1000));
+			}
+		} else {
+			uint64_t dura_exp = (tot_sent * 1000000) / ctx->qps;
+			if (dura_exp > duration) {
+				usleep(dura_exp - duration);
+			}
 		}
 		if (duration > ctx->duration) {
 			usleep(1000);
@@ -281,6 +391,9 @@ void *xdp_gun_thread(void *_ctx)
 
 	knot_xdp_deinit(xsk);
 
+	lat_series_flush(&global_series, stats, stats_sec);
+	free(stats);
+
 	printf("thread#%02u: sent %lu, received %lu, errors %lu\n",
 	       ctx->thread_id, tot_sent, tot_recv, errors);
 	pthread_mutex_lock(&global_mutex);
@@ -548,9 +661,39 @@ static bool configure_target(char *target_str, char *local_ip, xdp_gun_ctx_t *ct
 	return true;
 }
 
+static bool configure_stream(char *target_str, char *local_ip, xdp_gun_ctx_t *ctx)
+{
+	int val;
+	char *at = strrchr(target_str, '@');
+	if (at != NULL && (val = atoi(at + 1)) > 0 && val <= 0xffff) {
+		ctx->target_port = val;
+		*at = '\0';
+	}
+
+	stream_ctx_t *stream = &ctx->stream;
+	ctx->ipv6 = (strchr(target_str, ':') != NULL);
+	int family = ctx->ipv6 ? AF_INET6 : AF_INET;
+	if (sockaddr_set(&stream->target, family, target_str, ctx->target_port) != KNOT_EOK) {
+		printf("invalid target IP\n");
+		return false;
+	}
+	stream->local.ss_family = AF_UNSPEC;
+	if (local_ip != NULL && sockaddr_set(&stream->local, family, local_ip, 0) != KNOT_EOK) {
+		printf("invalid local IP\n");
+		return false;
+	}
+
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	ctx->n_threads = MAX(1, MIN(cpus, stream->connections));
+
+	return true;
+}
+
 static void print_help(void) {
-	printf("Usage: %s [-t duration] [-Q qps] [-b batch_size] [-r] [-p port] "
-	       "[-F cpu_affinity] [-I interface] [-l local_ip] -i queries_file dest_ip\n",
+	printf("Usage: %s [-t duration] [-Q qps] [-b batch_size] [-r] [-p port] [-L] "
+	       "[-F cpu_affinity] [-I interface] [-l local_ip] "
+	       "[{-U | -T | -S} [-C connections] [-N queries] [-P depth] [-O churn]] "
+	       "{-i queries_file | -R capture_file} dest_ip\n",
 	       PROGRAM_NAME);
 }
 
@@ -568,13 +711,24 @@ static bool get_opts(int argc, char *argv[], xdp_gun_ctx_t *ctx)
 		{ "interface", required_argument, NULL, 'I' },
 		{ "local",     required_argument, NULL, 'l' },
 		{ "infile",    required_argument, NULL, 'i' },
+		{ "replay",    required_argument, NULL, 'R' },
+		{ "latency",   no_argument,       NULL, 'L' },
+		{ "udp",          no_argument,       NULL, 'U' },
+		{ "tcp",          no_argument,       NULL, 'T' },
+		{ "tls",          no_argument,       NULL, 'S' },
+		{ "connections",  required_argument, NULL, 'C' },
+		{ "conn-queries", required_argument, NULL, 'N' },
+		{ "pipeline",     required_argument, NULL, 'P' },
+		{ "churn",        required_argument, NULL, 'O' },
 		{ NULL }
 	};
 
 	int opt = 0, arg;
 	double argf;
-	char *argcp, *local_ip = NULL;
-	while ((opt = getopt_long(argc, argv, "hVt:Q:b:rp:F:I:l:i:", opts, NULL)) != -1) {
+	bool duration_set = false, port_set = false;
+	char *argcp, *local_ip = NULL, *replay_file = NULL;
+	while ((opt = getopt_long(argc, argv, "hVt:Q:b:rp:F:I:l:i:R:LUTSC:N:P:O:",
+	                          opts, NULL)) != -1) {
 		switch (opt) {
 		case 'h':
 			print_help();
@@ -589,6 +743,7 @@ static bool get_opts(int argc, char *argv[], xdp_gun_ctx_t *ctx)
 			if (argf > 0) {
 				ctx->duration = argf * 1000000.0;
 				assert(ctx->duration >= 1000);
+				duration_set = true;
 			} else {
 				return false;
 			}
@@ -616,6 +771,7 @@ static bool get_opts(int argc, char *argv[], xdp_gun_ctx_t *ctx)
 			arg = atoi(optarg);
 			if (arg > 0 && arg <= 0xffff) {
 				ctx->target_port = arg;
+				port_set = true;
 			} else {
 				return false;
 			}
@@ -636,7 +792,61 @@ static bool get_opts(int argc, char *argv[], xdp_gun_ctx_t *ctx)
 			local_ip = optarg;
 			break;
 		case 'i':
-			if (!load_queries(optarg)) {
+			if (global_payloads != NULL || replay_file != NULL ||
+			    !load_queries(optarg)) {
+				return false;
+			}
+			break;
+		case 'R':
+			if (global_payloads != NULL) {
+				return false;
+			}
+			replay_file = optarg;
+			ctx->replay = true;
+			break;
+		case 'L':
+			ctx->print_seconds = true;
+			break;
+		case 'U':
+			ctx->use_stream = true;
+			ctx->stream.udp = true;
+			break;
+		case 'T':
+			ctx->use_stream = true;
+			break;
+		case 'S':
+			ctx->use_stream = true;
+			ctx->stream.tls = true;
+			break;
+		case 'C':
+			arg = atoi(optarg);
+			if (arg > 0) {
+				ctx->stream.connections = arg;
+			} else {
+				return false;
+			}
+			break;
+		case 'N':
+			arg = atoi(optarg);
+			if (arg >= 0) {
+				ctx->stream.conn_queries = arg;
+			} else {
+				return false;
+			}
+			break;
+		case 'P':
+			arg = atoi(optarg);
+			if (arg > 0 && arg <= UINT16_MAX) {
+				ctx->stream.pipeline = arg;
+			} else {
+				return false;
+			}
+			break;
+		case 'O':
+			argf = atof(optarg);
+			if (argf >= 0) {
+				ctx->stream.churn = argf;
+			} else {
 				return false;
 			}
 			break;
@@ -644,21 +854,175 @@ static bool get_opts(int argc, char *argv[], xdp_gun_ctx_t *ctx)
 			return false;
 		}
 	}
-	if (global_payloads == NULL || argc - optind != 1 ||
-	    !configure_target(argv[optind], local_ip, ctx)) {
+	if ((global_payloads == NULL && replay_file == NULL) || argc - optind != 1) {
+		return false;
+	}
+
+	if (ctx->use_stream) {
+		if (ctx->replay || ctx->listen_port == KNOT_XDP_LISTEN_PORT_DROP) {
+			printf("replay and drop modes are not supported with kernel sockets\n");
+			return false;
+		}
+		if (ctx->stream.udp && ctx->stream.tls) {
+			printf("UDP and TLS modes are mutually exclusive\n");
+			return false;
+		}
+		if (ctx->stream.tls && !port_set) {
+			ctx->target_port = 853;
+		}
+		if (!configure_stream(argv[optind], local_ip, ctx)) {
+			return false;
+		}
+	} else if (!configure_target(argv[optind], local_ip, ctx)) {
 		return false;
 	}
 
-	if (ctx->qps < ctx->n_threads) {
+	if (ctx->replay) {
+		// The captured queries are filtered by the target port.
+		if (!load_replay(replay_file, ctx->target_port)) {
+			return false;
+		}
+		uint64_t span = 1000;
+		for (struct pkt_payload *p = global_payloads; p != NULL; p = p->next) {
+			span = MAX(span, p->ts + 1);
+		}
+		ctx->duration = duration_set ? MIN(ctx->duration, span) : span;
+		printf("replaying %zu queries over %.3f s\n", global_payloads_count,
+		       ctx->duration / 1000000.0);
+	} else if (ctx->qps < ctx->n_threads) {
 		printf("QPS must be at least the number of threads (%u)\n", ctx->n_threads);
 		return false;
 	}
 	ctx->qps /= ctx->n_threads;
-	printf("using interface %s, XDP threads %d\n", ctx->dev, ctx->n_threads);
+	if (ctx->use_stream) {
+		printf("using %s, threads %u, connections %u\n", ctx->stream.udp ? "UDP" :
+		       ctx->stream.tls ? "TLS" : "TCP", ctx->n_threads, ctx->stream.connections);
+	} else {
+		printf("using interface %s, XDP threads %d\n", ctx->dev, ctx->n_threads);
+	}
 
 	return true;
 }
 
+static void print_latency(const xdp_gun_ctx_t *ctx)
+{
+	lat_hist_t *total = calloc(1, sizeof(*total));
+	if (total == NULL) {
+		return;
+	}
+
+	if (ctx->print_seconds) {
+		printf("%-8s%12s%12s%10s%10s%10s%10s\n", "second", "sent", "replies",
+		       "mismatch", "p50[us]", "p99[us]", "p999[us]");
+	}
+	for (size_t i = 0; i < global_series.count; i++) {
+		const lat_hist_t *sec = &global_series.seconds[i];
+		if (ctx->print_seconds && (sec->sent > 0 || sec->recv > 0)) {
+			printf("%-8zu%12lu%12lu%10lu%10lu%10lu%10lu\n", i, sec->sent,
+			       sec->recv, sec->mismatch, lat_hist_quantile(sec, 0.5),
+			       lat_hist_quantile(sec, 0.99), lat_hist_quantile(sec, 0.999));
+		}
+		lat_hist_merge(total, sec);
+	}
+
+	if (lat_hist_samples(total) > 0) {
+		printf("reply latency p50 %lu us, p99 %lu us, p999 %lu us\n",
+		       lat_hist_quantile(total, 0.5), lat_hist_quantile(total, 0.99),
+		       lat_hist_quantile(total, 0.999));
+	}
+	printf("mismatched replies: %lu\n", total->mismatch);
+
+	free(total);
+}
+
+static void print_stream(const xdp_gun_ctx_t *thread_ctxs, unsigned n_threads)
+{
+	lat_hist_t *handshake = calloc(1, sizeof(*handshake));
+	if (handshake == NULL) {
+		return;
+	}
+
+	uint64_t conns = 0, conn_errors = 0;
+	for (size_t i = 0; i < n_threads; i++) {
+		const stream_ctx_t *stream = &thread_ctxs[i].stream;
+		conns += stream->conns;
+		conn_errors += stream->conn_errors;
+		lat_hist_merge(handshake, stream->handshake);
+	}
+
+	printf("total connections: %lu (errors %lu)\n", conns, conn_errors);
+	if (lat_hist_samples(handshake) > 0) {
+		printf("%s latency p50 %lu us, p99 %lu us, p999 %lu us\n",
+		       thread_ctxs[0].stream.tls ? "TLS handshake" : "TCP connect",
+		       lat_hist_quantile(handshake, 0.5), lat_hist_quantile(handshake, 0.99),
+		       lat_hist_quantile(handshake, 0.999));
+	}
+
+	free(handshake);
+}
+
+static void collect_stream(xdp_gun_ctx_t *thread_ctxs, unsigned n_threads)
+{
+	for (size_t i = 0; i < n_threads; i++) {
+		xdp_gun_ctx_t *ctx = &thread_ctxs[i];
+		global_pkts_sent += ctx->stream.sent;
+		global_pkts_recv += ctx->stream.recv;
+		global_size_recv += ctx->stream.size_recv;
+		for (int j = 0; j < KNOWN_RCODE_MAX; j++) {
+			ctx->rcode_counts[j] = ctx->stream.rcode_counts[j];
+		}
+	}
+}
+
+static int init_thread_ctxs(xdp_gun_ctx_t *thread_ctxs, const xdp_gun_ctx_t *ctx)
+{
+	for (int i = 0; i < ctx->n_threads; i++) {
+		thread_ctxs[i] = *ctx;
+		thread_ctxs[i].thread_id = i;
+		if (!ctx->use_stream) {
+			continue;
+		}
+
+		stream_ctx_t *stream = &thread_ctxs[i].stream;
+		stream->thread_id = i;
+		stream->qps = ctx->qps;
+		stream->duration = ctx->duration;
+		stream->connections = ctx->stream.connections / ctx->n_threads +
+		                      (i < ctx->stream.connections % ctx->n_threads);
+		stream->churn = ctx->stream.churn / ctx->n_threads;
+		stream->series = &global_series;
+		stream->handshake = calloc(1, sizeof(*stream->handshake));
+		if (stream->handshake == NULL) {
+			return KNOT_ENOMEM;
+		}
+	}
+
+	return KNOT_EOK;
+}
+
+static void free_thread_ctxs(xdp_gun_ctx_t *thread_ctxs, unsigned n_threads)
+{
+	for (size_t i = 0; thread_ctxs != NULL && i < n_threads; i++) {
+		free(thread_ctxs[i].stream.handshake);
+	}
+	free(thread_ctxs);
+}
+
+static int set_limits(const xdp_gun_ctx_t *ctx)
+{
+	struct rlimit limit = { RLIM_INFINITY, RLIM_INFINITY };
+	if (!ctx->use_stream) {
+		return setrlimit(RLIMIT_MEMLOCK, &limit);
+	}
+
+	// Many connections need many file descriptors.
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+		limit.rlim_cur = limit.rlim_max;
+		(void)setrlimit(RLIMIT_NOFILE, &limit);
+	}
+	return 0;
+}
+
 int main(int argc, char *argv[])
 {
 	xdp_gun_ctx_t ctx = ctx_defaults, *thread_ctxs = NULL;
@@ -670,27 +1034,27 @@ int main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
-	TRANSACTION_ID = time(NULL) % UINT16_MAX;
-
+	// Statistics of the sending seconds and of the trailing receiving second.
+	int ret = lat_series_init(&global_series, ctx.duration / 1000000 + 2);
 	thread_ctxs = calloc(ctx.n_threads, sizeof(*thread_ctxs));
 	threads = calloc(ctx.n_threads, sizeof(*threads));
-	if (thread_ctxs == NULL || threads == NULL) {
+	if (ret != KNOT_EOK || thread_ctxs == NULL || threads == NULL ||
+	    init_thread_ctxs(thread_ctxs, &ctx) != KNOT_EOK ||
+	    stream_init(ctx.use_stream && ctx.stream.tls) != KNOT_EOK) {
 		printf("out of memory\n");
-		free(thread_ctxs);
+		lat_series_deinit(&global_series);
+		free_thread_ctxs(thread_ctxs, ctx.n_threads);
 		free(threads);
 		free_global_payloads();
 		return EXIT_FAILURE;
 	}
-	for (int i = 0; i < ctx.n_threads; i++) {
-		thread_ctxs[i] = ctx;
-		thread_ctxs[i].thread_id = i;
-	}
 
-	struct rlimit no_limit = { RLIM_INFINITY, RLIM_INFINITY };
-	int ret = setrlimit(RLIMIT_MEMLOCK, &no_limit);
+	ret = set_limits(&ctx);
 	if (ret != 0) {
 		printf("unable to unset memory lock limit: %s\n", strerror(errno));
-		free(thread_ctxs);
+		stream_deinit();
+		lat_series_deinit(&global_series);
+		free_thread_ctxs(thread_ctxs, ctx.n_threads);
 		free(threads);
 		free_global_payloads();
 		return EXIT_FAILURE;
@@ -702,7 +1066,12 @@ int main(int argc, char *argv[])
 		cpu_set_t set;
 		CPU_ZERO(&set);
 		CPU_SET(affinity, &set);
-		(void)pthread_create(&threads[i], NULL, xdp_gun_thread, &thread_ctxs[i]);
+		if (ctx.use_stream) {
+			(void)pthread_create(&threads[i], NULL, stream_gun_thread,
+			                     &thread_ctxs[i].stream);
+		} else {
+			(void)pthread_create(&threads[i], NULL, xdp_gun_thread, &thread_ctxs[i]);
+		}
 		ret = pthread_setaffinity_np(threads[i], sizeof(cpu_set_t), &set);
 		if (ret != 0) {
 			printf("failed to set affinity of thread#%zu to CPU#%u\n", i, affinity);
@@ -719,13 +1088,18 @@ int main(int argc, char *argv[])
 		pthread_join(threads[i], NULL);
 	}
 	pthread_mutex_destroy(&global_mutex);
+	if (ctx.use_stream) {
+		collect_stream(thread_ctxs, ctx.n_threads);
+	}
 	printf("total queries: %lu (%lu pps)\n", global_pkts_sent, global_pkts_sent * 1000 / (ctx.duration / 1000));
 	if (global_pkts_sent > 0 && ctx.listen_port != KNOT_XDP_LISTEN_PORT_DROP) {
 		printf("total replies: %lu (%lu pps) (%lu%%)\n", global_pkts_recv,
 		       global_pkts_recv * 1000 / (ctx.duration / 1000), global_pkts_recv * 100 / global_pkts_sent);
 		printf("average DNS reply size: %lu B\n", global_pkts_recv > 0 ? global_size_recv / global_pkts_recv : 0);
-		size_t bytes_recv = global_size_recv + (ctx.ipv6 ? KNOT_XDP_PAYLOAD_OFFSET6 : KNOT_XDP_PAYLOAD_OFFSET4) * global_pkts_recv;
-		printf("average Ethernet reply rate: %lu bps\n", bytes_recv * 8 * 1000 / (ctx.duration / 1000));
+		if (!ctx.use_stream) {
+			size_t bytes_recv = global_size_recv + (ctx.ipv6 ? KNOT_XDP_PAYLOAD_OFFSET6 : KNOT_XDP_PAYLOAD_OFFSET4) * global_pkts_recv;
+			printf("average Ethernet reply rate: %lu bps\n", bytes_recv * 8 * 1000 / (ctx.duration / 1000));
+		}
 		for (int i = 0; i < KNOWN_RCODE_MAX; i++) {
 			uint64_t rcode_count = 0;
 			for (size_t j = 0; j < ctx.n_threads; j++) {
@@ -737,9 +1111,15 @@ int main(int argc, char *argv[])
 				printf("responded %s: %lu\n", rcname, rcode_count);
 			}
 		}
+		print_latency(&ctx);
+	}
+	if (ctx.use_stream) {
+		print_stream(thread_ctxs, ctx.n_threads);
 	}
 
-	free(thread_ctxs);
+	stream_deinit();
+	lat_series_deinit(&global_series);
+	free_thread_ctxs(thread_ctxs, ctx.n_threads);
 	free(threads);
 	free_global_payloads();
 	return EXIT_SUCCESS;
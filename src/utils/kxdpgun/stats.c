@@ -0,0 +1,132 @@
+/*  Copyright (C) 2021 CZ.NIC, z.s.p.o. <knot-dns@labs.nic.cz>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libknot/errcode.h"
+#include "utils/kxdpgun/stats.h"
+
+static unsigned bucket_of(uint64_t usecs)
+{
+	if (usecs >= UINT32_MAX) {
+		return LAT_BUCKETS - 1;
+	}
+	if (usecs < LAT_SUB_COUNT) {
+		return usecs;
+	}
+
+	unsigned exp = 63 - __builtin_clzll(usecs);
+	unsigned sub = (usecs >> (exp - LAT_SUB_BITS)) & (LAT_SUB_COUNT - 1);
+	return ((exp - LAT_SUB_BITS + 1) << LAT_SUB_BITS) + sub;
+}
+
+static uint64_t bucket_max(unsigned bucket)
+{
+	if (bucket < LAT_SUB_COUNT) {
+		return bucket;
+	}
+
+	unsigned exp = (bucket >> LAT_SUB_BITS) + LAT_SUB_BITS - 1;
+	uint64_t sub = bucket & (LAT_SUB_COUNT - 1);
+	return ((LAT_SUB_COUNT + sub + 1) << (exp - LAT_SUB_BITS)) - 1;
+}
+
+void lat_hist_add(lat_hist_t *hist, uint64_t usecs)
+{
+	hist->buckets[bucket_of(usecs)]++;
+}
+
+void lat_hist_merge(lat_hist_t *dst, const lat_hist_t *src)
+{
+	dst->sent += src->sent;
+	dst->recv += src->recv;
+	dst->mismatch += src->mismatch;
+	for (unsigned i = 0; i < LAT_BUCKETS; i++) {
+		dst->buckets[i] += src->buckets[i];
+	}
+}
+
+uint64_t lat_hist_samples(const lat_hist_t *hist)
+{
+	uint64_t total = 0;
+	for (unsigned i = 0; i < LAT_BUCKETS; i++) {
+		total += hist->buckets[i];
+	}
+	return total;
+}
+
+uint64_t lat_hist_quantile(const lat_hist_t *hist, double quantile)
+{
+	uint64_t total = lat_hist_samples(hist);
+	if (total == 0) {
+		return 0;
+	}
+
+	uint64_t rank = quantile * total;
+	if (rank < 1) {
+		rank = 1;
+	} else if (rank > total) {
+		rank = total;
+	}
+
+	uint64_t seen = 0;
+	for (unsigned i = 0; i < LAT_BUCKETS; i++) {
+		seen += hist->buckets[i];
+		if (seen >= rank) {
+			return bucket_max(i);
+		}
+	}
+
+	return bucket_max(LAT_BUCKETS - 1);
+}
+
+int lat_series_init(lat_series_t *series, size_t count)
+{
+	series->seconds = calloc(count, sizeof(*series->seconds));
+	if (series->seconds == NULL) {
+		return KNOT_ENOMEM;
+	}
+	series->count = count;
+	pthread_mutex_init(&series->mutex, NULL);
+
+	return KNOT_EOK;
+}
+
+void lat_series_flush(lat_series_t *series, lat_hist_t *hist, uint64_t second)
+{
+	if (second >= series->count) {
+		second = series->count - 1;
+	}
+
+	pthread_mutex_lock(&series->mutex);
+	lat_hist_merge(&series->seconds[second], hist);
+	pthread_mutex_unlock(&series->mutex);
+
+	memset(hist, 0, sizeof(*hist));
+}
+
+void lat_series_deinit(lat_series_t *series)
+{
+	if (series->seconds == NULL) {
+		return;
+	}
+
+	pthread_mutex_destroy(&series->mutex);
+	free(series->seconds);
+	series->seconds = NULL;
+	series->count = 0;
+}
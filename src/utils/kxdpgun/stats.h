@@ -0,0 +1,92 @@
+/*  Copyright (C) 2021 CZ.NIC, z.s.p.o. <knot-dns@labs.nic.cz>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * Log-linear latency histogram with microsecond resolution.
+ *
+ * Latencies below 2^LAT_SUB_BITS usecs have their own bucket, each higher
+ * power of two is split into 2^LAT_SUB_BITS equal buckets, so the relative
+ * error is bounded by ~3 %.
+ */
+#define LAT_SUB_BITS	5
+#define LAT_SUB_COUNT	(1 << LAT_SUB_BITS)
+#define LAT_BUCKETS	((32 - LAT_SUB_BITS + 1) * LAT_SUB_COUNT)
+
+typedef struct {
+	uint64_t sent;
+	uint64_t recv;
+	uint64_t mismatch;
+	uint64_t buckets[LAT_BUCKETS];
+} lat_hist_t;
+
+/*!
+ * \brief Accounts one latency sample (in usecs).
+ */
+void lat_hist_add(lat_hist_t *hist, uint64_t usecs);
+
+/*!
+ * \brief Adds all counters and samples of 'src' to 'dst'.
+ */
+void lat_hist_merge(lat_hist_t *dst, const lat_hist_t *src);
+
+/*!
+ * \brief Returns the number of latency samples in the histogram.
+ */
+uint64_t lat_hist_samples(const lat_hist_t *hist);
+
+/*!
+ * \brief Returns an upper estimate of the given latency quantile (in usecs).
+ *
+ * \param hist      Histogram.
+ * \param quantile  Requested quantile from the interval (0, 1].
+ *
+ * \return Latency or 0 if no samples.
+ */
+uint64_t lat_hist_quantile(const lat_hist_t *hist, double quantile);
+
+/*!
+ * Per-second histograms shared by all threads.
+ */
+typedef struct {
+	pthread_mutex_t mutex;
+	lat_hist_t *seconds;
+	size_t count;
+} lat_series_t;
+
+/*!
+ * \brief Allocates the series for the given number of seconds.
+ *
+ * \return KNOT_E*
+ */
+int lat_series_init(lat_series_t *series, size_t count);
+
+/*!
+ * \brief Merges the thread histogram into the given second and clears it.
+ *
+ * \note Samples beyond the series are accounted in the last second.
+ */
+void lat_series_flush(lat_series_t *series, lat_hist_t *hist, uint64_t second);
+
+/*!
+ * \brief Frees the series.
+ */
+void lat_series_deinit(lat_series_t *series);
@@ -0,0 +1,614 @@
+/*  Copyright (C) 2021 CZ.NIC, z.s.p.o. <knot-dns@labs.nic.cz>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <gnutls/gnutls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+
+#include "libknot/libknot.h"
+#include "contrib/macros.h"
+#include "contrib/sockaddr.h"
+#include "utils/kxdpgun/load_queries.h"
+#include "utils/kxdpgun/stream.h"
+
+#define EPOLL_EVENTS	64
+#define RECV_TAIL	1000000 // Receiving time after sending stops (usecs).
+#define MSG_MAX		(2 + UINT16_MAX)
+#define RBUF_INIT	4096
+#define UDP_TIMEOUT	1000000 // Timeout for outstanding UDP queries (usecs).
+
+typedef enum {
+	CONN_CLOSED = 0,
+	CONN_CONNECTING,
+	CONN_HANDSHAKE,
+	CONN_ACTIVE,
+} conn_state_t;
+
+typedef struct {
+	int fd;
+	conn_state_t state;
+	uint32_t events;
+	gnutls_session_t tls;
+	uint64_t start;
+	uint64_t last;  // Last query or reply.
+	uint64_t sent, recv;
+	const struct pkt_payload **inflight_payl;
+	uint64_t *inflight_ts;
+	uint8_t *wbuf;
+	size_t wlen, wpos;
+	uint8_t *rbuf;
+	size_t rlen, rsize;
+} conn_t;
+
+typedef struct {
+	stream_ctx_t *ctx;
+	int epfd;
+	conn_t *conns;
+	lat_hist_t *stats;
+	const struct pkt_payload *payl;
+	uint64_t now;
+	uint64_t budget; // Queries allowed to be sent now.
+	bool sending;
+} gun_t;
+
+static gnutls_certificate_credentials_t tls_creds = NULL;
+
+static const gnutls_datum_t dot_alpn = { (unsigned char *)"dot", 3 };
+
+inline static uint64_t timer_usec(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * (uint64_t)1000000 + now.tv_nsec / 1000;
+}
+
+int stream_init(bool tls)
+{
+	if (!tls) {
+		return KNOT_EOK;
+	}
+
+	if (gnutls_certificate_allocate_credentials(&tls_creds) != GNUTLS_E_SUCCESS) {
+		return KNOT_ENOMEM;
+	}
+
+	return KNOT_EOK;
+}
+
+void stream_deinit(void)
+{
+	if (tls_creds != NULL) {
+		gnutls_certificate_free_credentials(tls_creds);
+		tls_creds = NULL;
+	}
+}
+
+static void conn_want(gun_t *g, conn_t *conn, uint32_t events)
+{
+	if (conn->events == events) {
+		return;
+	}
+
+	struct epoll_event ev = { .events = events, .data.ptr = conn };
+	(void)epoll_ctl(g->epfd, EPOLL_CTL_MOD, conn->fd, &ev);
+	conn->events = events;
+}
+
+static void conn_close(gun_t *g, conn_t *conn, bool graceful)
+{
+	if (conn->tls != NULL) {
+		if (graceful) {
+			(void)gnutls_bye(conn->tls, GNUTLS_SHUT_WR);
+		}
+		gnutls_deinit(conn->tls);
+		conn->tls = NULL;
+	}
+	if (conn->fd >= 0) {
+		close(conn->fd);
+		conn->fd = -1;
+	}
+
+	// Unanswered queries are lost.
+	conn->state = CONN_CLOSED;
+	conn->wlen = 0;
+	conn->wpos = 0;
+	conn->rlen = 0;
+}
+
+static void conn_fail(gun_t *g, conn_t *conn)
+{
+	g->ctx->conn_errors++;
+	conn_close(g, conn, false);
+}
+
+static int conn_open(gun_t *g, conn_t *conn)
+{
+	const stream_ctx_t *ctx = g->ctx;
+
+	int type = ctx->udp ? SOCK_DGRAM : SOCK_STREAM;
+	int fd = socket(ctx->target.ss_family, type | SOCK_NONBLOCK, 0);
+	if (fd < 0) {
+		return knot_map_errno();
+	}
+
+	if (!ctx->udp) {
+		int one = 1;
+		(void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	}
+
+	if (ctx->local.ss_family != AF_UNSPEC &&
+	    bind(fd, (const struct sockaddr *)&ctx->local, sockaddr_len(&ctx->local)) != 0) {
+		int ret = knot_map_errno();
+		close(fd);
+		return ret;
+	}
+
+	if (connect(fd, (const struct sockaddr *)&ctx->target,
+	            sockaddr_len(&ctx->target)) != 0 && errno != EINPROGRESS) {
+		int ret = knot_map_errno();
+		close(fd);
+		return ret;
+	}
+
+	// Connected UDP socket is usable immediately.
+	struct epoll_event ev = { .events = ctx->udp ? EPOLLIN : EPOLLOUT, .data.ptr = conn };
+	if (epoll_ctl(g->epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+		int ret = knot_map_errno();
+		close(fd);
+		return ret;
+	}
+
+	conn->fd = fd;
+	conn->events = ev.events;
+	conn->state = ctx->udp ? CONN_ACTIVE : CONN_CONNECTING;
+	conn->start = g->now;
+	conn->last = g->now;
+	conn->sent = 0;
+	conn->recv = 0;
+
+	return KNOT_EOK;
+}
+
+static int tls_start(conn_t *conn)
+{
+	if (gnutls_init(&conn->tls, GNUTLS_CLIENT | GNUTLS_NONBLOCK) != GNUTLS_E_SUCCESS) {
+		conn->tls = NULL;
+		return KNOT_ENOMEM;
+	}
+
+	if (gnutls_set_default_priority(conn->tls) != GNUTLS_E_SUCCESS ||
+	    gnutls_credentials_set(conn->tls, GNUTLS_CRD_CERTIFICATE, tls_creds) != GNUTLS_E_SUCCESS ||
+	    gnutls_alpn_set_protocols(conn->tls, &dot_alpn, 1, 0) != GNUTLS_E_SUCCESS) {
+		gnutls_deinit(conn->tls);
+		conn->tls = NULL;
+		return KNOT_ERROR;
+	}
+	gnutls_transport_set_int(conn->tls, conn->fd);
+
+	return KNOT_EOK;
+}
+
+static int tls_handshake(gun_t *g, conn_t *conn)
+{
+	int ret = gnutls_handshake(conn->tls);
+	if (ret == GNUTLS_E_SUCCESS) {
+		return KNOT_EOK;
+	} else if (gnutls_error_is_fatal(ret)) {
+		return KNOT_NET_ECONNECT;
+	}
+
+	conn_want(g, conn, gnutls_record_get_direction(conn->tls) ? EPOLLOUT : EPOLLIN);
+	return KNOT_EAGAIN;
+}
+
+/*! \brief Returns the number of bytes sent, 0 if it would block, or -1. */
+static ssize_t conn_send(conn_t *conn, const uint8_t *data, size_t len)
+{
+	ssize_t ret;
+	if (conn->tls != NULL) {
+		ret = gnutls_record_send(conn->tls, data, len);
+		if (ret == GNUTLS_E_AGAIN || ret == GNUTLS_E_INTERRUPTED) {
+			return 0;
+		}
+	} else {
+		ret = send(conn->fd, data, len, MSG_NOSIGNAL);
+		if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+			return 0;
+		}
+	}
+	return (ret < 0) ? -1 : ret;
+}
+
+/*! \brief Returns the number of bytes received, 0 if it would block, or -1. */
+static ssize_t conn_recv(conn_t *conn, uint8_t *data, size_t len)
+{
+	ssize_t ret;
+	if (conn->tls != NULL) {
+		ret = gnutls_record_recv(conn->tls, data, len);
+		if (ret == GNUTLS_E_AGAIN || ret == GNUTLS_E_INTERRUPTED) {
+			return 0;
+		}
+	} else {
+		ret = recv(conn->fd, data, len, 0);
+		if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+			return 0;
+		}
+	}
+	return (ret <= 0) ? -1 : ret;
+}
+
+static bool conn_flush(gun_t *g, conn_t *conn)
+{
+	while (conn->wpos < conn->wlen) {
+		ssize_t ret = conn_send(conn, conn->wbuf + conn->wpos, conn->wlen - conn->wpos);
+		if (ret < 0) {
+			return false;
+		} else if (ret == 0) {
+			conn_want(g, conn, EPOLLIN | EPOLLOUT);
+			return true;
+		}
+		conn->wpos += ret;
+	}
+
+	conn->wlen = 0;
+	conn->wpos = 0;
+	conn_want(g, conn, EPOLLIN);
+	return true;
+}
+
+static bool conn_query(gun_t *g, conn_t *conn)
+{
+	const stream_ctx_t *ctx = g->ctx;
+
+	// Waiting until the previous queries are written.
+	if (conn->wlen > 0) {
+		return true;
+	}
+
+	// Pipelined queries are written at once.
+	while (g->budget > 0 && conn->sent - conn->recv < ctx->pipeline &&
+	       (ctx->conn_queries == 0 || conn->sent < ctx->conn_queries)) {
+		const struct pkt_payload *payl = g->payl;
+		uint8_t *msg = conn->wbuf + conn->wlen;
+		knot_wire_write_u16(msg, payl->len);
+		memcpy(msg + 2, payl->payload, payl->len);
+		knot_wire_set_id(msg + 2, conn->sent);
+
+		// Each UDP query is a separate datagram.
+		if (ctx->udp) {
+			if (send(conn->fd, msg + 2, payl->len, 0) != payl->len) {
+				return false;
+			}
+		} else {
+			conn->wlen += 2 + payl->len;
+		}
+
+		unsigned slot = conn->sent % ctx->pipeline;
+		conn->inflight_payl[slot] = payl;
+		conn->inflight_ts[slot] = g->now;
+
+		conn->last = g->now;
+		conn->sent++;
+		g->ctx->sent++;
+		g->stats->sent++;
+		g->budget--;
+		g->payl = (payl->next != NULL) ? payl->next : global_payloads;
+	}
+
+	return (conn->wlen == 0) || conn_flush(g, conn);
+}
+
+static void conn_reply(gun_t *g, conn_t *conn, const uint8_t *wire, size_t len)
+{
+	stream_ctx_t *ctx = g->ctx;
+
+	if (len < KNOT_WIRE_HEADER_SIZE || !knot_wire_get_qr(wire)) {
+		ctx->errors++;
+		return;
+	}
+
+	// Match the ID with one of the outstanding queries.
+	uint16_t age = conn->sent - 1 - knot_wire_get_id(wire);
+	if (age >= conn->sent - conn->recv) {
+		g->stats->mismatch++;
+		return;
+	}
+	unsigned slot = (conn->sent - 1 - age) % ctx->pipeline;
+
+	uint64_t sent = conn->inflight_ts[slot];
+	lat_hist_add(g->stats, g->now > sent ? g->now - sent : 0);
+	if (!reply_matches(conn->inflight_payl[slot], wire, len)) {
+		g->stats->mismatch++;
+	}
+
+	ctx->rcode_counts[knot_wire_get_rcode(wire)]++;
+	ctx->size_recv += len;
+	ctx->recv++;
+	g->stats->recv++;
+	conn->recv++;
+	conn->last = g->now;
+}
+
+static bool conn_rbuf_reserve(conn_t *conn, size_t size)
+{
+	if (conn->rsize >= size) {
+		return true;
+	}
+
+	uint8_t *rbuf = realloc(conn->rbuf, size);
+	if (rbuf == NULL) {
+		return false;
+	}
+	conn->rbuf = rbuf;
+	conn->rsize = size;
+
+	return true;
+}
+
+static bool conn_read_udp(gun_t *g, conn_t *conn)
+{
+	while (true) {
+		ssize_t ret = recv(conn->fd, conn->rbuf, conn->rsize, 0);
+		if (ret < 0) {
+			return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+		}
+		conn_reply(g, conn, conn->rbuf, ret);
+	}
+}
+
+static bool conn_read(gun_t *g, conn_t *conn)
+{
+	if (g->ctx->udp) {
+		return conn_read_udp(g, conn);
+	}
+
+	while (true) {
+		if (conn->rlen == conn->rsize &&
+		    !conn_rbuf_reserve(conn, MIN(2 * conn->rsize, MSG_MAX))) {
+			return false;
+		}
+
+		ssize_t ret = conn_recv(conn, conn->rbuf + conn->rlen, conn->rsize - conn->rlen);
+		if (ret < 0) {
+			return false;
+		} else if (ret == 0) {
+			return true;
+		}
+		conn->rlen += ret;
+
+		size_t pos = 0;
+		while (conn->rlen - pos >= 2) {
+			size_t msg_len = knot_wire_read_u16(conn->rbuf + pos);
+			if (conn->rlen - pos < 2 + msg_len) {
+				if (!conn_rbuf_reserve(conn, 2 + msg_len)) {
+					return false;
+				}
+				break;
+			}
+			conn_reply(g, conn, conn->rbuf + pos + 2, msg_len);
+			pos += 2 + msg_len;
+		}
+		memmove(conn->rbuf, conn->rbuf + pos, conn->rlen - pos);
+		conn->rlen -= pos;
+	}
+}
+
+static void conn_established(gun_t *g, conn_t *conn)
+{
+	conn->state = CONN_ACTIVE;
+	lat_hist_add(g->ctx->handshake, g->now - conn->start);
+	conn_want(g, conn, EPOLLIN);
+
+	if (g->sending && !conn_query(g, conn)) {
+		conn_close(g, conn, false);
+	}
+}
+
+static void conn_event(gun_t *g, conn_t *conn, uint32_t events)
+{
+	const stream_ctx_t *ctx = g->ctx;
+	int err = 0;
+	socklen_t err_len = sizeof(err);
+
+	switch (conn->state) {
+	case CONN_CONNECTING:
+		if (getsockopt(conn->fd, SOL_SOCKET, SO_ERROR, &err, &err_len) != 0 || err != 0) {
+			conn_fail(g, conn);
+			return;
+		}
+		if (!ctx->tls) {
+			conn_established(g, conn);
+			return;
+		}
+		if (tls_start(conn) != KNOT_EOK) {
+			conn_fail(g, conn);
+			return;
+		}
+		conn->state = CONN_HANDSHAKE;
+		// FALLTHROUGH
+	case CONN_HANDSHAKE:
+		switch (tls_handshake(g, conn)) {
+		case KNOT_EOK:
+			conn_established(g, conn);
+			break;
+		case KNOT_EAGAIN:
+			break;
+		default:
+			conn_fail(g, conn);
+			break;
+		}
+		return;
+	case CONN_ACTIVE:
+		if (((events & EPOLLIN) && !conn_read(g, conn)) ||
+		    ((events & EPOLLOUT) && !conn_flush(g, conn)) ||
+		    (events & (EPOLLERR | EPOLLHUP))) {
+			conn_close(g, conn, false);
+			return;
+		}
+		if (ctx->conn_queries > 0 && conn->recv >= ctx->conn_queries) {
+			conn_close(g, conn, true);
+		} else if (g->sending && !conn_query(g, conn)) {
+			conn_close(g, conn, false);
+		}
+		return;
+	default:
+		return;
+	}
+}
+
+static int gun_init(gun_t *g, stream_ctx_t *ctx)
+{
+	memset(g, 0, sizeof(*g));
+	g->ctx = ctx;
+	g->epfd = -1;
+
+	size_t max_len = 0;
+	for (const struct pkt_payload *p = global_payloads; p != NULL; p = p->next) {
+		max_len = MAX(max_len, p->len);
+	}
+
+	g->epfd = epoll_create1(0);
+	g->stats = calloc(1, sizeof(*g->stats));
+	g->conns = calloc(ctx->connections, sizeof(*g->conns));
+	if (g->epfd < 0 || g->stats == NULL || g->conns == NULL) {
+		return KNOT_ENOMEM;
+	}
+	for (unsigned i = 0; i < ctx->connections; i++) {
+		g->conns[i].fd = -1;
+	}
+
+	for (unsigned i = 0; i < ctx->connections; i++) {
+		conn_t *conn = &g->conns[i];
+		conn->inflight_payl = calloc(ctx->pipeline, sizeof(*conn->inflight_payl));
+		conn->inflight_ts = calloc(ctx->pipeline, sizeof(*conn->inflight_ts));
+		conn->wbuf = malloc(ctx->pipeline * (2 + max_len));
+		if (conn->inflight_payl == NULL || conn->inflight_ts == NULL ||
+		    conn->wbuf == NULL || !conn_rbuf_reserve(conn, RBUF_INIT)) {
+			return KNOT_ENOMEM;
+		}
+	}
+
+	// Spread the threads over the queries.
+	g->payl = global_payloads;
+	for (unsigned i = 0; i < ctx->thread_id; i++) {
+		g->payl = (g->payl->next != NULL) ? g->payl->next : global_payloads;
+	}
+
+	return KNOT_EOK;
+}
+
+static void gun_deinit(gun_t *g)
+{
+	if (g->conns != NULL) {
+		for (unsigned i = 0; i < g->ctx->connections; i++) {
+			conn_t *conn = &g->conns[i];
+			conn_close(g, conn, false);
+			free(conn->inflight_payl);
+			free(conn->inflight_ts);
+			free(conn->wbuf);
+			free(conn->rbuf);
+		}
+		free(g->conns);
+	}
+	free(g->stats);
+	if (g->epfd >= 0) {
+		close(g->epfd);
+	}
+}
+
+void *stream_gun_thread(void *_ctx)
+{
+	stream_ctx_t *ctx = _ctx;
+	struct epoll_event events[EPOLL_EVENTS];
+	gun_t g;
+
+	if (gun_init(&g, ctx) != KNOT_EOK) {
+		printf("failed to initialize thread#%u\n", ctx->thread_id);
+		gun_deinit(&g);
+		return NULL;
+	}
+
+	uint64_t start = timer_usec(), elapsed = 0, opened = 0, stats_sec = 0;
+
+	while (elapsed < ctx->duration + RECV_TAIL) {
+		g.now = timer_usec();
+		elapsed = g.now - start;
+		g.sending = (elapsed < ctx->duration);
+
+		if (g.sending) {
+			// Connection churn limit, the initial connections are free.
+			uint64_t open_max = UINT64_MAX;
+			if (ctx->churn > 0) {
+				open_max = ctx->connections + (uint64_t)(elapsed * ctx->churn / 1000000);
+			}
+			uint64_t sent_exp = elapsed * ctx->qps / 1000000;
+			g.budget = (sent_exp > ctx->sent) ? sent_exp - ctx->sent : 0;
+
+			for (unsigned i = 0; i < ctx->connections; i++) {
+				conn_t *conn = &g.conns[i];
+				if (conn->state == CONN_CLOSED && opened < open_max) {
+					opened++;
+					if (conn_open(&g, conn) == KNOT_EOK) {
+						ctx->conns++;
+					} else {
+						ctx->conn_errors++;
+					}
+				} else if (conn->state == CONN_ACTIVE && ctx->udp &&
+				           conn->sent > conn->recv &&
+				           g.now - conn->last > UDP_TIMEOUT) {
+					conn_close(&g, conn, false); // Lost replies.
+				} else if (conn->state == CONN_ACTIVE && g.budget > 0 &&
+				           !conn_query(&g, conn)) {
+					conn_close(&g, conn, false);
+				}
+			}
+		} else if (ctx->sent == ctx->recv) {
+			break; // Nothing more to wait for.
+		}
+
+		int nevents = epoll_wait(g.epfd, events, EPOLL_EVENTS, 1);
+		if (nevents < 0 && errno != EINTR) {
+			ctx->errors++;
+			break;
+		}
+		g.now = timer_usec();
+		for (int i = 0; i < nevents; i++) {
+			conn_event(&g, events[i].data.ptr, events[i].events);
+		}
+
+		if (elapsed / 1000000 != stats_sec) {
+			lat_series_flush(ctx->series, g.stats, stats_sec);
+			stats_sec = elapsed / 1000000;
+		}
+	}
+
+	lat_series_flush(ctx->series, g.stats, stats_sec);
+	gun_deinit(&g);
+
+	printf("thread#%02u: sent %lu, received %lu, connections %lu, "
+	       "connection errors %lu\n", ctx->thread_id, ctx->sent, ctx->recv,
+	       ctx->conns, ctx->conn_errors);
+
+	return NULL;
+}
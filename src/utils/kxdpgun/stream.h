@@ -0,0 +1,69 @@
+/*  Copyright (C) 2021 CZ.NIC, z.s.p.o. <knot-dns@labs.nic.cz>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*!
+ * \brief DNS over UDP, TCP, and TLS traffic generation using kernel sockets.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/socket.h>
+
+#include "utils/kxdpgun/stats.h"
+
+#define STREAM_RCODES	16
+
+typedef struct {
+	// Configuration.
+	struct sockaddr_storage	target;
+	struct sockaddr_storage	local;        // AF_UNSPEC if not specified.
+	bool			udp;
+	bool			tls;
+	uint64_t		qps, duration;  // Per thread, duration in usecs.
+	unsigned		connections;  // Concurrent connections (UDP sockets) per thread.
+	unsigned		conn_queries; // Queries per connection, 0 is unlimited.
+	unsigned		pipeline;     // Outstanding queries per connection.
+	double			churn;        // New connections per second per thread, 0 is unlimited.
+	unsigned		thread_id;
+	lat_series_t		*series;      // Query latency per-second statistics.
+
+	// Results.
+	uint64_t		sent, recv, size_recv, errors;
+	uint64_t		conns, conn_errors;
+	uint64_t		rcode_counts[STREAM_RCODES];
+	lat_hist_t		*handshake;   // Connection establishment latency.
+} stream_ctx_t;
+
+/*!
+ * \brief Initializes the shared TLS client credentials.
+ *
+ * \note The server certificate is not verified.
+ *
+ * \return KNOT_E*
+ */
+int stream_init(bool tls);
+
+/*!
+ * \brief Deinitializes the shared TLS client credentials.
+ */
+void stream_deinit(void);
+
+/*!
+ * \brief Generates the traffic according to the context (thread routine).
+ */
+void *stream_gun_thread(void *ctx);
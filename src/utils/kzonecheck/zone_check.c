@@ -63,7 +63,8 @@ static void print_statistics(err_handler_stats_t *stats)
 }
 
 int zone_check(const char *zone_file, const knot_dname_t *zone_name,
-               FILE *outfile, semcheck_optional_t optional, time_t time)
+               FILE *outfile, semcheck_optional_t optional, time_t time,
+               size_t threads)
 {
 	err_handler_stats_t stats = {
 		.handler = { .cb = err_callback },
@@ -76,6 +77,7 @@ int zone_check(const char *zone_file, const knot_dname_t *zone_name,
 		return ret;
 	}
 	zl.err_handler = (sem_handler_t *)&stats;
+	zl.threads = threads;
 	zl.creator->master = true;
 
 	zone_contents_t *contents = zonefile_load(&zl);
@@ -188,7 +188,8 @@ int main(int argc, char *argv[])
 
 	if (global_outdir == NULL) {
 		char *zonefile = conf_zonefile(conf(), zone_name);
-		ret = zonefile_write(zonefile, up.new_cont);
+		conf_val_t val = conf_zone_get(conf(), C_ADJUST_THR, zone_name);
+		ret = zonefile_write(zonefile, up.new_cont, conf_int(&val));
 		free(zonefile);
 	} else {
 		zone_contents_t *temp = zone_struct->contents;
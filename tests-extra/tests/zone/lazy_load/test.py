@@ -0,0 +1,38 @@
+#!/usr/bin/env python3
+
+'''Test for lazy zone loading, including a retry after a failed load.'''
+
+import os
+import time
+
+from dnstest.test import Test
+
+t = Test()
+
+master = t.server("knot")
+master.lazy_load = True
+
+zone = t.zone("example.com.")
+
+t.link(zone, master)
+
+t.start()
+
+# The zone file is missing, the first query plans a load which fails.
+zfile = master.zones[zone[0].name].zfile.path
+os.rename(zfile, zfile + ".bak")
+
+resp = master.dig("example.com.", "SOA", udp=True)
+resp.check(rcode="SERVFAIL")
+time.sleep(2)
+resp = master.dig("example.com.", "SOA", udp=True)
+resp.check(rcode="SERVFAIL")
+
+# With the zone file back, the next query must plan the load again.
+os.rename(zfile + ".bak", zfile)
+
+master.zone_wait(zone)
+
+master.stop()
+
+t.end()
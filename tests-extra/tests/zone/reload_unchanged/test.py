@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+
+'''Test for skipping the parse of an unchanged zone file on reload.'''
+
+import os
+import shutil
+
+from dnstest.test import Test
+from dnstest.utils import set_err, detail_log
+
+t = Test()
+
+master = t.server("knot")
+master.zonefile_load = "difference"
+master.zonefile_sync = "-1"
+
+zones = t.zone("example.") + t.zone("example.com.")
+plain = zones[0]
+incl = zones[1]
+
+t.link(zones, master)
+
+t.start()
+
+serials = master.zones_wait(zones)
+
+def check_count(zone, msg, exp):
+    count = master.log_search_count("[%s] zone file %s" % (zone.name, msg))
+    if count != exp:
+        detail_log("Zone '%s' file %s %d times, expected %d" %
+                   (zone.name, msg, count, exp))
+        set_err("ZONE FILE SKIP")
+
+def reload_zone(zone):
+    master.ctl("zone-reload " + zone.name, wait=True)
+    t.sleep(1)
+
+# Unchanged zone file is skipped.
+reload_zone(plain)
+check_count(plain, "parsed", 1)
+check_count(plain, "unchanged", 1)
+
+# Changed zone file is parsed again.
+master.zones[plain.name].zfile.update_soa()
+reload_zone(plain)
+master.zone_wait(plain, serials[plain.name])
+check_count(plain, "parsed", 2)
+check_count(plain, "unchanged", 1)
+
+reload_zone(plain)
+check_count(plain, "parsed", 2)
+check_count(plain, "unchanged", 2)
+
+# Zone file with $INCLUDE is never skipped.
+zfile = master.zones[incl.name].zfile.path
+shutil.move(zfile, zfile + ".inc")
+with open(zfile, "w") as f:
+    f.write("$INCLUDE %s\n" % os.path.abspath(zfile + ".inc"))
+
+reload_zone(incl)
+reload_zone(incl)
+check_count(incl, "parsed", 3)
+check_count(incl, "unchanged", 0)
+
+t.end()
@@ -152,6 +152,7 @@ class Server(object):
         self.semantic_check = True
         self.zonefile_sync = "1d"
         self.zonefile_load = None
+        self.lazy_load = None
         self.journal_db_size = 20 * 1024 * 1024
         self.journal_max_usage = 5 * 1024 * 1024
         self.timer_db_size = 1 * 1024 * 1024
@@ -1472,6 +1473,9 @@ class Knot(Server):
             elif z.ixfr:
                 s.item_str("zonefile-load", "difference")
 
+            if self.lazy_load:
+                s.item_str("lazy-load", "on")
+
             if z.dnssec.enable:
                 s.item_str("dnssec-signing", "on")
                 s.item_str("dnssec-policy", z.dnssec.shared_policy_with or z.name)
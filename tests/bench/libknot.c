@@ -0,0 +1,606 @@
+/*  Copyright (C) 2021 CZ.NIC, z.s.p.o. <knot-dns@labs.nic.cz>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measures the libknot wire processing paths on a small corpus of typical
+ * packets: an EDNS query with cookie and client subnet options, a compressed
+ * CNAME response with delegation and glue, and a DNSKEY response with
+ * signatures.
+ *
+ * Usage: libknot [iterations [benchmark-name-prefix]]
+ *
+ * The allocations are counted by interposing the libc allocator, so only
+ * if built against glibc and without a sanitizer, which interposes the
+ * allocator on its own.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libknot/libknot.h"
+#include "contrib/strtonum.h"
+#include "contrib/time.h"
+
+#define DEFAULT_ITERATIONS	100000
+#define MAX_DIGEST_SIZE		64
+
+#ifndef __has_feature
+  #define __has_feature(feature) 0
+#endif
+
+#if defined(__GLIBC__) && \
+    !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__) && \
+    !__has_feature(address_sanitizer) && !__has_feature(thread_sanitizer) && \
+    !__has_feature(memory_sanitizer)
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static size_t allocs;
+
+void *malloc(size_t size)
+{
+	allocs++;
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+	allocs++;
+	return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+	allocs++;
+	return __libc_realloc(ptr, size);
+}
+#define COUNT_ALLOCS	true
+#else
+static size_t allocs;
+#define COUNT_ALLOCS	false
+#endif
+
+static const char *TSIG_KEY = "hmac-sha256:key.example.com.:c2VjcmV0c2VjcmV0c2VjcmV0c2VjcmV0";
+
+static const uint8_t ECS_DATA[] = { 0x00, 0x01, 0x18, 0x00, 0xC0, 0x00, 0x02 };
+
+static const uint8_t COOKIE_DATA[] = {
+	0x24, 0x64, 0xC4, 0xAB, 0xCF, 0x10, 0xC9, 0x57, // Client cookie.
+	0x01, 0x00, 0x00, 0x00, 0x5C, 0xF7, 0x9F, 0x11, // Server cookie.
+	0x1F, 0x81, 0x30, 0xC3, 0xEE, 0xE2, 0x98, 0x95
+};
+
+#define GLUE_COUNT	4
+
+static struct {
+	knot_dname_t *qname;
+	knot_dname_t *cname;
+	knot_dname_t *zone;
+	knot_dname_t *ns[GLUE_COUNT];
+
+	knot_rrset_t *cname_rr;
+	knot_rrset_t *a_rr;
+	knot_rrset_t *ns_rr;
+	knot_rrset_t *glue[2 * GLUE_COUNT];
+	knot_rrset_t *dnskey_rr;
+	knot_rrset_t *rrsig_rr;
+	knot_rrset_t opt_rr;
+
+	knot_pkt_t *query_wire;
+	knot_pkt_t *response_wire;
+	knot_pkt_t *dnssec_wire;
+	knot_pkt_t *query;
+	knot_pkt_t *response;
+	knot_pkt_t *dnssec;
+	knot_pkt_t *out;
+
+	knot_tsig_key_t key;
+	uint8_t signed_wire[KNOT_WIRE_MAX_PKTSIZE];
+	knot_pkt_t *signed_query;
+
+	uint8_t wire[KNOT_WIRE_MAX_PKTSIZE];
+	char *txt;
+	size_t txt_size;
+} c;
+
+static knot_rrset_t *rrset_create(const knot_dname_t *owner, uint16_t type,
+                                  unsigned count, const uint8_t *rdata,
+                                  uint16_t rdlen, uint8_t rdata_step)
+{
+	knot_rrset_t *rr = knot_rrset_new(owner, type, KNOT_CLASS_IN, 3600, NULL);
+	if (rr == NULL) {
+		return NULL;
+	}
+
+	uint8_t buf[KNOT_WIRE_MAX_PKTSIZE];
+	memcpy(buf, rdata, rdlen);
+	for (unsigned i = 0; i < count; i++) {
+		buf[rdlen - 1] += rdata_step;
+		if (knot_rrset_add_rdata(rr, buf, rdlen, NULL) != KNOT_EOK) {
+			knot_rrset_free(rr, NULL);
+			return NULL;
+		}
+	}
+
+	return rr;
+}
+
+static int create_rrsets(void)
+{
+	c.qname = knot_dname_from_str_alloc("www.example.com.");
+	c.cname = knot_dname_from_str_alloc("web.cdn.example.com.");
+	c.zone = knot_dname_from_str_alloc("example.com.");
+	if (c.qname == NULL || c.cname == NULL || c.zone == NULL) {
+		return KNOT_ENOMEM;
+	}
+
+	c.cname_rr = rrset_create(c.qname, KNOT_RRTYPE_CNAME, 1, c.cname,
+	                          knot_dname_size(c.cname), 0);
+
+	const uint8_t a[] = { 192, 0, 2, 0 };
+	c.a_rr = rrset_create(c.cname, KNOT_RRTYPE_A, 8, a, sizeof(a), 1);
+
+	c.ns_rr = knot_rrset_new(c.zone, KNOT_RRTYPE_NS, KNOT_CLASS_IN, 86400, NULL);
+	if (c.cname_rr == NULL || c.a_rr == NULL || c.ns_rr == NULL) {
+		return KNOT_ENOMEM;
+	}
+
+	const uint8_t aaaa[] = { 0x20, 0x01, 0x0D, 0xB8, [15] = 0x00 };
+	for (unsigned i = 0; i < GLUE_COUNT; i++) {
+		char name[32];
+		(void)snprintf(name, sizeof(name), "ns%u.example.com.", i + 1);
+		c.ns[i] = knot_dname_from_str_alloc(name);
+		if (c.ns[i] == NULL ||
+		    knot_rrset_add_rdata(c.ns_rr, c.ns[i], knot_dname_size(c.ns[i]),
+		                         NULL) != KNOT_EOK) {
+			return KNOT_ENOMEM;
+		}
+		c.glue[2 * i] = rrset_create(c.ns[i], KNOT_RRTYPE_A, 1, a, sizeof(a), 10 + i);
+		c.glue[2 * i + 1] = rrset_create(c.ns[i], KNOT_RRTYPE_AAAA, 1, aaaa,
+		                                 sizeof(aaaa), 10 + i);
+		if (c.glue[2 * i] == NULL || c.glue[2 * i + 1] == NULL) {
+			return KNOT_ENOMEM;
+		}
+	}
+
+	// Flags, protocol, algorithm, 2048-bit key.
+	uint8_t dnskey[4 + 256] = { 0x01, 0x00, 3, KNOT_DNSSEC_ALG_RSASHA256 };
+	for (unsigned i = 4; i < sizeof(dnskey); i++) {
+		dnskey[i] = i * 37;
+	}
+	c.dnskey_rr = rrset_create(c.zone, KNOT_RRTYPE_DNSKEY, 4, dnskey, sizeof(dnskey), 1);
+
+	// Type covered, algorithm, labels, TTL, expiration, inception, key tag,
+	// signer, signature.
+	uint8_t rrsig[18 + 13 + 256] = {
+		0x00, KNOT_RRTYPE_DNSKEY, KNOT_DNSSEC_ALG_RSASHA256, 2,
+		0x00, 0x00, 0x0E, 0x10, 0x61, 0x00, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00,
+		0x4F, 0x66
+	};
+	memcpy(rrsig + 18, c.zone, knot_dname_size(c.zone));
+	for (unsigned i = 18 + 13; i < sizeof(rrsig); i++) {
+		rrsig[i] = i * 101;
+	}
+	c.rrsig_rr = rrset_create(c.zone, KNOT_RRTYPE_RRSIG, 2, rrsig, sizeof(rrsig), 1);
+	if (c.dnskey_rr == NULL || c.rrsig_rr == NULL) {
+		return KNOT_ENOMEM;
+	}
+
+	int ret = knot_edns_init(&c.opt_rr, 1232, 0, 0, NULL);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+	knot_edns_set_do(&c.opt_rr);
+	ret = knot_edns_add_option(&c.opt_rr, KNOT_EDNS_OPTION_COOKIE,
+	                           sizeof(COOKIE_DATA), COOKIE_DATA, NULL);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+	return knot_edns_add_option(&c.opt_rr, KNOT_EDNS_OPTION_CLIENT_SUBNET,
+	                            sizeof(ECS_DATA), ECS_DATA, NULL);
+}
+
+static int write_query(knot_pkt_t *pkt)
+{
+	knot_pkt_clear(pkt);
+	knot_wire_set_id(pkt->wire, 0x1234);
+	knot_wire_set_rd(pkt->wire);
+
+	int ret = knot_pkt_put_question(pkt, c.qname, KNOT_CLASS_IN, KNOT_RRTYPE_A);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+	ret = knot_pkt_begin(pkt, KNOT_ADDITIONAL);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+	return knot_pkt_put(pkt, KNOT_COMPR_HINT_NONE, &c.opt_rr, 0);
+}
+
+static int write_response(knot_pkt_t *pkt)
+{
+	knot_pkt_clear(pkt);
+	knot_wire_set_id(pkt->wire, 0x1234);
+	knot_wire_set_qr(pkt->wire);
+	knot_wire_set_aa(pkt->wire);
+
+	int ret = knot_pkt_put_question(pkt, c.qname, KNOT_CLASS_IN, KNOT_RRTYPE_A);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
+	ret = knot_pkt_begin(pkt, KNOT_ANSWER);
+	if (ret == KNOT_EOK) {
+		ret = knot_pkt_put(pkt, KNOT_COMPR_HINT_QNAME, c.cname_rr, 0);
+	}
+	if (ret == KNOT_EOK) {
+		ret = knot_pkt_put(pkt, KNOT_COMPR_HINT_NONE, c.a_rr, 0);
+	}
+	if (ret == KNOT_EOK) {
+		ret = knot_pkt_begin(pkt, KNOT_AUTHORITY);
+	}
+	if (ret == KNOT_EOK) {
+		ret = knot_pkt_put(pkt, KNOT_COMPR_HINT_NONE, c.ns_rr, 0);
+	}
+	if (ret == KNOT_EOK) {
+		ret = knot_pkt_begin(pkt, KNOT_ADDITIONAL);
+	}
+	for (unsigned i = 0; ret == KNOT_EOK && i < 2 * GLUE_COUNT; i++) {
+		ret = knot_pkt_put(pkt, KNOT_COMPR_HINT_NONE, c.glue[i], 0);
+	}
+	if (ret == KNOT_EOK) {
+		ret = knot_pkt_put(pkt, KNOT_COMPR_HINT_NONE, &c.opt_rr, 0);
+	}
+
+	return ret;
+}
+
+static int write_dnssec(knot_pkt_t *pkt)
+{
+	knot_pkt_clear(pkt);
+	knot_wire_set_id(pkt->wire, 0x1234);
+	knot_wire_set_qr(pkt->wire);
+	knot_wire_set_aa(pkt->wire);
+
+	int ret = knot_pkt_put_question(pkt, c.zone, KNOT_CLASS_IN, KNOT_RRTYPE_DNSKEY);
+	if (ret == KNOT_EOK) {
+		ret = knot_pkt_begin(pkt, KNOT_ANSWER);
+	}
+	if (ret == KNOT_EOK) {
+		ret = knot_pkt_put(pkt, KNOT_COMPR_HINT_QNAME, c.dnskey_rr, 0);
+	}
+	if (ret == KNOT_EOK) {
+		ret = knot_pkt_put(pkt, KNOT_COMPR_HINT_QNAME, c.rrsig_rr, 0);
+	}
+	if (ret == KNOT_EOK) {
+		ret = knot_pkt_begin(pkt, KNOT_ADDITIONAL);
+	}
+	if (ret == KNOT_EOK) {
+		ret = knot_pkt_put(pkt, KNOT_COMPR_HINT_NONE, &c.opt_rr, 0);
+	}
+
+	return ret;
+}
+
+static knot_pkt_t *pkt_create(int (*write)(knot_pkt_t *), knot_pkt_t **wire)
+{
+	*wire = knot_pkt_new(NULL, KNOT_WIRE_MAX_PKTSIZE, NULL);
+	if (*wire == NULL || write(*wire) != KNOT_EOK) {
+		return NULL;
+	}
+
+	knot_pkt_t *pkt = knot_pkt_new((*wire)->wire, (*wire)->size, NULL);
+	if (pkt == NULL || knot_pkt_parse(pkt, 0) != KNOT_EOK) {
+		knot_pkt_free(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+
+static int create_corpus(void)
+{
+	int ret = create_rrsets();
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
+	c.query = pkt_create(write_query, &c.query_wire);
+	c.response = pkt_create(write_response, &c.response_wire);
+	c.dnssec = pkt_create(write_dnssec, &c.dnssec_wire);
+	c.out = knot_pkt_new(NULL, KNOT_WIRE_MAX_PKTSIZE, NULL);
+	if (c.query == NULL || c.response == NULL || c.dnssec == NULL || c.out == NULL) {
+		return KNOT_ERROR;
+	}
+
+	ret = knot_tsig_key_init_str(&c.key, TSIG_KEY);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
+	size_t len = c.query->size;
+	memcpy(c.signed_wire, c.query->wire, len);
+	uint8_t digest[MAX_DIGEST_SIZE];
+	size_t digest_len = sizeof(digest);
+	ret = knot_tsig_sign(c.signed_wire, &len, sizeof(c.signed_wire), NULL, 0,
+	                     digest, &digest_len, &c.key, 0, 0);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+	c.signed_query = knot_pkt_new(c.signed_wire, len, NULL);
+	if (c.signed_query == NULL) {
+		return KNOT_ENOMEM;
+	}
+	ret = knot_pkt_parse(c.signed_query, 0);
+	if (ret != KNOT_EOK) {
+		return ret;
+	}
+
+	c.txt_size = 4096;
+	c.txt = malloc(c.txt_size);
+	return (c.txt != NULL) ? KNOT_EOK : KNOT_ENOMEM;
+}
+
+static void free_corpus(void)
+{
+	knot_pkt_free(c.query);
+	knot_pkt_free(c.response);
+	knot_pkt_free(c.dnssec);
+	knot_pkt_free(c.signed_query);
+	knot_pkt_free(c.query_wire);
+	knot_pkt_free(c.response_wire);
+	knot_pkt_free(c.dnssec_wire);
+	knot_pkt_free(c.out);
+
+	knot_rrset_free(c.cname_rr, NULL);
+	knot_rrset_free(c.a_rr, NULL);
+	knot_rrset_free(c.ns_rr, NULL);
+	for (unsigned i = 0; i < 2 * GLUE_COUNT; i++) {
+		knot_rrset_free(c.glue[i], NULL);
+	}
+	knot_rrset_free(c.dnskey_rr, NULL);
+	knot_rrset_free(c.rrsig_rr, NULL);
+	knot_rrset_clear(&c.opt_rr, NULL);
+
+	for (unsigned i = 0; i < GLUE_COUNT; i++) {
+		knot_dname_free(c.ns[i], NULL);
+	}
+	knot_dname_free(c.qname, NULL);
+	knot_dname_free(c.cname, NULL);
+	knot_dname_free(c.zone, NULL);
+
+	knot_tsig_key_deinit(&c.key);
+	free(c.txt);
+}
+
+static int bench_dname_from_str(void)
+{
+	knot_dname_t *dname = knot_dname_from_str(c.wire, "web.cdn.example.com.",
+	                                          sizeof(c.wire));
+	return (dname != NULL) ? KNOT_EOK : KNOT_EINVAL;
+}
+
+static int bench_dname_to_str(void)
+{
+	char *str = knot_dname_to_str((char *)c.wire, c.cname, sizeof(c.wire));
+	return (str != NULL) ? KNOT_EOK : KNOT_EINVAL;
+}
+
+static int bench_dname_cmp(void)
+{
+	return (knot_dname_cmp(c.qname, c.cname) != 0) ? KNOT_EOK : KNOT_EINVAL;
+}
+
+static int bench_dname_lf(void)
+{
+	uint8_t *lf = knot_dname_lf(c.cname, c.wire);
+	return (lf != NULL) ? KNOT_EOK : KNOT_EINVAL;
+}
+
+static int pkt_parse(const knot_pkt_t *src)
+{
+	knot_pkt_t *pkt = knot_pkt_new(src->wire, src->size, NULL);
+	if (pkt == NULL) {
+		return KNOT_ENOMEM;
+	}
+
+	int ret = knot_pkt_parse(pkt, 0);
+	knot_pkt_free(pkt);
+	return ret;
+}
+
+static int bench_pkt_parse_query(void)
+{
+	return pkt_parse(c.query);
+}
+
+static int bench_pkt_parse_response(void)
+{
+	return pkt_parse(c.response);
+}
+
+static int bench_pkt_parse_dnssec(void)
+{
+	return pkt_parse(c.dnssec);
+}
+
+static int bench_pkt_write_response(void)
+{
+	return write_response(c.out);
+}
+
+static int bench_pkt_write_dnssec(void)
+{
+	return write_dnssec(c.out);
+}
+
+static int bench_rrset_to_wire(void)
+{
+	int ret = knot_rrset_to_wire(c.a_rr, c.wire, sizeof(c.wire), NULL);
+	return (ret > 0) ? KNOT_EOK : ret;
+}
+
+static int bench_rrset_txt_dump(void)
+{
+	int ret = knot_rrset_txt_dump(c.dnskey_rr, &c.txt, &c.txt_size,
+	                              &KNOT_DUMP_STYLE_DEFAULT);
+	return (ret > 0) ? KNOT_EOK : ret;
+}
+
+static int bench_edns_get_options(void)
+{
+	knot_edns_options_t *options = NULL;
+	int ret = knot_edns_get_options(c.query->opt_rr, &options, NULL);
+	free(options);
+	return ret;
+}
+
+static int bench_edns_cookie_parse(void)
+{
+	uint8_t *opt = knot_edns_get_option(c.query->opt_rr, KNOT_EDNS_OPTION_COOKIE, NULL);
+	if (opt == NULL) {
+		return KNOT_ENOENT;
+	}
+
+	knot_edns_cookie_t cc, sc;
+	return knot_edns_cookie_parse(&cc, &sc, knot_edns_opt_get_data(opt),
+	                              knot_edns_opt_get_length(opt));
+}
+
+static int bench_edns_ecs_parse(void)
+{
+	uint8_t *opt = knot_edns_get_option(c.query->opt_rr,
+	                                    KNOT_EDNS_OPTION_CLIENT_SUBNET, NULL);
+	if (opt == NULL) {
+		return KNOT_ENOENT;
+	}
+
+	knot_edns_client_subnet_t ecs;
+	return knot_edns_client_subnet_parse(&ecs, knot_edns_opt_get_data(opt),
+	                                     knot_edns_opt_get_length(opt));
+}
+
+static int bench_tsig_sign(void)
+{
+	size_t len = c.query->size;
+	memcpy(c.wire, c.query->wire, len);
+
+	uint8_t digest[MAX_DIGEST_SIZE];
+	size_t digest_len = sizeof(digest);
+	return knot_tsig_sign(c.wire, &len, sizeof(c.wire), NULL, 0,
+	                      digest, &digest_len, &c.key, 0, 0);
+}
+
+static int bench_tsig_check(void)
+{
+	return knot_tsig_server_check(c.signed_query->tsig_rr, c.signed_query->wire,
+	                              c.signed_query->size, &c.key);
+}
+
+static const struct {
+	const char *name;
+	int (*run)(void);
+} benchmarks[] = {
+	{ "dname_from_str",     bench_dname_from_str },
+	{ "dname_to_str",       bench_dname_to_str },
+	{ "dname_cmp",          bench_dname_cmp },
+	{ "dname_lf",           bench_dname_lf },
+	{ "pkt_parse_query",    bench_pkt_parse_query },
+	{ "pkt_parse_response", bench_pkt_parse_response },
+	{ "pkt_parse_dnssec",   bench_pkt_parse_dnssec },
+	{ "pkt_write_response", bench_pkt_write_response },
+	{ "pkt_write_dnssec",   bench_pkt_write_dnssec },
+	{ "rrset_to_wire",      bench_rrset_to_wire },
+	{ "rrset_txt_dump",     bench_rrset_txt_dump },
+	{ "edns_get_options",   bench_edns_get_options },
+	{ "edns_cookie_parse",  bench_edns_cookie_parse },
+	{ "edns_ecs_parse",     bench_edns_ecs_parse },
+	{ "tsig_sign",          bench_tsig_sign },
+	{ "tsig_check",         bench_tsig_check },
+};
+
+static int run(int (*bench)(void), unsigned count)
+{
+	for (unsigned i = 0; i < count; i++) {
+		int ret = bench();
+		if (ret != KNOT_EOK) {
+			return ret;
+		}
+	}
+
+	return KNOT_EOK;
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t iterations = DEFAULT_ITERATIONS;
+	if (argc > 1 && (str_to_u32(argv[1], &iterations) != KNOT_EOK ||
+	                 iterations < 1)) {
+		fprintf(stderr, "invalid number of iterations '%s'\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	const char *prefix = (argc > 2) ? argv[2] : "";
+
+	int ret = create_corpus();
+	if (ret != KNOT_EOK) {
+		fprintf(stderr, "failed to create corpus (%s)\n", knot_strerror(ret));
+		free_corpus();
+		return EXIT_FAILURE;
+	}
+
+	printf("%-20s%-12s%-12s%s\n", "benchmark", "iterations", "ns/op", "allocs/op");
+
+	for (size_t i = 0; i < sizeof(benchmarks) / sizeof(*benchmarks); i++) {
+		if (strncmp(benchmarks[i].name, prefix, strlen(prefix)) != 0) {
+			continue;
+		}
+
+		// Warm up.
+		ret = run(benchmarks[i].run, iterations / 10);
+		if (ret != KNOT_EOK) {
+			fprintf(stderr, "benchmark %s failed (%s)\n",
+			        benchmarks[i].name, knot_strerror(ret));
+			break;
+		}
+
+		size_t allocs_begin = allocs;
+		struct timespec begin = time_now();
+		ret = run(benchmarks[i].run, iterations);
+		struct timespec end = time_now();
+		size_t allocs_end = allocs;
+		if (ret != KNOT_EOK) {
+			fprintf(stderr, "benchmark %s failed (%s)\n",
+			        benchmarks[i].name, knot_strerror(ret));
+			break;
+		}
+
+		double ns = time_diff_ms(&begin, &end) * 1000000 / iterations;
+		printf("%-20s%-12"PRIu32"%-12.1f", benchmarks[i].name, iterations, ns);
+		if (COUNT_ALLOCS) {
+			printf("%.2f\n", (double)(allocs_end - allocs_begin) / iterations);
+		} else {
+			printf("n/a\n");
+		}
+	}
+
+	free_corpus();
+
+	return (ret == KNOT_EOK) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,168 @@
+/*  Copyright (C) 2021 CZ.NIC, z.s.p.o. <knot-dns@labs.nic.cz>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measures the query processing overhead of the query module hooks.
+ *
+ * Each simulated module plans a no-op hook into every query processing stage
+ * of the zone plan, so the measured difference corresponds to the dispatching
+ * cost of the loaded modules.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../knot/test_server.h"
+#include "knot/nameserver/process_query.h"
+#include "knot/nameserver/query_module.h"
+#include "contrib/sockaddr.h"
+#include "contrib/time.h"
+#include "contrib/ucw/mempool.h"
+
+#define DEFAULT_QUERIES	1000000
+
+static const unsigned module_counts[] = { 0, 3, 6 };
+
+static unsigned noop_hook(unsigned state, knot_pkt_t *pkt, knotd_qdata_t *qdata,
+                          knotd_mod_t *mod)
+{
+	return state;
+}
+
+static struct query_plan *create_plan(unsigned modules)
+{
+	if (modules == 0) {
+		return NULL;
+	}
+
+	struct query_plan *plan = query_plan_create();
+	if (plan == NULL) {
+		return NULL;
+	}
+
+	for (unsigned i = 0; i < modules; i++) {
+		for (unsigned stage = KNOTD_STAGE_BEGIN; stage < KNOTD_STAGES; stage++) {
+			if (query_plan_step(plan, stage, noop_hook, NULL) != KNOT_EOK) {
+				query_plan_free(plan);
+				return NULL;
+			}
+		}
+	}
+
+	if (query_plan_compile(plan) != KNOT_EOK) {
+		query_plan_free(plan);
+		return NULL;
+	}
+
+	return plan;
+}
+
+static int run(knot_layer_t *layer, knotd_qdata_params_t *params,
+               knot_pkt_t *query, knot_pkt_t *answer, unsigned count)
+{
+	for (unsigned i = 0; i < count; i++) {
+		knot_layer_begin(layer, params);
+		knot_pkt_parse(query, 0);
+		knot_layer_consume(layer, query);
+		knot_pkt_clear(answer);
+		knot_layer_produce(layer, answer);
+		if (layer->state != KNOT_STATE_DONE) {
+			return KNOT_ERROR;
+		}
+		knot_layer_finish(layer);
+		mp_flush(layer->mm->ctx);
+	}
+
+	return KNOT_EOK;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned queries = DEFAULT_QUERIES;
+	if (argc > 1) {
+		queries = strtoul(argv[1], NULL, 10);
+	}
+
+	knot_mm_t mm;
+	mm_ctx_mempool(&mm, MM_DEFAULT_BLKSIZE);
+
+	knot_layer_t layer = { 0 };
+	knot_layer_init(&layer, &mm, process_query_layer());
+
+	server_t server;
+	int ret = create_fake_server(&server, &mm);
+	if (ret != KNOT_EOK) {
+		fprintf(stderr, "failed to initialize server (%s)\n", knot_strerror(ret));
+		return EXIT_FAILURE;
+	}
+
+	zone_t *zone = knot_zonedb_find(server.zone_db, ROOT_DNAME);
+
+	struct sockaddr_storage ss = { 0 };
+	sockaddr_set(&ss, AF_INET, "127.0.0.1", 53);
+	knotd_qdata_params_t params = {
+		.remote = &ss,
+		.server = &server
+	};
+
+	knot_pkt_t *query = knot_pkt_new(NULL, KNOT_WIRE_MAX_PKTSIZE, NULL);
+	knot_pkt_t *answer = knot_pkt_new(NULL, KNOT_WIRE_MAX_PKTSIZE, NULL);
+	knot_pkt_put_question(query, ROOT_DNAME, KNOT_CLASS_IN, KNOT_RRTYPE_SOA);
+
+	printf("%-10s%-12s%s\n", "modules", "queries", "ns/query");
+
+	for (size_t i = 0; i < sizeof(module_counts) / sizeof(*module_counts); i++) {
+		zone->query_plan = create_plan(module_counts[i]);
+		if (module_counts[i] > 0 && zone->query_plan == NULL) {
+			ret = KNOT_ENOMEM;
+			break;
+		}
+
+		// Warm up.
+		ret = run(&layer, &params, query, answer, queries / 10);
+		if (ret != KNOT_EOK) {
+			break;
+		}
+
+		struct timespec begin = time_now();
+		ret = run(&layer, &params, query, answer, queries);
+		struct timespec end = time_now();
+		if (ret != KNOT_EOK) {
+			break;
+		}
+
+		double ns = time_diff_ms(&begin, &end) * 1000000 / queries;
+		printf("%-10u%-12u%.1f\n", module_counts[i], queries, ns);
+
+		query_plan_free(zone->query_plan);
+		zone->query_plan = NULL;
+	}
+
+	if (ret != KNOT_EOK) {
+		fprintf(stderr, "benchmark failed (%s)\n", knot_strerror(ret));
+	}
+
+	query_plan_free(zone->query_plan);
+	zone->query_plan = NULL;
+	knot_pkt_free(query);
+	knot_pkt_free(answer);
+	server_deinit(&server);
+	conf_free(conf());
+	mp_delete(mm.ctx);
+
+	return (ret == KNOT_EOK) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
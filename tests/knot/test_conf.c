@@ -203,6 +203,48 @@ static void test_conf_zonefile(void)
 	knot_dname_free(zone_unknown, NULL);
 }
 
+static void test_conf_zone_cache(void)
+{
+	knot_dname_t *zone_1label = knot_dname_from_str_alloc(ZONE_1LABEL);
+	knot_dname_t *zone_unknown = knot_dname_from_str_alloc(ZONE_UNKNOWN);
+
+	const char *conf_str =
+		"template:\n"
+		"  - id: default\n"
+		"    zonefile-sync: 60\n"
+		"\n"
+		"zone:\n"
+		"  - domain: "ZONE_1LABEL"\n"
+		"    zonefile-sync: -1\n"
+		"    serial-policy: unixtime\n"
+		"    zone-max-size: 1000\n";
+
+	int ret = test_conf(conf_str, NULL);
+	is_int(KNOT_EOK, ret, "Prepare configuration");
+
+	ok(conf()->zone_cache != NULL, "Zone items materialized");
+
+	conf_zone_cache_t cache = conf_zone_cache(conf(), zone_1label);
+	ok(cache.zonefile_sync == -1 && cache.serial_policy == SERIAL_POLICY_UNIXTIME &&
+	   cache.zone_max_size == 1000 && !cache.dnssec_signing,
+	   "Zone cache items for "ZONE_1LABEL);
+
+	cache = conf_zone_cache(conf(), zone_unknown);
+	ok(cache.zonefile_sync == 60 && cache.serial_policy == SERIAL_POLICY_INCREMENT &&
+	   cache.zone_max_size == SSIZE_MAX, "Zone cache items for "ZONE_UNKNOWN);
+
+	ret = conf_refresh_txn(conf());
+	is_int(KNOT_EOK, ret, "Refresh read-only transaction");
+
+	cache = conf_zone_cache(conf(), zone_1label);
+	ok(conf()->zone_cache != NULL && cache.zonefile_sync == -1,
+	   "Zone cache items rebuilt for "ZONE_1LABEL);
+
+	test_conf_free();
+	knot_dname_free(zone_1label, NULL);
+	knot_dname_free(zone_unknown, NULL);
+}
+
 int main(int argc, char *argv[])
 {
 	plan_lazy();
@@ -213,5 +255,8 @@ int main(int argc, char *argv[])
 	diag("conf_zonefile");
 	test_conf_zonefile();
 
+	diag("conf_zone_cache");
+	test_conf_zone_cache();
+
 	return 0;
 }
@@ -921,6 +921,63 @@ static void test_conf_io_list(void)
 	ok(strcmp(ref, out) == 0, "compare result");
 }
 
+static void test_conf_io_refs(void)
+{
+	const char *conf_str =
+		"template:\n"
+		"  - id: tpl1\n"
+		"\n"
+		"policy:\n"
+		"  - id: pol1\n"
+		"\n"
+		"zone:\n"
+		"  - domain: "ZONE1"\n"
+		"    template: tpl1\n"
+		"  - domain: "ZONE2"\n"
+		"    dnssec-policy: pol1\n"
+		"  - domain: "ZONE3"\n";
+
+	ok(test_conf(conf_str, NULL) == KNOT_EOK, "Prepare configuration");
+
+	knot_dname_t *zone1 = knot_dname_from_str_alloc(ZONE1);
+	knot_dname_t *zone2 = knot_dname_from_str_alloc(ZONE2);
+	knot_dname_t *zone3 = knot_dname_from_str_alloc(ZONE3);
+
+	// Template change.
+	ok(conf_io_begin(false) == KNOT_EOK, "begin txn");
+	ok(conf_io_set("template", "semantic-checks", "tpl1", "on") ==
+	   KNOT_EOK, "set template item");
+	ok(!(conf()->io.flags & CONF_IO_FRLD_ZONES) &&
+	   (conf()->io.flags & CONF_IO_FRLD_ZONE), "check template reload flags");
+	ok(conf_io_zone_refs_changed(conf(), zone1), "check template zone");
+	ok(!conf_io_zone_refs_changed(conf(), zone2) &&
+	   !conf_io_zone_refs_changed(conf(), zone3), "check other zones");
+	conf_io_abort(false);
+	ok(!conf_io_zone_refs_changed(conf(), zone1), "check abort");
+
+	// Policy change.
+	ok(conf_io_begin(false) == KNOT_EOK, "begin txn");
+	ok(conf_io_set("policy", "nsec3", "pol1", "on") ==
+	   KNOT_EOK, "set policy item");
+	ok(!(conf()->io.flags & CONF_IO_FRLD_ZONES), "check policy reload flags");
+	ok(conf_io_zone_refs_changed(conf(), zone2), "check policy zone");
+	ok(!conf_io_zone_refs_changed(conf(), zone1) &&
+	   !conf_io_zone_refs_changed(conf(), zone3), "check other zones");
+	conf_io_abort(false);
+
+	// Change of all templates.
+	ok(conf_io_begin(false) == KNOT_EOK, "begin txn");
+	ok(conf_io_set("template", "semantic-checks", NULL, "on") ==
+	   KNOT_EOK, "set all templates item");
+	ok(conf()->io.flags & CONF_IO_FRLD_ZONES, "check all zones reload flag");
+	conf_io_abort(false);
+
+	knot_dname_free(zone1, NULL);
+	knot_dname_free(zone2, NULL);
+	knot_dname_free(zone3, NULL);
+	test_conf_free();
+}
+
 static const yp_item_t desc_server[] = {
 	{ C_VERSION,              YP_TSTR,  YP_VNONE },
 	{ C_LISTEN,               YP_TADDR, YP_VNONE, YP_FMULTI },
@@ -1025,6 +1082,9 @@ int main(int argc, char *argv[])
 	diag("conf_io_list");
 	test_conf_io_list();
 
+	diag("conf_io_zone_refs_changed");
+	test_conf_io_refs();
+
 	conf_free(conf());
 
 	return 0;
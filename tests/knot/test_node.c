@@ -17,6 +17,8 @@
 #include <assert.h>
 #include <tap/basic.h>
 
+#include "contrib/mempattern.h"
+#include "contrib/ucw/mempool.h"
 #include "knot/zone/node.h"
 #include "libknot/libknot.h"
 
@@ -122,6 +124,91 @@ int main(int argc, char *argv[])
 
 	node_free(node, NULL);
 
+	// Test compaction
+	node = node_new(dummy_owner, false, false, NULL);
+	assert(node);
+	knot_rrset_t *txt = create_dummy_rrset(dummy_owner, KNOT_RRTYPE_TXT);
+	knot_rrset_t *sig = create_dummy_rrsig(dummy_owner, KNOT_RRTYPE_TXT);
+	ret = node_add_rrset(node, txt, NULL);
+	assert(ret == KNOT_EOK);
+	ret = node_add_rrset(node, sig, NULL);
+	assert(ret == KNOT_EOK);
+
+	ret = node_compact(node, NULL, NULL);
+	ok(ret == KNOT_EOK && node->block != NULL && node->rrset_count == 2,
+	   "Node: compact.");
+	stack_rrset = node_rrset(node, KNOT_RRTYPE_TXT);
+	ok(knot_rrset_equal(&stack_rrset, txt, true) &&
+	   node_rrtype_is_signed(node, KNOT_RRTYPE_TXT), "Node: compact, data kept.");
+
+	uint8_t wire[] = { 3, 'f', 'o', 'o' };
+	ret = knot_rrset_add_rdata(txt, wire, sizeof(wire), NULL);
+	assert(ret == KNOT_EOK);
+	ret = node_add_rrset(node, txt, NULL);
+	stack_rrset = node_rrset(node, KNOT_RRTYPE_TXT);
+	ok(ret == KNOT_EOK && knot_rrset_equal(&stack_rrset, txt, true),
+	   "Node: compact, merge RRSet.");
+
+	dummy_rrset = create_dummy_rrset(dummy_owner, KNOT_RRTYPE_SPF);
+	ret = node_add_rrset(node, dummy_rrset, NULL);
+	ok(ret == KNOT_EOK && node->rrset_count == 3, "Node: compact, add RRSet.");
+
+	ret = node_remove_rrset(node, sig, NULL);
+	ok(ret == KNOT_EOK && node->rrset_count == 2 &&
+	   !node_rrtype_is_signed(node, KNOT_RRTYPE_TXT), "Node: compact, remove RRSet.");
+
+	node_free_rrsets(node, NULL);
+	node_free(node, NULL);
+	knot_rrset_free(dummy_rrset, NULL);
+
+	// Test compaction of a bi-node
+	node = node_new(dummy_owner, true, false, NULL);
+	assert(node);
+	ret = node_add_rrset(node, sig, NULL);
+	assert(ret == KNOT_EOK);
+	ret = node_compact(node, NULL, NULL);
+	zone_node_t *counter = binode_counterpart(node);
+	ok(ret == KNOT_EOK && node->block != NULL && counter->block == node->block,
+	   "Node: compact bi-node.");
+
+	binode_unify(node, false, NULL);
+	ret = binode_prepare_change(counter, NULL);
+	assert(ret == KNOT_EOK);
+	ret = node_remove_rrset(counter, sig, NULL);
+	ok(ret == KNOT_EOK && counter->rrset_count == 0 && node->rrset_count == 1 &&
+	   node_rrtype_exists(node, KNOT_RRTYPE_RRSIG), "Node: compact bi-node, change.");
+
+	binode_unify(counter, false, NULL);
+	node_free_rrsets(node, NULL);
+	node_free(node, NULL);
+
+	// Test compaction of a node from an arena
+	knot_mm_t arena;
+	mm_ctx_mempool(&arena, MM_DEFAULT_BLKSIZE);
+	node = node_new(dummy_owner, true, false, &arena);
+	assert(node);
+	counter = binode_counterpart(node);
+	node->flags |= NODE_FLAGS_ARENA;
+	counter->flags |= NODE_FLAGS_ARENA;
+	ret = node_add_rrset(node, txt, NULL);
+	assert(ret == KNOT_EOK);
+	ret = node_add_rrset(node, sig, NULL);
+	assert(ret == KNOT_EOK);
+	ret = node_compact(node, &arena, NULL);
+	ok(ret == KNOT_EOK && node->block != NULL, "Node: compact into arena.");
+
+	ret = node_remove_rrset(node, sig, NULL);
+	stack_rrset = node_rrset(node, KNOT_RRTYPE_TXT);
+	ok(ret == KNOT_EOK && node->rrset_count == 1 &&
+	   knot_rrset_equal(&stack_rrset, txt, true), "Node: arena, remove RRSet.");
+
+	binode_unify(node, false, NULL);
+	node_free_rrsets(node, NULL);
+	node_free(node, NULL);
+	mp_delete(arena.ctx);
+
+	knot_rrset_free(txt, NULL);
+	knot_rrset_free(sig, NULL);
 	knot_dname_free(dummy_owner, NULL);
 
 	return 0;
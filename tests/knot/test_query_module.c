@@ -57,12 +57,16 @@ int main(int argc, char *argv[])
 	}
 	is_int(KNOT_EOK, ret, "query_plan: planned all steps");
 
+	/* Compile the plan. */
+	ret = query_plan_compile(plan);
+	is_int(KNOT_EOK, ret, "query_plan: compile");
+
 	/* Execute the plan. */
 	int state = 0, next_state = 0;
 	for (unsigned stage = KNOTD_STAGE_BEGIN; stage < KNOTD_STAGES; ++stage) {
-		struct query_step *step = NULL;
-		WALK_LIST(step, plan->stage[stage]) {
-			next_state = step->process(state, NULL, NULL, step->ctx);
+		struct query_hook *hook = NULL;
+		QUERY_PLAN_FOREACH(plan, stage, hook) {
+			next_state = hook->process(state, NULL, NULL, hook->ctx);
 			if (next_state != state + 1) {
 				break;
 			}
@@ -79,6 +83,28 @@ int main(int argc, char *argv[])
 	}
 	ok(state == KNOTD_STAGES, "query_plan: executed all callbacks");
 
+	/* Empty stages are elided. */
+	query_plan_free(plan);
+	plan = query_plan_create();
+	ok(plan != NULL, "query_plan: create");
+	if (plan == NULL) {
+		goto fatal;
+	}
+	ret = query_plan_step(plan, KNOTD_STAGE_ANSWER, state_visit, state_map);
+	if (ret == KNOT_EOK) {
+		ret = query_plan_step(plan, KNOTD_STAGE_ANSWER, state_visit, state_map);
+	}
+	if (ret == KNOT_EOK) {
+		ret = query_plan_compile(plan);
+	}
+	is_int(KNOT_EOK, ret, "query_plan: compile partial plan");
+	ok(plan->hooks[KNOTD_STAGE_BEGIN] == NULL &&
+	   plan->hooks[KNOTD_STAGE_END] == NULL, "query_plan: empty stages elided");
+	ok(plan->hooks[KNOTD_STAGE_ANSWER] != NULL &&
+	   plan->hooks[KNOTD_STAGE_ANSWER][1].process == state_visit &&
+	   plan->hooks[KNOTD_STAGE_ANSWER][2].process == NULL,
+	   "query_plan: compiled stage hooks");
+
 fatal:
 	/* Free the query plan. */
 	query_plan_free(plan);
@@ -129,6 +129,21 @@ int main(int argc, char *argv[])
 	ret = zone_tree_sub_apply(t, (const knot_dname_t *)"\x02""ac", true, ztree_node_counter, &counter);
 	ok(ret == KNOT_EOK && counter == 1, "ztree: subtree iteration excluding root");
 
+	/* 7. iteration from a name */
+	zone_tree_it_t it = { 0 };
+	ret = zone_tree_it_from_begin(t, (const knot_dname_t *)"\x02""ac", true, &it);
+	ok(ret == KNOT_EOK && !zone_tree_it_finished(&it) &&
+	   zone_tree_it_val(&it) == NODEE + 1, "ztree: iteration after existing name");
+	zone_tree_it_free(&it);
+	ret = zone_tree_it_from_begin(t, (const knot_dname_t *)"\x06""master""\x02""ac", false, &it);
+	ok(ret == KNOT_EOK && !zone_tree_it_finished(&it) &&
+	   zone_tree_it_val(&it) == NODEE + 1, "ztree: iteration from existing name");
+	zone_tree_it_free(&it);
+	ret = zone_tree_it_from_begin(t, (const knot_dname_t *)"\x01""b", false, &it);
+	ok(ret == KNOT_EOK && !zone_tree_it_finished(&it) &&
+	   zone_tree_it_val(&it) == NODEE + 3, "ztree: iteration from missing name");
+	zone_tree_it_free(&it);
+
 	zone_tree_free(&t);
 	ztree_free_data();
 	return 0;
@@ -21,6 +21,7 @@
 #include <tap/files.h>
 
 #include "knot/zone/timers.h"
+#include "knot/zone/zonedb.h"
 #include "libknot/db/db_lmdb.h"
 #include "libknot/dname.h"
 #include "libknot/error.h"
@@ -33,6 +34,9 @@ static const zone_timers_t MOCK_TIMERS = {
 	.last_resalt = 2,
 	.next_ds_check = 1474559961,
 	.next_ds_push = 1474559962,
+	.zonefile_size = 1234,
+	.zonefile_hash = 0x0123456789abcdef,
+	.zonefile_serial = 2021010100,
 };
 
 static bool timers_eq(const zone_timers_t *a, const zone_timers_t *b)
@@ -43,7 +47,10 @@ static bool timers_eq(const zone_timers_t *a, const zone_timers_t *b)
 	       a->last_flush == b->last_flush &&
 	       a->last_resalt == b->last_resalt &&
 	       a->next_ds_check == b->next_ds_check &&
-	       a->next_ds_push == b->next_ds_push;
+	       a->next_ds_push == b->next_ds_push &&
+	       a->zonefile_size == b->zonefile_size &&
+	       a->zonefile_hash == b->zonefile_hash &&
+	       a->zonefile_serial == b->zonefile_serial;
 }
 
 static bool keep_all(const knot_dname_t *zone, void *data)
@@ -56,6 +63,54 @@ static bool remove_all(const knot_dname_t *zone, void *data)
 	return false;
 }
 
+static void test_write_changed(knot_lmdb_db_t *db)
+{
+	const knot_dname_t *name1 = (uint8_t *)"\x7""example""\x3""com";
+	const knot_dname_t *name2 = (uint8_t *)"\x7""example""\x3""net";
+	zone_timers_t timers;
+	size_t written = 0;
+
+	knot_zonedb_t *zonedb = knot_zonedb_new();
+	zone_t *zone1 = zone_new(name1);
+	zone_t *zone2 = zone_new(name2);
+	assert(zonedb && zone1 && zone2);
+	knot_zonedb_insert(zonedb, zone1);
+	knot_zonedb_insert(zonedb, zone2);
+
+	// Only the changed zone is written
+	zone1->timers = MOCK_TIMERS;
+	int ret = zone_timers_write_changed(db, zonedb, &written);
+	ok(ret == KNOT_EOK && written == 1, "zone_timers_write_changed() one zone");
+	ret = zone_timers_read(db, name1, &timers);
+	ok(ret == KNOT_EOK && timers_eq(&timers, &MOCK_TIMERS),
+	   "zone_timers_write_changed() written timers");
+	ret = zone_timers_read(db, name2, &timers);
+	is_int(KNOT_ENOENT, ret, "zone_timers_write_changed() skipped zone");
+
+	// Nothing to write without changes
+	ret = zone_timers_write_changed(db, zonedb, &written);
+	ok(ret == KNOT_EOK && written == 0, "zone_timers_write_changed() no change");
+
+	// Changes not written yet aren't visible, e.g. after a crash
+	zone1->timers.next_refresh += 10;
+	zone2->timers.last_flush = 1;
+	ret = zone_timers_read(db, name1, &timers);
+	ok(ret == KNOT_EOK && timers_eq(&timers, &MOCK_TIMERS),
+	   "zone_timers_write_changed() last written state kept");
+
+	// All changes are written at once
+	ret = zone_timers_write_changed(db, zonedb, &written);
+	ok(ret == KNOT_EOK && written == 2, "zone_timers_write_changed() two zones");
+	ret = zone_timers_read(db, name1, &timers);
+	ok(ret == KNOT_EOK && timers_eq(&timers, &zone1->timers),
+	   "zone_timers_write_changed() updated timers");
+	ret = zone_timers_read(db, name2, &timers);
+	ok(ret == KNOT_EOK && timers_eq(&timers, &zone2->timers),
+	   "zone_timers_write_changed() new timers");
+
+	knot_zonedb_deep_free(&zonedb, false);
+}
+
 int main(int argc, char *argv[])
 {
 	plan_lazy();
@@ -101,6 +156,9 @@ int main(int argc, char *argv[])
 	ret = zone_timers_read(db, zone, &timers);
 	is_int(KNOT_ENOENT, ret, "zone_timers_read() nonexistent");
 
+	// Write changed zones
+	test_write_changed(db);
+
 	// Clean up.
 	knot_lmdb_deinit(db);
 	test_rm_rf(dbid);
@@ -95,6 +95,40 @@ int main(int argc, char *argv[])
 	}
 	ok(nr_passed == ZONE_COUNT, "zonedb: find zones for subnames");
 
+	/* Iteration after a name. */
+	dname = knot_dname_from_str_alloc("b.com");
+	knot_zonedb_iter_t *it = knot_zonedb_iter_begin_after(db, dname);
+	ok(it != NULL && !knot_zonedb_iter_finished(it) &&
+	   knot_zonedb_iter_val(it) == zones[8], "zonedb: iterate after missing name");
+	knot_zonedb_iter_free(it);
+	knot_dname_free(dname, NULL);
+	dname = knot_dname_from_str_alloc("net");
+	it = knot_zonedb_iter_begin_after(db, dname);
+	ok(it != NULL && !knot_zonedb_iter_finished(it) &&
+	   knot_zonedb_iter_val(it) == zones[5], "zonedb: iterate after existing name");
+	knot_zonedb_iter_free(it);
+	knot_dname_free(dname, NULL);
+
+	/* Copy-on-write modification. */
+	knot_zonedb_t *db_new = knot_zonedb_cow(db);
+	ok(db_new != NULL, "zonedb: cow");
+	if (db_new == NULL) {
+		goto cleanup;
+	}
+	dname = knot_dname_from_str_alloc(zone_list[ZONE_COUNT - 1]);
+	ok(knot_zonedb_del(db_new, dname) == KNOT_EOK &&
+	   knot_zonedb_find(db_new, dname) == NULL &&
+	   knot_zonedb_find(db, dname) == zones[ZONE_COUNT - 1],
+	   "zonedb: cow remove keeps original");
+	ok(knot_zonedb_insert(db_new, zones[ZONE_COUNT - 1]) == KNOT_EOK &&
+	   knot_zonedb_size(db_new) == ZONE_COUNT &&
+	   knot_zonedb_size(db) == ZONE_COUNT,
+	   "zonedb: cow insert");
+	knot_dname_free(dname, NULL);
+	knot_zonedb_cow_commit(db_new, &db);
+	ok(db == NULL && db_new->cow == NULL, "zonedb: cow commit");
+	db = db_new;
+
 	/* Remove all zones. */
 	nr_passed = 0;
 	for (unsigned i = 0; i < ZONE_COUNT; ++i) {
@@ -0,0 +1,224 @@
+/*  Copyright (C) 2021 CZ.NIC, z.s.p.o. <knot-dns@labs.nic.cz>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <tap/basic.h>
+#include <tap/files.h>
+#include <unistd.h>
+#include <urcu.h>
+
+#include "test_conf.h"
+#include "knot/server/server.h"
+#include "knot/zone/zonedb.h"
+#include "knot/zone/zonedb-load.h"
+
+#define CATALOG	"catalog."
+#define STATIC	"static."
+#define MEMBER1	"member1."
+#define MEMBER2	"member2."
+
+typedef struct {
+	server_t *server;
+	pthread_mutex_t mx;
+	pthread_cond_t cond;
+	bool ready;
+	// Results of the checks done with the old database under RCU.
+	bool switched;
+	bool old_intact;
+} reader_t;
+
+static knot_dname_t *dname(const char *str)
+{
+	static knot_dname_storage_t buf;
+	return knot_dname_from_str(buf, str, sizeof(buf));
+}
+
+static bool db_has(knot_zonedb_t *db, const char *name)
+{
+	zone_t *zone = knot_zonedb_find(db, dname(name));
+	return zone != NULL && knot_dname_is_equal(zone->name, dname(name));
+}
+
+static void *reader_main(void *arg)
+{
+	reader_t *r = arg;
+
+	rcu_register_thread();
+	rcu_read_lock();
+
+	knot_zonedb_t *db = rcu_dereference(r->server->zone_db);
+	bool had_member1 = db_has(db, MEMBER1);
+	bool had_member2 = db_has(db, MEMBER2);
+	size_t size = knot_zonedb_size(db);
+
+	pthread_mutex_lock(&r->mx);
+	r->ready = true;
+	pthread_cond_signal(&r->cond);
+	pthread_mutex_unlock(&r->mx);
+
+	// Wait for the new database to be published, the update then waits for us.
+	for (int i = 0; i < 1000 && !r->switched; i++) {
+		r->switched = (rcu_dereference(r->server->zone_db) != db);
+		usleep(10000);
+	}
+
+	r->old_intact = (knot_zonedb_size(db) == size &&
+	                 db_has(db, CATALOG) && db_has(db, STATIC) &&
+	                 db_has(db, MEMBER1) == had_member1 &&
+	                 db_has(db, MEMBER2) == had_member2);
+
+	rcu_read_unlock();
+	rcu_unregister_thread();
+
+	return NULL;
+}
+
+static void update_catalog(server_t *server, const char *msg)
+{
+	reader_t r = { .server = server };
+	pthread_mutex_init(&r.mx, NULL);
+	pthread_cond_init(&r.cond, NULL);
+
+	pthread_t thr;
+	pthread_create(&thr, NULL, reader_main, &r);
+
+	pthread_mutex_lock(&r.mx);
+	while (!r.ready) {
+		pthread_cond_wait(&r.cond, &r.mx);
+	}
+	pthread_mutex_unlock(&r.mx);
+
+	int ret = zonedb_update_catalog(conf(), server);
+	is_int(KNOT_EOK, ret, "%s: update", msg);
+
+	pthread_join(thr, NULL);
+	ok(r.switched, "%s: new database published", msg);
+	ok(r.old_intact, "%s: old database unaffected for readers", msg);
+
+	pthread_cond_destroy(&r.cond);
+	pthread_mutex_destroy(&r.mx);
+}
+
+static int add_zone(server_t *server, knot_zonedb_t *db, const char *name)
+{
+	zone_t *zone = zone_new(dname(name));
+	if (zone == NULL) {
+		return KNOT_ENOMEM;
+	}
+	zone->journaldb = &server->journaldb;
+	zone->kaspdb = &server->kaspdb;
+	zone->catalog = &server->catalog;
+	zone->catalog_upd = &server->catalog_upd;
+
+	int ret = zone_events_setup(zone, server->workers, &server->sched);
+	if (ret == KNOT_EOK) {
+		ret = knot_zonedb_insert(db, zone);
+	}
+	if (ret != KNOT_EOK) {
+		zone_free(&zone);
+	}
+	return ret;
+}
+
+static int add_member(server_t *server, const char *member, bool remove)
+{
+	knot_dname_storage_t catzone, owner;
+	knot_dname_from_str(catzone, CATALOG, sizeof(catzone));
+	char owner_str[KNOT_DNAME_TXT_MAXLEN];
+	(void)snprintf(owner_str, sizeof(owner_str), "%szones." CATALOG, member);
+	knot_dname_from_str(owner, owner_str, sizeof(owner));
+
+	return catalog_update_add(&server->catalog_upd, dname(member), owner,
+	                          catzone, remove);
+}
+
+int main(int argc, char *argv[])
+{
+	plan_lazy();
+
+	rcu_register_thread();
+
+	char *temp_dir = test_mkdtemp();
+	ok(temp_dir != NULL, "make temporary directory");
+
+	char conf_str[512];
+	snprintf(conf_str, sizeof(conf_str),
+	         "template:\n"
+	         " - id: default\n"
+	         "   storage: %s\n"
+	         " - id: member\n"
+	         "   storage: %s\n"
+	         "zone:\n"
+	         " - domain: " CATALOG "\n"
+	         "   catalog-role: interpret\n"
+	         "   catalog-template: member\n"
+	         " - domain: " STATIC "\n",
+	         temp_dir, temp_dir);
+
+	int ret = test_conf(conf_str, NULL);
+	is_int(KNOT_EOK, ret, "load configuration");
+
+	server_t server;
+	ret = server_init(&server, 1);
+	is_int(KNOT_EOK, ret, "server init");
+
+	knot_zonedb_t *db = knot_zonedb_new();
+	ok(db != NULL, "zonedb: new");
+	ret = add_zone(&server, db, CATALOG);
+	if (ret == KNOT_EOK) {
+		ret = add_zone(&server, db, STATIC);
+	}
+	is_int(KNOT_EOK, ret, "zonedb: configured zones");
+	server.zone_db = db;
+
+	// Add two member zones.
+	ret = add_member(&server, MEMBER1, false);
+	if (ret == KNOT_EOK) {
+		ret = add_member(&server, MEMBER2, false);
+	}
+	is_int(KNOT_EOK, ret, "catalog: add members");
+	update_catalog(&server, "add");
+
+	db = server.zone_db;
+	ok(knot_zonedb_size(db) == 4 && db_has(db, MEMBER1) && db_has(db, MEMBER2),
+	   "add: members in new database");
+	zone_t *member2 = knot_zonedb_find(db, dname(MEMBER2));
+	ok(member2 != NULL && zone_get_flag(member2, ZONE_IS_CAT_MEMBER, false),
+	   "add: zone flagged as a member");
+
+	// Remove one member zone, keep the other one.
+	ret = add_member(&server, MEMBER1, true);
+	is_int(KNOT_EOK, ret, "catalog: remove member");
+	update_catalog(&server, "remove");
+
+	db = server.zone_db;
+	ok(knot_zonedb_size(db) == 3 && !db_has(db, MEMBER1) && db_has(db, MEMBER2),
+	   "remove: member removed from new database");
+	ok(knot_zonedb_find(db, dname(MEMBER2)) == member2,
+	   "remove: unchanged member shared with old database");
+	ok(db_has(db, CATALOG) && db_has(db, STATIC),
+	   "remove: configured zones kept");
+
+	server_deinit(&server);
+	conf_free(conf());
+	test_rm_rf(temp_dir);
+	free(temp_dir);
+
+	rcu_unregister_thread();
+
+	return 0;
+}
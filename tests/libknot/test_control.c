@@ -32,6 +32,8 @@
 		exit(-1); \
 	}
 
+static const uint8_t bulk_data[] = { 0x00, 0x01, 0x02, 0x00, 0xff };
+
 static void ctl_client(const char *socket, size_t argc, knot_ctl_data_t *argv)
 {
 	knot_ctl_t *ctl = knot_ctl_alloc();
@@ -68,13 +70,22 @@ static void ctl_client(const char *socket, size_t argc, knot_ctl_data_t *argv)
 	diag("END: Client -> Server");
 	diag("BEGIN: Client <- Server");
 
-	size_t count = 0;
+	size_t count = 0, bulk_count = 0;
 	knot_ctl_data_t data;
 	knot_ctl_type_t type = KNOT_CTL_TYPE_DATA;
 	while ((ret = knot_ctl_receive(ctl, &type, &data)) == KNOT_EOK) {
 		if (type == KNOT_CTL_TYPE_END) {
 			break;
 		}
+		if (type == KNOT_CTL_TYPE_BULK) {
+			size_t len = 0;
+			const uint8_t *bulk = knot_ctl_bulk(ctl, &len);
+			fake_ok(bulk != NULL && len == sizeof(bulk_data) &&
+			        memcmp(bulk, bulk_data, len) == 0,
+			        "Client compare bulk data");
+			bulk_count++;
+			continue;
+		}
 		if (argv[count][KNOT_CTL_IDX_CMD] != NULL &&
 		    argv[count][KNOT_CTL_IDX_CMD][0] == '\0') {
 			fake_ok(type == KNOT_CTL_TYPE_BLOCK, "Receive block end type");
@@ -97,6 +108,7 @@ static void ctl_client(const char *socket, size_t argc, knot_ctl_data_t *argv)
 	fake_ok(ret == KNOT_EOK, "Receive OK check");
 	fake_ok(type == KNOT_CTL_TYPE_END, "Receive EOF type");
 	fake_ok(count == argc, "Client compare input count '%zu'", argc);
+	fake_ok(bulk_count == 1, "Client compare bulk count");
 
 	diag("END: Client <- Server");
 
@@ -163,6 +175,15 @@ static void ctl_server(const char *socket, size_t argc, knot_ctl_data_t *argv)
 		}
 	}
 
+	ret = knot_ctl_send(ctl, KNOT_CTL_TYPE_BULK, NULL);
+	is_int(KNOT_EINVAL, ret, "Server send bulk type without data");
+
+	ret = knot_ctl_send_bulk(ctl, bulk_data, KNOT_CTL_BULK_MAX + 1);
+	is_int(KNOT_EINVAL, ret, "Server send too long bulk data");
+
+	ret = knot_ctl_send_bulk(ctl, bulk_data, sizeof(bulk_data));
+	is_int(KNOT_EOK, ret, "Server send bulk data");
+
 	ret = knot_ctl_send(ctl, KNOT_CTL_TYPE_END, NULL);
 	is_int(KNOT_EOK, ret, "Server send final data");
 
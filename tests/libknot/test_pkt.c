@@ -14,6 +14,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <stdio.h>
 #include <tap/basic.h>
 
 #include "libknot/libknot.h"
@@ -64,6 +65,113 @@ static void packet_match(knot_pkt_t *in, knot_pkt_t *out)
 	is_int(NAMECOUNT, rr_matched, "pkt: RR content match");
 }
 
+/*! \brief Fills owner 'dN.example.com' and rdata 'ns.dM.example.com' (M < N). */
+static void delegation(unsigned i, uint8_t *owner, uint8_t *rdata)
+{
+	char name[KNOT_DNAME_TXT_MAXLEN];
+	(void)snprintf(name, sizeof(name), "d%u.example.com", i);
+	(void)knot_dname_from_str(owner, name, KNOT_DNAME_MAXLEN);
+	(void)snprintf(name, sizeof(name), "ns.d%u.example.com", i / 2);
+	(void)knot_dname_from_str(rdata, name, KNOT_DNAME_MAXLEN);
+}
+
+/*! \brief Writes NS RRSets of delegations, returns number of RRSets written. */
+static unsigned put_delegations(knot_pkt_t *pkt, unsigned from, unsigned to)
+{
+	uint8_t owner[KNOT_DNAME_MAXLEN];
+	uint8_t rdata[KNOT_DNAME_MAXLEN];
+
+	unsigned written = 0;
+	for (unsigned i = from; i < to; i++) {
+		delegation(i, owner, rdata);
+
+		knot_rrset_t rr;
+		knot_rrset_init(&rr, owner, KNOT_RRTYPE_NS, KNOT_CLASS_IN, TTL);
+		knot_rrset_add_rdata(&rr, rdata, knot_dname_size(rdata), &pkt->mm);
+		int ret = knot_pkt_put(pkt, KNOT_COMPR_HINT_NONE, &rr, 0);
+		if (ret != KNOT_EOK) {
+			break;
+		}
+		written++;
+	}
+
+	return written;
+}
+
+static knot_pkt_t *delegations_pkt(knot_mm_t *mm, bool table, unsigned count,
+                                   unsigned *written)
+{
+	knot_pkt_t *pkt = knot_pkt_new(NULL, KNOT_WIRE_MAX_PKTSIZE, mm);
+	assert(pkt);
+	knot_wire_set_qr(pkt->wire);
+	if (table) {
+		(void)knot_pkt_init_compr_table(pkt);
+	}
+
+	uint8_t qname[] = "\x07""example""\x03""com";
+	(void)knot_pkt_put_question(pkt, qname, KNOT_CLASS_IN, KNOT_RRTYPE_AXFR);
+	*written = put_delegations(pkt, 0, count);
+
+	return pkt;
+}
+
+/*! \brief Checks the packet contains given number of written delegations. */
+static bool parse_delegations(knot_pkt_t *pkt, unsigned count)
+{
+	uint8_t owner[KNOT_DNAME_MAXLEN];
+	uint8_t rdata[KNOT_DNAME_MAXLEN];
+
+	knot_pkt_t *in = knot_pkt_new(pkt->wire, pkt->size, &pkt->mm);
+	int ret = knot_pkt_parse(in, 0);
+	bool match = (ret == KNOT_EOK && in->rrset_count == count);
+	for (unsigned i = 0; match && i < count; i++) {
+		delegation(i, owner, rdata);
+		const knot_rdata_t *rd = in->rr[i].rrs.rdata;
+		match = knot_dname_is_equal(in->rr[i].owner, owner) &&
+		        knot_dname_is_equal(rd->data, rdata);
+	}
+	knot_pkt_free(in);
+
+	return match;
+}
+
+static void test_compr_table(knot_mm_t *mm)
+{
+	const unsigned count = 200;
+	unsigned written, written_table;
+
+	knot_pkt_t *plain = delegations_pkt(mm, false, count, &written);
+	knot_pkt_t *pkt = delegations_pkt(mm, true, count, &written_table);
+	is_int(count, written_table, "compr table: write RRSets");
+	ok(parse_delegations(pkt, count), "compr table: parse written RRSets");
+	ok(pkt->size < plain->size, "compr table: better compression");
+
+	/* Clear the packet and fill it up to truncation. */
+	knot_pkt_clear(pkt);
+	uint8_t qname[] = "\x07""example""\x03""com";
+	(void)knot_pkt_put_question(pkt, qname, KNOT_CLASS_IN, KNOT_RRTYPE_AXFR);
+	pkt->max_size = 512;
+	written = put_delegations(pkt, 0, count);
+	ok(written > 0 && written < count, "compr table: truncated packet");
+	ok(parse_delegations(pkt, written), "compr table: parse truncated packet");
+
+	/* Suffixes of the RRSet that didn't fit must not be referenced. */
+	pkt->max_size = pkt->size + 16; /* Owner fits, RDATA doesn't. */
+	is_int(0, put_delegations(pkt, written, count), "compr table: RDATA truncated");
+	pkt->max_size = KNOT_WIRE_MAX_PKTSIZE;
+	written += put_delegations(pkt, written, count);
+	is_int(count, written, "compr table: write after truncation");
+	ok(parse_delegations(pkt, count), "compr table: parse after truncation");
+
+	/* Write the same names again, every name is a single pointer. */
+	size_t size = pkt->size;
+	(void)put_delegations(pkt, 0, count);
+	is_int(size + count * (2 + 10 + 2), pkt->size, "compr table: owner and rdata pointers");
+
+	knot_pkt_free(plain);
+	knot_pkt_free(pkt);
+}
+
 int main(int argc, char *argv[])
 {
 	plan_lazy();
@@ -183,6 +291,11 @@ int main(int argc, char *argv[])
 	/* Compare copied packet to original. */
 	packet_match(in, copy);
 
+	/*
+	 * Compression table tests.
+	 */
+	test_compr_table(&mm);
+
 	/* Free packets. */
 	knot_pkt_free(copy);
 	knot_pkt_free(out);
@@ -0,0 +1,103 @@
+/*  Copyright (C) 2021 CZ.NIC, z.s.p.o. <knot-dns@labs.nic.cz>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <tap/basic.h>
+
+#include "libknot/descriptor.h"
+#include "libknot/rrset.h"
+#include "libknot/rrset-dump.h"
+
+static void test_data(uint16_t type, const uint8_t *data, uint16_t len,
+                      const char *expected, const char *msg)
+{
+	knot_rrset_t rrset;
+	knot_rrset_init(&rrset, (knot_dname_t *)"\x07""example", type,
+	                KNOT_CLASS_IN, 3600);
+	int ret = knot_rrset_add_rdata(&rrset, data, len, NULL);
+	ok(ret == KNOT_EOK, "%s: add rdata", msg);
+
+	char out[256];
+	ret = knot_rrset_txt_dump_data(&rrset, 0, out, sizeof(out),
+	                               &KNOT_DUMP_STYLE_DEFAULT);
+	ok(ret == (int)strlen(expected) && strcmp(out, expected) == 0,
+	   "%s: dump '%s'", msg, out);
+
+	// Exact output length leaves no room for the termination.
+	size_t exact = strlen(expected);
+	ret = knot_rrset_txt_dump_data(&rrset, 0, out, exact,
+	                               &KNOT_DUMP_STYLE_DEFAULT);
+	ok(ret < 0, "%s: too small output", msg);
+
+	ret = knot_rrset_txt_dump_data(&rrset, 0, out, exact + 1,
+	                               &KNOT_DUMP_STYLE_DEFAULT);
+	ok(ret == (int)exact && strcmp(out, expected) == 0, "%s: tight output", msg);
+
+	knot_rdataset_clear(&rrset.rrs, NULL);
+}
+
+static void test_header(void)
+{
+	knot_rrset_t rrset;
+	knot_rrset_init(&rrset, (knot_dname_t *)"\x07""example", KNOT_RRTYPE_A,
+	                KNOT_CLASS_IN, 0);
+	const uint8_t addr[] = { 192, 0, 2, 1 };
+	int ret = knot_rrset_add_rdata(&rrset, addr, sizeof(addr), NULL);
+	ok(ret == KNOT_EOK, "header: add rdata");
+
+	const char *expected = "example.            \t4294967295\tA\t";
+	char out[64];
+	ret = knot_rrset_txt_dump_header(&rrset, UINT32_MAX, out, sizeof(out),
+	                                 &KNOT_DUMP_STYLE_DEFAULT);
+	ok(ret == (int)strlen(expected) && strcmp(out, expected) == 0,
+	   "header: dump '%s'", out);
+
+	ret = knot_rrset_txt_dump_header(&rrset, UINT32_MAX, out, strlen(expected),
+	                                 &KNOT_DUMP_STYLE_DEFAULT);
+	ok(ret < 0, "header: too small output");
+
+	knot_rdataset_clear(&rrset.rrs, NULL);
+}
+
+int main(int argc, char *argv[])
+{
+	plan_lazy();
+
+	const uint8_t a_min[] = { 0, 0, 0, 0 };
+	test_data(KNOT_RRTYPE_A, a_min, sizeof(a_min), "0.0.0.0", "A zero");
+
+	const uint8_t a_max[] = { 255, 255, 255, 255 };
+	test_data(KNOT_RRTYPE_A, a_max, sizeof(a_max), "255.255.255.255", "A max");
+
+	const uint8_t a[] = { 192, 0, 2, 10 };
+	test_data(KNOT_RRTYPE_A, a, sizeof(a), "192.0.2.10", "A");
+
+	const uint8_t mx[] = { 0xff, 0xff, 0x02, 'm', 'x', 0x00 };
+	test_data(KNOT_RRTYPE_MX, mx, sizeof(mx), "65535 mx.", "MX");
+
+	const uint8_t soa[] = { 0x00, 0x00,
+	                        0xff, 0xff, 0xff, 0xff,
+	                        0x00, 0x00, 0x00, 0x00,
+	                        0x00, 0x00, 0x1c, 0x20,
+	                        0x00, 0x12, 0x75, 0x00,
+	                        0x00, 0x00, 0x0e, 0x10 };
+	test_data(KNOT_RRTYPE_SOA, soa, sizeof(soa),
+	          ". . 4294967295 0 7200 1209600 3600", "SOA");
+
+	test_header();
+
+	return 0;
+}